@@ -0,0 +1,840 @@
+#include "actuator.h"
+
+#include "string.h"
+
+#include "nrf_pwm.h"
+#include "nrf_drv_pwm.h"
+#include "nrf_egu.h"
+#include "nrf_drv_ppi.h"
+#include "app_util_platform.h"
+#include "app_timer.h"
+#include "utility.h"
+
+
+// If this flag is not set in the sequence values that are passed to
+// nrf_drv_pwm then the polarity of the PWM waveform will be inverted.
+// Inverted values are not useful to an actuator so the flag is set for
+// every value.
+#define CH_ENABLED_MASK    (0x8000UL)
+
+#define PWM_INSTANCE_COUNT (4UL)
+#define TICKS_PER_US_16MHZ (16UL)
+#define TICKS_PER_US_1MHZ  (1UL)
+
+#define CEILING(n,d)       (((n) + (d) - 1) / (d))
+
+// Taken off the window in which a commit renders the buffer that plays next:
+// one for the resolution of the RTC and one for the rendering itself.
+#define AHEAD_MARGIN_TICKS (2UL)
+
+// The RadioShack micro servo's usable range.
+#define RSMS_MIN_VALUE     (600UL)
+#define RSMS_MAX_VALUE     (2500UL)
+#define RSMS_NEUTRAL_VALUE (((RSMS_MAX_VALUE-RSMS_MIN_VALUE)/2)+RSMS_MIN_VALUE)
+
+// The PWM counter has to reach the end of the longest pulse before it wraps.
+#if (RSMS_MAX_VALUE >= SERVO_FRAME_PERIOD_US)
+    #error "SERVO_FRAME_PERIOD_US is too short for the servo's pulse range."
+#endif
+
+
+typedef struct
+{
+    nrf_pwm_clk_t base_clock;
+    uint16_t      top_value;
+    scale_t       scale;      // Pulse ticks (analog) or throttle (DShot)
+    uint16_t      init_value; // Applied until a value is set
+    uint16_t      t0h;        // DShot high time of a 0 bit in ticks
+    uint16_t      t1h;        // DShot high time of a 1 bit in ticks
+    bool          is_dshot;
+} profile_t;
+
+
+// The DShot bit periods are 6.67 us, 3.33 us and 1.67 us. A 1 bit is high
+// for 75% of the period and a 0 bit for 37.5%. DShot starts with the disarm
+// command.
+static const profile_t PROFILES[ACTUATOR_PROFILE_COUNT] = {
+    [ACTUATOR_PROFILE_RSMS_SERVO] = {
+        .base_clock = NRF_PWM_CLK_1MHz,
+        .top_value  = SERVO_FRAME_PERIOD_US,
+        .scale      = SCALE_INIT(RSMS_MIN_VALUE, RSMS_MAX_VALUE),
+        .init_value = RSMS_NEUTRAL_VALUE,
+        .is_dshot   = false
+    },
+    [ACTUATOR_PROFILE_ESC_PWM] = {
+        .base_clock = NRF_PWM_CLK_1MHz,
+        .top_value  = 20000,
+        .scale      = SCALE_INIT(1000, 2000),
+        .init_value = 1000,
+        .is_dshot   = false
+    },
+    [ACTUATOR_PROFILE_ESC_ONESHOT125] = {
+        .base_clock = NRF_PWM_CLK_16MHz,
+        .top_value  = 8000,
+        .scale      = SCALE_INIT(2000, 4000),
+        .init_value = 2000,
+        .is_dshot   = false
+    },
+    [ACTUATOR_PROFILE_ESC_MULTISHOT] = {
+        .base_clock = NRF_PWM_CLK_16MHz,
+        .top_value  = 2000,
+        .scale      = SCALE_INIT(80, 400),
+        .init_value = 80,
+        .is_dshot   = false
+    },
+    [ACTUATOR_PROFILE_ESC_DSHOT150] = {
+        .base_clock = NRF_PWM_CLK_16MHz,
+        .top_value  = 107,
+        .scale      = SCALE_INIT(ACTUATOR_DSHOT_THROTTLE_MIN,
+                                 ACTUATOR_DSHOT_THROTTLE_MAX),
+        .init_value = 0,
+        .t0h        = 40,
+        .t1h        = 80,
+        .is_dshot   = true
+    },
+    [ACTUATOR_PROFILE_ESC_DSHOT300] = {
+        .base_clock = NRF_PWM_CLK_16MHz,
+        .top_value  = 53,
+        .scale      = SCALE_INIT(ACTUATOR_DSHOT_THROTTLE_MIN,
+                                 ACTUATOR_DSHOT_THROTTLE_MAX),
+        .init_value = 0,
+        .t0h        = 20,
+        .t1h        = 40,
+        .is_dshot   = true
+    },
+    [ACTUATOR_PROFILE_ESC_DSHOT600] = {
+        .base_clock = NRF_PWM_CLK_16MHz,
+        .top_value  = 27,
+        .scale      = SCALE_INIT(ACTUATOR_DSHOT_THROTTLE_MIN,
+                                 ACTUATOR_DSHOT_THROTTLE_MAX),
+        .init_value = 0,
+        .t0h        = 10,
+        .t1h        = 20,
+        .is_dshot   = true
+    },
+    [ACTUATOR_PROFILE_BDCM] = {
+        .base_clock = NRF_PWM_CLK_1MHz,
+        .top_value  = 500,
+        .scale      = SCALE_INIT(0, 500),
+        .init_value = 0,
+        .is_dshot   = false
+    }
+};
+
+
+// nrf_drv_pwm handlers don't have a context pointer so the sets are looked
+// up by the instance index of their first group.
+static actuator_group_t * m_groups[PWM_INSTANCE_COUNT];
+
+
+static inline uint16_t m_step_value_get(const profile_t * p_profile,
+                                            uint16_t frame,
+                                            uint32_t step)
+{
+    if (ACTUATOR_DSHOT_FRAME_BITS <= step)
+    {
+        // A compare value of zero keeps the output low for the whole period.
+        return CH_ENABLED_MASK;
+    }
+
+    if (frame & (0x8000 >> step))
+    {
+        return (CH_ENABLED_MASK | p_profile->t1h);
+    }
+
+    return (CH_ENABLED_MASK | p_profile->t0h);
+}
+
+
+static inline uint16_t m_value_to_ticks(const profile_t * p_profile,
+                                            uint8_t value)
+{
+    if (p_profile->is_dshot && (ACTUATOR_MIN_VALUE == value))
+    {
+        return 0;
+    }
+
+    return scale_map(&p_profile->scale, value);
+}
+
+
+// The division is by a constant so the compiler replaces it with a
+// multiplication.
+static inline uint16_t m_hr_value_to_ticks(const profile_t * p_profile,
+                                               uint16_t value)
+{
+    if (p_profile->is_dshot && (ACTUATOR_MIN_VALUE == value))
+    {
+        return 0;
+    }
+
+    return (p_profile->scale.min +
+                ((uint32_t)value * p_profile->scale.range / ACTUATOR_HR_MAX_VALUE));
+}
+
+
+// Renders committed values into a sequence buffer that EasyDMA is no longer
+// reading.
+static void m_seq_render(actuator_group_t * p_group,
+                             uint32_t seq_index,
+                             const uint16_t values[ACTUATOR_CHANNEL_COUNT],
+                             uint32_t gen)
+{
+    const profile_t             *p_profile;
+    nrf_pwm_values_individual_t *p_steps;
+    uint16_t                    frames[ACTUATOR_CHANNEL_COUNT];
+    uint32_t                    i;
+
+    if (gen == p_group->seq_gen[seq_index])
+    {
+        return;
+    }
+
+    p_profile = &PROFILES[p_group->profile];
+    p_steps   = p_group->seq_values[seq_index];
+
+    if (!p_profile->is_dshot)
+    {
+        p_steps[0].channel_0 = (CH_ENABLED_MASK | values[0]);
+        p_steps[0].channel_1 = (CH_ENABLED_MASK | values[1]);
+        p_steps[0].channel_2 = (CH_ENABLED_MASK | values[2]);
+        p_steps[0].channel_3 = (CH_ENABLED_MASK | values[3]);
+    }
+    else
+    {
+        for (i = 0; i < ACTUATOR_CHANNEL_COUNT; i++)
+        {
+            frames[i] = actuator_dshot_frame_encode(values[i], false);
+        }
+
+        for (i = 0; i < ACTUATOR_SEQ_MAX_STEPS; i++)
+        {
+            p_steps[i].channel_0 = m_step_value_get(p_profile, frames[0], i);
+            p_steps[i].channel_1 = m_step_value_get(p_profile, frames[1], i);
+            p_steps[i].channel_2 = m_step_value_get(p_profile, frames[2], i);
+            p_steps[i].channel_3 = m_step_value_get(p_profile, frames[3], i);
+        }
+    }
+
+    p_group->seq_gen[seq_index] = gen;
+}
+
+
+// Renders the buffer of every group of a set that has just been played. The
+// committed values of all of them are copied together with their generations
+// in one go so that the groups render the same commits, and a commit that
+// preempts the rendering is picked up at the end of the buffer's next frame
+// instead of being partially rendered.
+static void m_set_update(actuator_group_t * p_first, uint32_t seq_index)
+{
+    actuator_group_t *p_group;
+    uint16_t         values[PWM_INSTANCE_COUNT][ACTUATOR_CHANNEL_COUNT];
+    uint32_t         gens[PWM_INSTANCE_COUNT];
+    uint32_t         i;
+
+    if (NULL == p_first)
+    {
+        return;
+    }
+
+    CRITICAL_REGION_ENTER();
+    for (p_group = p_first, i = 0; NULL != p_group; p_group = p_group->p_next, i++)
+    {
+        gens[i] = p_group->staged_gen;
+        memcpy(values[i], p_group->staged_values, sizeof(values[i]));
+    }
+    CRITICAL_REGION_EXIT();
+
+    for (p_group = p_first, i = 0; NULL != p_group; p_group = p_group->p_next, i++)
+    {
+        m_seq_render(p_group, seq_index, values[i], gens[i]);
+    }
+
+    CRITICAL_REGION_ENTER();
+    p_first->next_seq       = seq_index;
+    p_first->rendered_ticks = app_timer_cnt_get();
+    CRITICAL_REGION_EXIT();
+}
+
+
+// Whether the buffer that plays next can still be rendered before EasyDMA
+// loads it. The interrupt that rendered it ran within ACTUATOR_SEQ_MIN_US of
+// the previous boundary so the next one is at least ahead_ticks after that.
+// Once the boundary has passed the interrupt for it hasn't recorded its
+// rendering yet (or is being preempted) so the window has been missed too.
+static bool m_next_seq_is_idle(const actuator_group_t * p_first)
+{
+    uint32_t elapsed;
+
+    if (ACTUATOR_SEQ_BUFF_COUNT <= p_first->next_seq)
+    {
+        return false;
+    }
+
+    elapsed = app_timer_cnt_diff_compute(app_timer_cnt_get(), p_first->rendered_ticks);
+
+    return ((elapsed + AHEAD_MARGIN_TICKS) < p_first->ahead_ticks);
+}
+
+
+// Connects the start tasks to one EGU event and triggers it so that every
+// PWM of the set starts on the same clock edge. Each PPI channel starts two
+// groups (the second one through the fork).
+static uint32_t m_sync_start(const uint32_t tasks[], uint32_t count)
+{
+    nrf_ppi_channel_t channels[CEILING(PWM_INSTANCE_COUNT, 2)];
+    uint32_t          channel_count;
+    uint32_t          event;
+    uint32_t          err_code;
+    uint32_t          i;
+
+    err_code = nrf_drv_ppi_init();
+    if ((NRF_SUCCESS != err_code) && (NRF_ERROR_MODULE_ALREADY_INITIALIZED != err_code))
+    {
+        return err_code;
+    }
+
+    event         = (uint32_t)nrf_egu_event_address_get(ACTUATOR_SYNC_EGU,
+                                                            NRF_EGU_EVENT_TRIGGERED0);
+    channel_count = CEILING(count, 2);
+
+    for (i = 0; i < channel_count; i++)
+    {
+        err_code = nrf_drv_ppi_channel_alloc(&channels[i]);
+        if (NRF_SUCCESS == err_code)
+        {
+            err_code = nrf_drv_ppi_channel_assign(channels[i], event, tasks[2 * i]);
+        }
+        if ((NRF_SUCCESS == err_code) && (((2 * i) + 1) < count))
+        {
+            err_code = nrf_drv_ppi_channel_fork_assign(channels[i], tasks[(2 * i) + 1]);
+        }
+        if (NRF_SUCCESS == err_code)
+        {
+            err_code = nrf_drv_ppi_channel_enable(channels[i]);
+        }
+        if (NRF_SUCCESS != err_code)
+        {
+            return err_code;
+        }
+    }
+
+    nrf_egu_event_clear(ACTUATOR_SYNC_EGU, NRF_EGU_EVENT_TRIGGERED0);
+    nrf_egu_task_trigger(ACTUATOR_SYNC_EGU, NRF_EGU_TASK_TRIGGER0);
+    while (!nrf_egu_event_check(ACTUATOR_SYNC_EGU, NRF_EGU_EVENT_TRIGGERED0))
+    {
+        // Set within a few clock cycles.
+    }
+    nrf_egu_event_clear(ACTUATOR_SYNC_EGU, NRF_EGU_EVENT_TRIGGERED0);
+
+    for (i = 0; i < channel_count; i++)
+    {
+        (void)nrf_drv_ppi_channel_disable(channels[i]);
+        (void)nrf_drv_ppi_channel_free(channels[i]);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+static void m_pwm_handler(uint32_t instance_index,
+                              nrf_drv_pwm_evt_type_t event_type)
+{
+    switch (event_type)
+    {
+    case NRF_DRV_PWM_EVT_END_SEQ0:
+        m_set_update(m_groups[instance_index], 0);
+        break;
+    case NRF_DRV_PWM_EVT_END_SEQ1:
+        m_set_update(m_groups[instance_index], 1);
+        break;
+    default:
+        break;
+    }
+}
+
+
+static void m_pwm0_handler(nrf_drv_pwm_evt_type_t event_type)
+{
+    m_pwm_handler(0, event_type);
+}
+
+
+static void m_pwm1_handler(nrf_drv_pwm_evt_type_t event_type)
+{
+    m_pwm_handler(1, event_type);
+}
+
+
+static void m_pwm2_handler(nrf_drv_pwm_evt_type_t event_type)
+{
+    m_pwm_handler(2, event_type);
+}
+
+
+#ifdef NRF52840_XXAA
+static void m_pwm3_handler(nrf_drv_pwm_evt_type_t event_type)
+{
+    m_pwm_handler(3, event_type);
+}
+#endif
+
+
+static inline bool m_channel_is_enabled(const actuator_group_t * p_group,
+                                            uint8_t ch_index)
+{
+    return ((ACTUATOR_CHANNEL_COUNT > ch_index) &&
+                (0 != (p_group->enabled_mask & (1 << ch_index))));
+}
+
+
+uint16_t actuator_dshot_frame_encode(uint16_t throttle, bool telemetry)
+{
+    uint16_t packet;
+    uint16_t crc;
+
+    packet = (((throttle & ACTUATOR_DSHOT_THROTTLE_MAX) << 1) |
+                  (telemetry ? 1 : 0));
+    crc    = ((packet ^ (packet >> 4) ^ (packet >> 8)) & 0x0F);
+
+    return ((packet << 4) | crc);
+}
+
+
+uint32_t actuator_group_init(actuator_group_t * p_group,
+                                 uint8_t pwm_instance_index,
+                                 actuator_profile_t profile,
+                                 uint8_t ch0_pin,
+                                 uint8_t ch1_pin,
+                                 uint8_t ch2_pin,
+                                 uint8_t ch3_pin)
+{
+    uint32_t              err_code;
+    uint32_t              i;
+    uint32_t              period_ticks;
+    uint32_t              seq_ticks;
+    const profile_t       *p_profile;
+    nrf_drv_pwm_handler_t handler;
+
+    if ((NULL == p_group) || (ACTUATOR_PROFILE_COUNT <= profile))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    switch (pwm_instance_index)
+    {
+    case 0:
+        p_group->pwm_instance.p_registers  = NRF_PWM0;
+        p_group->pwm_instance.drv_inst_idx = PWM0_INSTANCE_INDEX;
+        handler = m_pwm0_handler;
+        break;
+    case 1:
+        p_group->pwm_instance.p_registers  = NRF_PWM1;
+        p_group->pwm_instance.drv_inst_idx = PWM1_INSTANCE_INDEX;
+        handler = m_pwm1_handler;
+        break;
+    case 2:
+        p_group->pwm_instance.p_registers  = NRF_PWM2;
+        p_group->pwm_instance.drv_inst_idx = PWM2_INSTANCE_INDEX;
+        handler = m_pwm2_handler;
+        break;
+#ifdef NRF52840_XXAA
+    case 3:
+        p_group->pwm_instance.p_registers  = NRF_PWM3;
+        p_group->pwm_instance.drv_inst_idx = PWM3_INSTANCE_INDEX;
+        handler = m_pwm3_handler;
+        break;
+#endif
+    default:
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    p_profile = &PROFILES[profile];
+
+    period_ticks = p_profile->top_value;
+    if (NRF_PWM_CLK_1MHz == p_profile->base_clock)
+    {
+        period_ticks *= (TICKS_PER_US_16MHZ / TICKS_PER_US_1MHZ);
+    }
+
+    if (p_profile->is_dshot)
+    {
+        // The output is held low (the last step is a gap) for the rest of the
+        // frame period. The delay is rounded up so that the sequence is never
+        // shorter than the frame period.
+        seq_ticks = (CEILING(ESC_DSHOT_FRAME_PERIOD_US * TICKS_PER_US_16MHZ,
+                                 period_ticks) * period_ticks);
+    }
+    else
+    {
+        // Each sequence is a single value that is repeated for whole periods
+        // so the staged values are picked up at most two sequences after
+        // they are committed.
+        seq_ticks = (CEILING(ACTUATOR_SEQ_MIN_US * TICKS_PER_US_16MHZ,
+                                 period_ticks) * period_ticks);
+    }
+
+    // Otherwise the PWM interrupt could still be rendering a buffer when
+    // EasyDMA starts loading it again.
+    if ((ACTUATOR_SEQ_MIN_US * TICKS_PER_US_16MHZ) > seq_ticks)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    nrf_drv_pwm_config_t const pwm_config =
+    {
+        .output_pins =
+        {
+            ch0_pin,
+            ch1_pin,
+            ch2_pin,
+            ch3_pin
+        },
+        .irq_priority = ACTUATOR_IRQ_PRIORITY,
+        .base_clock   = p_profile->base_clock,
+        .count_mode   = NRF_PWM_MODE_UP,
+        .top_value    = p_profile->top_value,
+        .load_mode    = NRF_PWM_LOAD_INDIVIDUAL,
+        .step_mode    = NRF_PWM_STEP_AUTO
+    };
+
+    err_code = nrf_drv_pwm_init(&p_group->pwm_instance, &pwm_config, handler);
+    if (NRF_SUCCESS != err_code)
+    {
+        return err_code;
+    }
+
+    p_group->profile        = profile;
+    p_group->instance_index = pwm_instance_index;
+    p_group->started        = false;
+    p_group->steps          = (p_profile->is_dshot ? ACTUATOR_SEQ_MAX_STEPS : 1);
+    p_group->period_ticks   = period_ticks;
+    p_group->seq_ticks      = seq_ticks;
+    p_group->p_set          = NULL;
+    p_group->next_seq       = ACTUATOR_SEQ_BUFF_COUNT;
+    p_group->p_next         = NULL;
+    p_group->enabled_mask   = 0;
+    p_group->enabled_mask |= ((ACTUATOR_PIN_NOT_USED != ch0_pin) << 0);
+    p_group->enabled_mask |= ((ACTUATOR_PIN_NOT_USED != ch1_pin) << 1);
+    p_group->enabled_mask |= ((ACTUATOR_PIN_NOT_USED != ch2_pin) << 2);
+    p_group->enabled_mask |= ((ACTUATOR_PIN_NOT_USED != ch3_pin) << 3);
+
+    for (i = 0; i < ACTUATOR_CHANNEL_COUNT; i++)
+    {
+        p_group->pending_values[i] = p_profile->init_value;
+        p_group->staged_values[i]  = p_profile->init_value;
+    }
+
+    // The sequence buffers are rendered by forcing a generation mismatch.
+    p_group->staged_gen = 1;
+    for (i = 0; i < ACTUATOR_SEQ_BUFF_COUNT; i++)
+    {
+        p_group->seq_gen[i] = 0;
+        m_seq_render(p_group, i, p_group->staged_values, p_group->staged_gen);
+    }
+
+    m_groups[pwm_instance_index] = NULL;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t actuator_groups_start(actuator_group_t * const p_groups[],
+                                   uint32_t group_count)
+{
+    actuator_group_t *p_group;
+    uint32_t         tasks[PWM_INSTANCE_COUNT];
+    uint32_t         seq_ticks = 0;
+    uint32_t         periods;
+    uint32_t         flags;
+    uint32_t         i;
+
+    if ((0 == group_count) || (PWM_INSTANCE_COUNT < group_count))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    for (i = 0; i < group_count; i++)
+    {
+        if (NULL == p_groups[i])
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+        if (p_groups[i]->started)
+        {
+            return NRF_ERROR_INVALID_STATE;
+        }
+        if (seq_ticks < p_groups[i]->seq_ticks)
+        {
+            seq_ticks = p_groups[i]->seq_ticks;
+        }
+    }
+
+    // The boundaries only stay together if every sequence is exactly as long.
+    for (i = 0; i < group_count; i++)
+    {
+        if (0 != (seq_ticks % p_groups[i]->period_ticks))
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+    }
+
+    // The second buffer plays next, a sequence after the start.
+    p_groups[0]->next_seq       = 1;
+    p_groups[0]->rendered_ticks = app_timer_cnt_get();
+    p_groups[0]->ahead_ticks    = 0;
+    if ((seq_ticks / TICKS_PER_US_16MHZ) > ACTUATOR_SEQ_MIN_US)
+    {
+        uint64_t window_us = ((seq_ticks / TICKS_PER_US_16MHZ) - ACTUATOR_SEQ_MIN_US);
+
+        p_groups[0]->ahead_ticks = (uint32_t)((window_us * APP_TIMER_CLOCK_FREQ) /
+                                                  (1000000ULL *
+                                                   (APP_TIMER_CONFIG_RTC_FREQUENCY + 1)));
+    }
+
+    for (i = 0; i < group_count; i++)
+    {
+        p_group         = p_groups[i];
+        p_group->p_set  = p_groups[0];
+        p_group->p_next = (((i + 1) < group_count) ? p_groups[i + 1] : NULL);
+        periods         = (seq_ticks / p_group->period_ticks);
+
+        // Analog values are repeated for the whole sequence and DShot frames
+        // are followed by a gap.
+        nrf_pwm_sequence_t const seq0 =
+        {
+            .values.p_individual = p_group->seq_values[0],
+            .length              = (p_group->steps * ACTUATOR_CHANNEL_COUNT),
+            .repeats             = ((1 == p_group->steps) ? (periods - 1) : 0),
+            .end_delay           = ((1 == p_group->steps) ? 0 : (periods - p_group->steps))
+        };
+        nrf_pwm_sequence_t const seq1 =
+        {
+            .values.p_individual = p_group->seq_values[1],
+            .length              = seq0.length,
+            .repeats             = seq0.repeats,
+            .end_delay           = seq0.end_delay
+        };
+
+        // Only the first group signals the end of its sequences since it
+        // renders the buffers of the whole set.
+        flags = NRF_DRV_PWM_FLAG_LOOP;
+        if (0 == i)
+        {
+            flags |= (NRF_DRV_PWM_FLAG_SIGNAL_END_SEQ0 |
+                          NRF_DRV_PWM_FLAG_SIGNAL_END_SEQ1);
+            m_groups[p_group->instance_index] = p_group;
+        }
+        if (1 < group_count)
+        {
+            flags |= NRF_DRV_PWM_FLAG_START_VIA_TASK;
+        }
+
+        tasks[i] = nrf_drv_pwm_complex_playback(&p_group->pwm_instance,
+                                                    &seq0,
+                                                    &seq1,
+                                                    1,
+                                                    flags);
+        p_group->started = true;
+    }
+
+    if (1 < group_count)
+    {
+        return m_sync_start(tasks, group_count);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t actuator_value_get(actuator_group_t * p_group,
+                                uint8_t ch_index,
+                                uint8_t * p_value)
+{
+    const profile_t *p_profile;
+    uint16_t        value;
+
+    if (!m_channel_is_enabled(p_group, ch_index))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    p_profile = &PROFILES[p_group->profile];
+    value     = p_group->pending_values[ch_index];
+
+    if (p_profile->is_dshot && (0 == value))
+    {
+        *p_value = ACTUATOR_MIN_VALUE;
+    }
+    else
+    {
+        *p_value = scale_pam(&p_profile->scale, value);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t actuator_value_stage(actuator_group_t * p_group,
+                                  uint8_t ch_index,
+                                  uint8_t value)
+{
+    if (ACTUATOR_MAX_VALUE < value)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (!m_channel_is_enabled(p_group, ch_index))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    p_group->pending_values[ch_index] = m_value_to_ticks(&PROFILES[p_group->profile],
+                                                             value);
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t actuator_values_stage(actuator_group_t * p_group,
+                                   const uint8_t values[ACTUATOR_CHANNEL_COUNT])
+{
+    const profile_t *p_profile;
+    uint32_t        i;
+
+    for (i = 0; i < ACTUATOR_CHANNEL_COUNT; i++)
+    {
+        if (ACTUATOR_MAX_VALUE < values[i])
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+    }
+
+    p_profile = &PROFILES[p_group->profile];
+
+    for (i = 0; i < ACTUATOR_CHANNEL_COUNT; i++)
+    {
+        if (p_group->enabled_mask & (1 << i))
+        {
+            p_group->pending_values[i] = m_value_to_ticks(p_profile, values[i]);
+        }
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t actuator_value_hr_stage(actuator_group_t * p_group,
+                                     uint8_t ch_index,
+                                     uint16_t value)
+{
+    if (ACTUATOR_HR_MAX_VALUE < value)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (!m_channel_is_enabled(p_group, ch_index))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    p_group->pending_values[ch_index] = m_hr_value_to_ticks(&PROFILES[p_group->profile],
+                                                                value);
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t actuator_values_hr_stage(actuator_group_t * p_group,
+                                      const uint16_t values[ACTUATOR_CHANNEL_COUNT])
+{
+    const profile_t *p_profile;
+    uint32_t        i;
+
+    for (i = 0; i < ACTUATOR_CHANNEL_COUNT; i++)
+    {
+        if (ACTUATOR_HR_MAX_VALUE < values[i])
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+    }
+
+    p_profile = &PROFILES[p_group->profile];
+
+    for (i = 0; i < ACTUATOR_CHANNEL_COUNT; i++)
+    {
+        if (p_group->enabled_mask & (1 << i))
+        {
+            p_group->pending_values[i] = m_hr_value_to_ticks(p_profile, values[i]);
+        }
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+void actuator_commit(actuator_group_t * const p_groups[],
+                         uint32_t group_count)
+{
+    uint32_t i;
+
+    CRITICAL_REGION_ENTER();
+    for (i = 0; i < group_count; i++)
+    {
+        memcpy(p_groups[i]->staged_values,
+                   p_groups[i]->pending_values,
+                   sizeof(p_groups[i]->staged_values));
+        p_groups[i]->staged_gen++;
+    }
+
+    // Unless the PWM interrupt is about to, the sets render the commit into
+    // the buffer that plays next so that it is output at the next boundary.
+    for (i = 0; i < group_count; i++)
+    {
+        actuator_group_t *p_first = p_groups[i]->p_set;
+        actuator_group_t *p_group;
+
+        if ((NULL != p_first) && m_next_seq_is_idle(p_first))
+        {
+            for (p_group = p_first; NULL != p_group; p_group = p_group->p_next)
+            {
+                m_seq_render(p_group,
+                                 p_first->next_seq,
+                                 p_group->staged_values,
+                                 p_group->staged_gen);
+            }
+        }
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+
+uint32_t actuator_value_set(actuator_group_t * p_group,
+                                uint8_t ch_index,
+                                uint8_t value)
+{
+    uint32_t err_code;
+
+    err_code = actuator_value_stage(p_group, ch_index, value);
+    if (NRF_SUCCESS == err_code)
+    {
+        actuator_commit(&p_group, 1);
+    }
+
+    return err_code;
+}
+
+
+uint32_t actuator_values_set(actuator_group_t * p_group,
+                                 const uint8_t values[ACTUATOR_CHANNEL_COUNT])
+{
+    uint32_t err_code;
+
+    err_code = actuator_values_stage(p_group, values);
+    if (NRF_SUCCESS == err_code)
+    {
+        actuator_commit(&p_group, 1);
+    }
+
+    return err_code;
+}
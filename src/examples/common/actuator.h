@@ -0,0 +1,218 @@
+/**
+ * A generic wrapper around the nrf_drv_pwm driver's
+ * nrf_drv_pwm_complex_playback functionality that is shared by the servo, ESC
+ * and brushed DC motor drivers. The devices only differ by their profile (PWM
+ * clock, period and pulse range), which is looked up from a const table.
+ *
+ * Each group loops over two sequences. Values are first staged in a pending
+ * copy that the PWM interrupt never reads. actuator_commit publishes the
+ * pending values of one or more groups at once and each group renders them
+ * into a sequence buffer after EasyDMA has finished with it. A frame is
+ * therefore always generated from a single commit.
+ *
+ * A group doesn't output anything until it is started by
+ * actuator_groups_start. Groups that are started together form a set: their
+ * sequences are padded to the same length and they are started from one EGU
+ * event through PPI so their sequence boundaries stay on the same PWM clock
+ * edge. The first group of the set renders the buffers of every group from
+ * one snapshot of the commits when its sequence ends, so the groups of a set
+ * switch to the values of a commit at the same boundary. actuator_commit
+ * also renders the buffer that plays next when it is at least
+ * ACTUATOR_SEQ_MIN_US (and the RTC's resolution) before the next boundary, so
+ * a commit is output at the next boundary unless it comes later than that, in
+ * which case it is output at the one after. Sets whose sequences are only
+ * ACTUATOR_SEQ_MIN_US long (e.g. DShot) always leave it to the interrupt and
+ * output a commit within two sequences. Groups in different sets switch at
+ * their own boundaries.
+ */
+#ifndef ACTUATOR_H
+#define ACTUATOR_H
+
+#include "stdint.h"
+#include "stdbool.h"
+
+#include "nrf_pwm.h"
+#include "nrf_drv_pwm.h"
+
+
+#define ACTUATOR_MIN_VALUE        (0UL)
+#define ACTUATOR_MAX_VALUE        (100UL)
+#define ACTUATOR_HR_MAX_VALUE     (4095UL) // Used by the *_hr_* functions
+
+#define ACTUATOR_PIN_NOT_USED     (NRF_DRV_PWM_PIN_NOT_USED)
+
+// The PWM frame period in microseconds used by ACTUATOR_PROFILE_RSMS_SERVO.
+// The default suits analog servos. Digital servos can be driven faster (e.g.
+// 3003 for 333 Hz) by overriding this in the Makefile. Only servos that
+// accept the frame rate should be connected.
+#ifndef SERVO_FRAME_PERIOD_US
+    #define SERVO_FRAME_PERIOD_US (20000UL)
+#endif
+
+// The PWM interrupt renders each sequence buffer while the other one is
+// being played, so it has to run within one sequence of the END event that
+// asks for it. Analog sequences repeat their period until they are at least
+// this long. It must be longer than the time that the interrupts with a
+// higher priority than ACTUATOR_IRQ_PRIORITY can delay the PWM interrupt
+// (i.e. rc_radio's handlers and the callbacks they run, which can be measured
+// with rc_radio_isr_stats_get).
+#ifndef ACTUATOR_SEQ_MIN_US
+    #define ACTUATOR_SEQ_MIN_US (1000UL)
+#endif
+
+// Just below rc_radio's handlers (priorities 0 and 1).
+#ifndef ACTUATOR_IRQ_PRIORITY
+    #define ACTUATOR_IRQ_PRIORITY (APP_IRQ_PRIORITY_HIGH)
+#endif
+
+// The interval between DShot frames. A DShot sequence is a single frame so
+// actuator_group_init fails if this is less than ACTUATOR_SEQ_MIN_US.
+#ifndef ESC_DSHOT_FRAME_PERIOD_US
+    #define ESC_DSHOT_FRAME_PERIOD_US (1000UL)
+#endif
+
+// The EGU whose event actuator_groups_start uses to start a set. It is only
+// used while the set is started, as are the PPI channels that it allocates.
+#ifndef ACTUATOR_SYNC_EGU
+    #define ACTUATOR_SYNC_EGU (NRF_EGU4)
+#endif
+
+#define ACTUATOR_CHANNEL_COUNT    (4UL)
+#define ACTUATOR_SEQ_BUFF_COUNT   (2UL)
+#define ACTUATOR_DSHOT_FRAME_BITS (16UL)
+#define ACTUATOR_DSHOT_GAP_BITS   (2UL)  // Low periods that end each frame
+#define ACTUATOR_SEQ_MAX_STEPS    (ACTUATOR_DSHOT_FRAME_BITS + \
+                                       ACTUATOR_DSHOT_GAP_BITS)
+
+#define ACTUATOR_DSHOT_THROTTLE_MIN (48UL) // [1, 47] are special commands
+#define ACTUATOR_DSHOT_THROTTLE_MAX (2047UL)
+
+
+typedef enum
+{
+    ACTUATOR_PROFILE_RSMS_SERVO,     // RadioShack micro servo, 600-2500 us
+    ACTUATOR_PROFILE_ESC_PWM,        // 1000-2000 us pulse, 50 Hz
+    ACTUATOR_PROFILE_ESC_ONESHOT125, // 125-250 us pulse, 2 kHz
+    ACTUATOR_PROFILE_ESC_MULTISHOT,  // 5-25 us pulse, 8 kHz
+    ACTUATOR_PROFILE_ESC_DSHOT150,
+    ACTUATOR_PROFILE_ESC_DSHOT300,
+    ACTUATOR_PROFILE_ESC_DSHOT600,
+    ACTUATOR_PROFILE_BDCM,           // 0-100% duty cycle, 2 kHz
+    ACTUATOR_PROFILE_COUNT
+} actuator_profile_t;
+
+
+// Structs of this type need to kept in the global portion (static) of RAM
+// (not const) because they are accessed by EasyDMA.
+typedef struct actuator_group_s
+{
+    nrf_drv_pwm_t pwm_instance;
+    actuator_profile_t profile;
+    uint8_t enabled_mask;
+    uint8_t instance_index;
+    bool started;
+    uint16_t steps;         // Values per sequence
+    uint32_t period_ticks;  // PWM period in 16 MHz ticks
+    uint32_t seq_ticks;     // Sequence length in 16 MHz ticks when started alone
+    struct actuator_group_s * p_set;  // First group of the set
+    struct actuator_group_s * p_next; // Next group of the set
+    // Only used in the first group of a set: the buffer that plays next, when
+    // the interrupt rendered it and for how long after that a commit can
+    // still render it.
+    uint8_t next_seq;
+    uint32_t rendered_ticks;
+    uint32_t ahead_ticks;
+    uint16_t pending_values[ACTUATOR_CHANNEL_COUNT]; // Ticks or DShot throttle
+    uint16_t staged_values[ACTUATOR_CHANNEL_COUNT];  // Last commit
+    volatile uint32_t staged_gen;
+    uint32_t seq_gen[ACTUATOR_SEQ_BUFF_COUNT];
+    nrf_pwm_values_individual_t seq_values[ACTUATOR_SEQ_BUFF_COUNT]
+                                          [ACTUATOR_SEQ_MAX_STEPS];
+} actuator_group_t;
+
+
+// The pwm_instance should be in the range [0, 2] on the nRF52832. The chX_pins
+// can be set to any GPIO or set to ACTUATOR_PIN_NOT_USED if the channel is not
+// required. Only one group can be initialized per pwm_instance. Returns
+// NRF_ERROR_INVALID_PARAM if the profile's sequence would be shorter than
+// ACTUATOR_SEQ_MIN_US. The outputs stay idle until the group is started.
+uint32_t actuator_group_init(actuator_group_t * p_group,
+                                 uint8_t pwm_instance_index,
+                                 actuator_profile_t profile,
+                                 uint8_t ch0_pin,
+                                 uint8_t ch1_pin,
+                                 uint8_t ch2_pin,
+                                 uint8_t ch3_pin);
+
+
+// Starts the given groups together as a set (see above). The sequences of
+// every group are padded to the longest one, so each group's PWM period has
+// to divide it. Returns NRF_ERROR_INVALID_PARAM (and starts nothing) if one
+// doesn't, e.g. DShot next to 50 Hz servos, in which case the groups can be
+// started on their own instead. Returns NRF_ERROR_INVALID_STATE if a group
+// has already been started.
+uint32_t actuator_groups_start(actuator_group_t * const p_groups[],
+                                   uint32_t group_count);
+
+
+// Returns NRF_ERROR_INVALID_PARAM if the given ch_index is not assigned to a
+// pin. The p_value variable will be scaled to the range
+// [ACTUATOR_MIN_VALUE, ACTUATOR_MAX_VALUE].
+uint32_t actuator_value_get(actuator_group_t * p_group,
+                                uint8_t ch_index,
+                                uint8_t * p_value);
+
+
+// Returns NRF_ERROR_INVALID_PARAM if the given ch_index is not assigned to a
+// pin. The value variable should be in the range
+// [ACTUATOR_MIN_VALUE, ACTUATOR_MAX_VALUE]. With DShot a value of
+// ACTUATOR_MIN_VALUE sends the disarm command instead of a throttle. The
+// value is not output until actuator_commit is called.
+uint32_t actuator_value_stage(actuator_group_t * p_group,
+                                  uint8_t ch_index,
+                                  uint8_t value);
+
+
+// Stages every channel of the group. The values of channels that are not
+// assigned to a pin are ignored. Returns NRF_ERROR_INVALID_PARAM (and
+// changes nothing) if any of the values is out of range.
+uint32_t actuator_values_stage(actuator_group_t * p_group,
+                                   const uint8_t values[ACTUATOR_CHANNEL_COUNT]);
+
+
+// The same as actuator_value_stage but the value is in the range
+// [ACTUATOR_MIN_VALUE, ACTUATOR_HR_MAX_VALUE] so that the full resolution of
+// the PWM compare values can be used (e.g. 1 us steps for servos).
+uint32_t actuator_value_hr_stage(actuator_group_t * p_group,
+                                     uint8_t ch_index,
+                                     uint16_t value);
+
+
+// The same as actuator_values_stage but the values are in the range
+// [ACTUATOR_MIN_VALUE, ACTUATOR_HR_MAX_VALUE].
+uint32_t actuator_values_hr_stage(actuator_group_t * p_group,
+                                      const uint16_t values[ACTUATOR_CHANNEL_COUNT]);
+
+
+// Publishes the staged values of all of the given groups atomically. Each
+// group outputs them at the next or the following boundary and the groups of
+// a set switch at the same boundary (see above).
+void actuator_commit(actuator_group_t * const p_groups[],
+                         uint32_t group_count);
+
+
+// Stages and commits a single value.
+uint32_t actuator_value_set(actuator_group_t * p_group,
+                                uint8_t ch_index,
+                                uint8_t value);
+
+
+// Stages and commits every channel of the group.
+uint32_t actuator_values_set(actuator_group_t * p_group,
+                                 const uint8_t values[ACTUATOR_CHANNEL_COUNT]);
+
+
+// Returns the 16-bit DShot frame (MSB first) for an 11-bit throttle value.
+uint16_t actuator_dshot_frame_encode(uint16_t throttle, bool telemetry);
+
+#endif
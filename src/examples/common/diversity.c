@@ -0,0 +1,274 @@
+#include "string.h"
+
+#include "app_timer.h"
+#include "app_util_platform.h"
+#include "nrf_error.h"
+
+#include "diversity.h"
+
+
+#define US_TO_TICKS(us) (((us) * (uint64_t)APP_TIMER_CLOCK_FREQ) / \
+                             (1000000UL * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1)))
+
+// Used until RC_RADIO_EVENT_BOUND gives the transmit interval: half of the
+// shortest transmit interval (500 Hz). The partner can be bound and
+// forwarding frames before the local receiver is.
+#define DEFAULT_WINDOW_US (1000UL)
+
+// The partner is treated as gone after this many held drops in a row timed
+// out without a message from it in between. A message lost on the link now
+// and then doesn't stop the following drops from being held.
+#define LINK_TIMEOUT_LIMIT (3UL)
+
+
+static rc_radio_event_handler_t m_handler;
+static diversity_link_send_t    m_link_send;
+static diversity_stats_t        m_stats;
+static uint32_t                 m_window_ticks;
+static uint32_t                 m_last_forward_ticks;
+static bool                     m_forwarded=false;
+static bool                     m_link_alive;
+static uint32_t                 m_link_timeout_count;
+static bool                     m_drop_pending;
+static uint32_t                 m_drop_ticks;
+static bool                     m_remote_dropped;
+static uint32_t                 m_remote_drop_ticks;
+
+
+// Returns true if nothing has been delivered during the period that the
+// timestamp falls in. The period is only claimed if the caller is going to
+// deliver something.
+static bool m_period_is_open(uint32_t ticks, bool claim)
+{
+    bool is_open;
+
+    CRITICAL_REGION_ENTER();
+
+    is_open = ((!m_forwarded) ||
+                   (m_window_ticks <=
+                       app_timer_cnt_diff_compute(ticks, m_last_forward_ticks)));
+
+    if (is_open && claim)
+    {
+        m_forwarded          = true;
+        m_last_forward_ticks = ticks;
+    }
+
+    CRITICAL_REGION_EXIT();
+
+    return is_open;
+}
+
+
+// The counters are read by diversity_stats_get from the main context so they
+// are updated with interrupts disabled.
+static void m_stat_increment(uint32_t * p_count)
+{
+    CRITICAL_REGION_ENTER();
+    (*p_count)++;
+    CRITICAL_REGION_EXIT();
+}
+
+
+static void m_combined_drop_deliver(uint32_t ticks)
+{
+    m_drop_pending   = false;
+    m_remote_dropped = false;
+
+    // The period is claimed at the time of the local drop so that a copy of
+    // the frame that turns up after all is discarded as a duplicate.
+    if (m_period_is_open(ticks, true))
+    {
+        m_stat_increment(&m_stats.frames_dropped_combined);
+        m_handler(RC_RADIO_EVENT_PACKET_DROPPED, NULL);
+    }
+}
+
+
+// A held drop is delivered once the partner's message for that period is
+// overdue. After LINK_TIMEOUT_LIMIT of them the partner is assumed to be gone
+// (until it sends something again) so that the following drops aren't held.
+static void m_pending_drop_flush(uint32_t now)
+{
+    if (m_drop_pending &&
+        (m_window_ticks <= app_timer_cnt_diff_compute(now, m_drop_ticks)))
+    {
+        m_link_timeout_count++;
+        if (LINK_TIMEOUT_LIMIT <= m_link_timeout_count)
+        {
+            m_link_alive = false;
+        }
+        m_stat_increment(&m_stats.link_timeouts);
+        m_combined_drop_deliver(m_drop_ticks);
+    }
+}
+
+
+static void m_data_put(diversity_source_t source,
+                           const rc_radio_data_t * p_data)
+{
+    m_stat_increment(&m_stats.frames_received[source]);
+
+    // Either receiver getting the frame cancels the drop.
+    m_drop_pending = false;
+
+    if (m_period_is_open(app_timer_cnt_get(), true))
+    {
+        m_stat_increment(&m_stats.frames_forwarded);
+        m_handler(RC_RADIO_EVENT_DATA_RECEIVED, p_data);
+    }
+    else
+    {
+        m_stat_increment(&m_stats.frames_duplicate);
+    }
+}
+
+
+// The local receiver's CC1 interrupt marks the end of the period but the
+// partner's copy of the frame can still be on its way over the link (about
+// 70 us at 1 Mbaud plus the partner's own latency). The drop is held until
+// the partner reports its own drop or the window runs out.
+static void m_dropped_put(diversity_source_t source)
+{
+    uint32_t now;
+
+    m_stat_increment(&m_stats.frames_dropped[source]);
+
+    now = app_timer_cnt_get();
+
+    if (DIVERSITY_SOURCE_LOCAL == source)
+    {
+        if (!m_period_is_open(now, false))
+        {
+            // The partner's copy has already been delivered.
+        }
+        else if (m_remote_dropped &&
+                     (m_window_ticks >
+                         app_timer_cnt_diff_compute(now, m_remote_drop_ticks)))
+        {
+            m_combined_drop_deliver(now);
+        }
+        else if (m_link_alive)
+        {
+            m_drop_pending = true;
+            m_drop_ticks   = now;
+        }
+        else
+        {
+            m_combined_drop_deliver(now);
+        }
+    }
+    else if (m_drop_pending)
+    {
+        m_combined_drop_deliver(m_drop_ticks);
+    }
+    else
+    {
+        // The partner's CC1 can fire before the local one.
+        m_remote_dropped    = true;
+        m_remote_drop_ticks = now;
+    }
+}
+
+
+uint32_t diversity_init(rc_radio_event_handler_t handler,
+                            diversity_link_send_t link_send)
+{
+    if (NULL == handler)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    m_handler      = handler;
+    m_link_send    = link_send;
+    m_window_ticks = US_TO_TICKS(DEFAULT_WINDOW_US);
+    m_forwarded    = false;
+
+    m_link_alive         = false;
+    m_link_timeout_count = 0;
+    m_drop_pending       = false;
+    m_remote_dropped     = false;
+
+    memset(&m_stats, 0, sizeof(m_stats));
+
+    return NRF_SUCCESS;
+}
+
+
+void diversity_rc_radio_handler(rc_radio_event_t event,
+                                    const void * const p_context)
+{
+    // RC_RADIO_EVENT_BINDING is also delivered from rc_radio_enable so only
+    // the events from the radio interrupts touch the held drop.
+    if ((RC_RADIO_EVENT_DATA_RECEIVED == event) ||
+        (RC_RADIO_EVENT_PACKET_DROPPED == event))
+    {
+        m_pending_drop_flush(app_timer_cnt_get());
+    }
+
+    switch (event)
+    {
+    case RC_RADIO_EVENT_BOUND:
+    {
+        const rc_radio_bind_info_t * p_bind_info;
+        p_bind_info = (const rc_radio_bind_info_t*) p_context;
+
+        // Copies of the same frame are expected to arrive well within half
+        // of a transmit interval of each other.
+        m_window_ticks = US_TO_TICKS(500000UL / p_bind_info->transmit_rate_hz);
+
+        m_handler(event, p_context);
+    }
+        break;
+    case RC_RADIO_EVENT_DATA_RECEIVED:
+        if (NULL != m_link_send)
+        {
+            m_link_send(event, (const rc_radio_data_t*) p_context);
+        }
+        m_data_put(DIVERSITY_SOURCE_LOCAL, (const rc_radio_data_t*) p_context);
+        break;
+    case RC_RADIO_EVENT_PACKET_DROPPED:
+        if (NULL != m_link_send)
+        {
+            m_link_send(event, NULL);
+        }
+        m_dropped_put(DIVERSITY_SOURCE_LOCAL);
+        break;
+    default:
+        m_handler(event, p_context);
+        break;
+    }
+}
+
+
+void diversity_remote_event_put(rc_radio_event_t event,
+                                    const rc_radio_data_t * p_data)
+{
+    m_pending_drop_flush(app_timer_cnt_get());
+
+    m_link_alive         = true;
+    m_link_timeout_count = 0;
+
+    switch (event)
+    {
+    case RC_RADIO_EVENT_DATA_RECEIVED:
+        if (NULL != p_data)
+        {
+            m_data_put(DIVERSITY_SOURCE_REMOTE, p_data);
+        }
+        break;
+    case RC_RADIO_EVENT_PACKET_DROPPED:
+        m_dropped_put(DIVERSITY_SOURCE_REMOTE);
+        break;
+    default:
+        break;
+    }
+}
+
+
+void diversity_stats_get(diversity_stats_t * p_stats)
+{
+    CRITICAL_REGION_ENTER();
+    memcpy(p_stats, &m_stats, sizeof(diversity_stats_t));
+    CRITICAL_REGION_EXIT();
+}
@@ -0,0 +1,96 @@
+/**
+ * Combines the frames from two receivers into a single stream of rc_radio
+ * events. Each receiver runs its own rc_radio instance and forwards its
+ * events to its partner over a wired link. The first copy of a frame that
+ * arrives (from either receiver) is delivered to the application
+ * immediately so the combiner does not add latency; the second copy is
+ * discarded as a duplicate.
+ *
+ * Frames are matched by arrival time: any frame that arrives within half of
+ * a transmit interval of the previously delivered frame is considered to be
+ * a copy of it. The transmit interval is taken from the local receiver's
+ * RC_RADIO_EVENT_BOUND event (half of the shortest interval is used until
+ * then).
+ *
+ * A frame is only reported as dropped once both receivers have missed it.
+ * When the local receiver misses a frame the drop is held until the partner
+ * reports its drop (or its copy of the frame arrives). If the partner's
+ * message for that period doesn't arrive within the window the drop is
+ * delivered with the next event, i.e. up to an interval late. After a few of
+ * those in a row the link is treated as down, and drops are delivered
+ * straight away, until the partner sends something again. A copy that
+ * arrives after its period's drop is discarded so the application never sees
+ * a drop followed by the same period's frame.
+ *
+ * NOTE: The app_timer module must be initialized (and the LFCLK started)
+ *       before diversity_init is called because it is used for timestamps.
+ *
+ * NOTE: The application's handler is called from whichever context delivers
+ *       the frame (the rc_radio interrupt or the link's interrupt). The
+ *       link's interrupt must run at RC_RADIO_CALLBACK_IRQ_PRIORITY so that
+ *       neither can preempt the other.
+ */
+#ifndef DIVERSITY_H
+#define DIVERSITY_H
+
+#include "stdint.h"
+
+#include "rc_radio.h"
+
+
+typedef enum
+{
+    DIVERSITY_SOURCE_LOCAL,
+    DIVERSITY_SOURCE_REMOTE,
+    DIVERSITY_SOURCE_COUNT
+} diversity_source_t;
+
+
+typedef struct
+{
+    uint32_t frames_received[DIVERSITY_SOURCE_COUNT];
+    uint32_t frames_dropped[DIVERSITY_SOURCE_COUNT];
+    uint32_t frames_forwarded;
+    uint32_t frames_duplicate;
+    uint32_t frames_dropped_combined; // Neither receiver got the frame.
+    uint32_t link_timeouts;           // A held drop waited for the partner.
+} diversity_stats_t;
+
+
+/**
+ * Called by the combiner to forward a local event to the partner receiver.
+ * Only RC_RADIO_EVENT_DATA_RECEIVED (with p_data set) and
+ * RC_RADIO_EVENT_PACKET_DROPPED (with p_data set to NULL) are forwarded.
+ */
+typedef void (*diversity_link_send_t)(rc_radio_event_t event,
+                                          const rc_radio_data_t * p_data);
+
+
+/**
+ * The handler receives the combined event stream and can not be NULL. The
+ * link_send function can be NULL if this receiver does not forward its
+ * frames (e.g. a satellite receiver that only listens).
+ */
+uint32_t diversity_init(rc_radio_event_handler_t handler,
+                            diversity_link_send_t link_send);
+
+/**
+ * This function should be passed to rc_radio_receiver_init in place of the
+ * application's handler.
+ */
+void diversity_rc_radio_handler(rc_radio_event_t event,
+                                    const void * const p_context);
+
+/**
+ * Called by the link when the partner receiver forwards an event. The
+ * p_data parameter must be valid for RC_RADIO_EVENT_DATA_RECEIVED.
+ */
+void diversity_remote_event_put(rc_radio_event_t event,
+                                    const rc_radio_data_t * p_data);
+
+/**
+ * Copies the merged link statistics.
+ */
+void diversity_stats_get(diversity_stats_t * p_stats);
+
+#endif
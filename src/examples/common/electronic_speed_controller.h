@@ -1,53 +1,86 @@
-/**
- * A simple wrapper around the nrf_drv_pwm driver's nrf_drv_pwm_simple_playback
- * functionality.
- */
-#ifndef ESC_H
-#define ESC_H
-
-#include "nrf_pwm.h"
-#include "nrf_drv_pwm.h"
-
-
-#define ESC_THROTTLE_MIN_VALUE     (0L)
-#define ESC_THROTTLE_MAX_VALUE     (100UL)
-
-#define ESC_THROTTLE_PIN_NOT_USED  (NRF_DRV_PWM_PIN_NOT_USED)
-
-
-// Structs of this type need to kept in the global portion (static) of RAM
-// (not const) because they are accessed by EasyDMA.
-typedef struct
-{
-    nrf_drv_pwm_t pwm_instance;
-    nrf_pwm_values_individual_t pwm_values;
-} esc_throttle_group_t;
-
-
-// The pwm_instance should be in the range [0, 2] on the nRF52832. The chX_pins
-// can be set to any GPIO or set to ESC_THROTTLE_PIN_NOT_USED if the channel is
-// not required.
-uint32_t esc_throttle_group_init(esc_throttle_group_t * p_group,
-                                     uint8_t pwm_instance_index,
-                                     uint8_t ch0_pin,
-                                     uint8_t ch1_pin,
-                                     uint8_t ch2_pin,
-                                     uint8_t ch3_pin);
-
-
-// Returns NRF_ERROR_INVALID_PARAM if the given ch_index is not assigned to a
-// pin. The p_value variable will be scaled to the range
-// [ESC_THROTTLE_MIN_VALUE, ESC_THROTTLE_MAX_VALUE].
-uint32_t esc_throttle_value_get(esc_throttle_group_t * p_group,
-                                    uint8_t ch_index,
-                                    uint8_t * p_value);
-
-
-// Returns NRF_ERROR_INVALID_PARAM if the given ch_index is not assigned to a
-// pin. The value variable shouldbe be in the range
-// [ESC_THROTTLE_MIN_VALUE, ESC_THROTTLE_MAX_VALUE].
-uint32_t esc_throttle_value_set(esc_throttle_group_t * p_group,
-                                    uint8_t ch_index,
-                                    uint8_t value);
-
-#endif
+/**
+ * A thin wrapper around the actuator module for ESCs. The analog protocols
+ * (PWM, OneShot125 and Multishot) output one pulse per frame. The DShot
+ * protocols output a 16-bit frame (11-bit throttle, telemetry request bit and
+ * 4-bit CRC) with each bit encoded as the duty cycle of one PWM period.
+ */
+#ifndef ESC_H
+#define ESC_H
+
+#include "stdint.h"
+#include "stdbool.h"
+
+#include "actuator.h"
+
+
+#define ESC_THROTTLE_MIN_VALUE     (0L)
+#define ESC_THROTTLE_MAX_VALUE     (100UL)
+#define ESC_THROTTLE_HR_MAX_VALUE  (ACTUATOR_HR_MAX_VALUE)
+
+#define ESC_THROTTLE_PIN_NOT_USED  (ACTUATOR_PIN_NOT_USED)
+
+
+typedef enum
+{
+    ESC_PROTOCOL_PWM        = ACTUATOR_PROFILE_ESC_PWM,
+    ESC_PROTOCOL_ONESHOT125 = ACTUATOR_PROFILE_ESC_ONESHOT125,
+    ESC_PROTOCOL_MULTISHOT  = ACTUATOR_PROFILE_ESC_MULTISHOT,
+    ESC_PROTOCOL_DSHOT150   = ACTUATOR_PROFILE_ESC_DSHOT150,
+    ESC_PROTOCOL_DSHOT300   = ACTUATOR_PROFILE_ESC_DSHOT300,
+    ESC_PROTOCOL_DSHOT600   = ACTUATOR_PROFILE_ESC_DSHOT600
+} esc_protocol_t;
+
+
+// Structs of this type need to kept in the global portion (static) of RAM
+// (not const) because they are accessed by EasyDMA.
+typedef actuator_group_t esc_throttle_group_t;
+
+
+// The pwm_instance should be in the range [0, 2] on the nRF52832. The chX_pins
+// can be set to any GPIO or set to ESC_THROTTLE_PIN_NOT_USED if the channel is
+// not required. Only one group can be initialized per pwm_instance.
+// The group is started with actuator_groups_start.
+uint32_t esc_throttle_group_init(esc_throttle_group_t * p_group,
+                                     uint8_t pwm_instance_index,
+                                     esc_protocol_t protocol,
+                                     uint8_t ch0_pin,
+                                     uint8_t ch1_pin,
+                                     uint8_t ch2_pin,
+                                     uint8_t ch3_pin);
+
+
+// Returns NRF_ERROR_INVALID_PARAM if the given ch_index is not assigned to a
+// pin. The p_value variable will be scaled to the range
+// [ESC_THROTTLE_MIN_VALUE, ESC_THROTTLE_MAX_VALUE].
+uint32_t esc_throttle_value_get(esc_throttle_group_t * p_group,
+                                    uint8_t ch_index,
+                                    uint8_t * p_value);
+
+
+// Returns NRF_ERROR_INVALID_PARAM if the given ch_index is not assigned to a
+// pin. The value variable shouldbe be in the range
+// [ESC_THROTTLE_MIN_VALUE, ESC_THROTTLE_MAX_VALUE]. With DShot a value of
+// ESC_THROTTLE_MIN_VALUE sends the disarm command instead of a throttle.
+uint32_t esc_throttle_value_set(esc_throttle_group_t * p_group,
+                                    uint8_t ch_index,
+                                    uint8_t value);
+
+
+// Stages the value without outputting it. See actuator_value_stage and
+// actuator_commit.
+uint32_t esc_throttle_value_stage(esc_throttle_group_t * p_group,
+                                      uint8_t ch_index,
+                                      uint8_t value);
+
+
+// The same as esc_throttle_value_stage but the value is in the range
+// [ESC_THROTTLE_MIN_VALUE, ESC_THROTTLE_HR_MAX_VALUE].
+uint32_t esc_throttle_value_hr_stage(esc_throttle_group_t * p_group,
+                                         uint8_t ch_index,
+                                         uint16_t value);
+
+
+// Returns the 16-bit DShot frame (MSB first) for an 11-bit throttle value.
+uint16_t esc_dshot_frame_encode(uint16_t throttle, bool telemetry);
+
+#endif
@@ -0,0 +1,244 @@
+#include "stddef.h"
+#include "string.h"
+
+#include "app_timer.h"
+#include "app_util.h"
+#include "app_util_platform.h"
+#include "nrf_error.h"
+
+#include "joystick.h"
+#include "failsafe.h"
+
+
+#define NEUTRAL_THROTTLE_VALUE (JOYSTICK_MIN_VALUE)
+#define NEUTRAL_SURFACE_VALUE  ((JOYSTICK_MAX_VALUE - JOYSTICK_MIN_VALUE) / 2)
+
+#define FIELD_SIZE(f)          (sizeof(((rc_radio_data_t*)0)->f))
+
+
+STATIC_ASSERT(sizeof(failsafe_profile_t) <= RC_RADIO_AUX_DATA_LEN);
+
+
+static const rc_radio_data_t NEUTRAL_DATA = {
+    .throttle = NEUTRAL_THROTTLE_VALUE,
+    .pitch    = NEUTRAL_SURFACE_VALUE,
+    .roll     = NEUTRAL_SURFACE_VALUE,
+    .yaw      = NEUTRAL_SURFACE_VALUE
+};
+
+static const uint8_t CHANNEL_OFFSETS[FAILSAFE_CHANNEL_COUNT] = {
+    offsetof(rc_radio_data_t, throttle),
+    offsetof(rc_radio_data_t, pitch),
+    offsetof(rc_radio_data_t, roll),
+    offsetof(rc_radio_data_t, yaw)
+};
+
+static const uint8_t CHANNEL_SIZES[FAILSAFE_CHANNEL_COUNT] = {
+    FIELD_SIZE(throttle),
+    FIELD_SIZE(pitch),
+    FIELD_SIZE(roll),
+    FIELD_SIZE(yaw)
+};
+
+
+APP_TIMER_DEF(m_timer_id);
+
+static failsafe_handler_t m_handler;
+static failsafe_profile_t m_profile;
+static uint32_t           m_timeout_ticks;
+static rc_radio_data_t    m_last_data;
+
+static volatile uint32_t  m_last_rx_ticks;
+static volatile bool      m_timer_running=false;
+static volatile bool      m_engaged=false;
+
+
+static void m_engage(void)
+{
+    rc_radio_data_t data;
+    uint8_t         *p_dst;
+    const uint8_t   *p_src;
+    uint32_t        i;
+
+    CRITICAL_REGION_ENTER();
+    memcpy(&data, &m_last_data, sizeof(rc_radio_data_t));
+    m_engaged = true;
+    CRITICAL_REGION_EXIT();
+
+    for (i = 0; i < FAILSAFE_CHANNEL_COUNT; i++)
+    {
+        switch (m_profile.actions[i])
+        {
+        case FAILSAFE_ACTION_NEUTRAL:
+            p_src = ((const uint8_t*)&NEUTRAL_DATA) + CHANNEL_OFFSETS[i];
+            break;
+        case FAILSAFE_ACTION_PRESET:
+            p_src = ((const uint8_t*)&m_profile.preset) + CHANNEL_OFFSETS[i];
+            break;
+        case FAILSAFE_ACTION_HOLD:
+        default:
+            continue;
+        }
+
+        p_dst = ((uint8_t*)&data) + CHANNEL_OFFSETS[i];
+        memcpy(p_dst, p_src, CHANNEL_SIZES[i]);
+    }
+
+    // A frame may have arrived while the values were being prepared.
+    if (m_engaged)
+    {
+        m_handler(&data);
+    }
+}
+
+
+static void m_timeout_handler(void * p_context)
+{
+    uint32_t age;
+    bool     expired;
+
+    CRITICAL_REGION_ENTER();
+
+    age     = app_timer_cnt_diff_compute(app_timer_cnt_get(), m_last_rx_ticks);
+    expired = (m_timeout_ticks <= (age + APP_TIMER_MIN_TIMEOUT_TICKS));
+
+    if (expired)
+    {
+        m_timer_running = false;
+    }
+
+    CRITICAL_REGION_EXIT();
+
+    if (expired)
+    {
+        m_engage();
+    }
+    else
+    {
+        // Frames have been received since the timer was started so wait for
+        // the remainder of the hold period.
+        APP_ERROR_CHECK(app_timer_start(m_timer_id,
+                                            (m_timeout_ticks - age),
+                                            NULL));
+    }
+}
+
+
+uint32_t failsafe_init(failsafe_handler_t handler)
+{
+    uint32_t           i;
+    failsafe_profile_t profile;
+
+    if (NULL == handler)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    m_handler = handler;
+
+    memcpy(&m_last_data, &NEUTRAL_DATA, sizeof(rc_radio_data_t));
+
+    profile.timeout_ms = FAILSAFE_DEFAULT_TIMEOUT_MS;
+    for (i = 0; i < FAILSAFE_CHANNEL_COUNT; i++)
+    {
+        profile.actions[i] = FAILSAFE_ACTION_NEUTRAL;
+    }
+    memcpy(&profile.preset, &NEUTRAL_DATA, sizeof(rc_radio_data_t));
+
+    (void)failsafe_profile_set(&profile);
+
+    return app_timer_create(&m_timer_id,
+                                APP_TIMER_MODE_SINGLE_SHOT,
+                                m_timeout_handler);
+}
+
+
+void failsafe_data_received(const rc_radio_data_t * p_data)
+{
+    bool start;
+
+    CRITICAL_REGION_ENTER();
+
+    memcpy(&m_last_data, p_data, sizeof(rc_radio_data_t));
+    m_last_rx_ticks = app_timer_cnt_get();
+    m_engaged       = false;
+
+    // The timer is only started once per hold period instead of being
+    // restarted for every frame.
+    start           = !m_timer_running;
+    m_timer_running = true;
+
+    CRITICAL_REGION_EXIT();
+
+    if (start)
+    {
+        APP_ERROR_CHECK(app_timer_start(m_timer_id, m_timeout_ticks, NULL));
+    }
+}
+
+
+void failsafe_aux_received(const rc_radio_aux_data_t * p_aux_data)
+{
+    failsafe_profile_t profile;
+
+    if (FAILSAFE_AUX_TYPE != p_aux_data->type)
+    {
+        return;
+    }
+
+    memcpy(&profile, p_aux_data->data, sizeof(failsafe_profile_t));
+
+    (void)failsafe_profile_set(&profile);
+}
+
+
+void failsafe_trigger(void)
+{
+    if (!m_engaged)
+    {
+        m_engage();
+    }
+}
+
+
+uint32_t failsafe_profile_set(const failsafe_profile_t * p_profile)
+{
+    uint32_t i;
+
+    if ((FAILSAFE_MIN_TIMEOUT_MS > p_profile->timeout_ms) ||
+            (FAILSAFE_MAX_TIMEOUT_MS < p_profile->timeout_ms))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    for (i = 0; i < FAILSAFE_CHANNEL_COUNT; i++)
+    {
+        if (FAILSAFE_ACTION_COUNT <= p_profile->actions[i])
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+    }
+
+    CRITICAL_REGION_ENTER();
+    memcpy(&m_profile, p_profile, sizeof(failsafe_profile_t));
+    m_timeout_ticks = APP_TIMER_TICKS(p_profile->timeout_ms);
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+
+void failsafe_profile_encode(const failsafe_profile_t * p_profile,
+                                 rc_radio_aux_data_t * p_aux_data)
+{
+    memset(p_aux_data, 0, sizeof(rc_radio_aux_data_t));
+
+    p_aux_data->type = FAILSAFE_AUX_TYPE;
+    memcpy(p_aux_data->data, p_profile, sizeof(failsafe_profile_t));
+}
+
+
+bool failsafe_is_engaged(void)
+{
+    return m_engaged;
+}
@@ -0,0 +1,103 @@
+/**
+ * A time-based failsafe for the receiver. The last values are held for
+ * timeout_ms after the most recent frame was received and then each channel
+ * is driven according to its failsafe_action_t. Because the timeout is
+ * measured in milliseconds the reaction time does not depend on the
+ * transmit rate or the number of packets that were missed. The switches
+ * always keep their last received state.
+ *
+ * The transmitter can set the profile over the link by encoding it into a
+ * rc_radio_aux_data_t with failsafe_profile_encode and passing that to
+ * rc_radio_aux_data_set.
+ *
+ * NOTE: The app_timer module must be initialized (and the LFCLK started)
+ *       before failsafe_init is called.
+ */
+#ifndef FAILSAFE_H
+#define FAILSAFE_H
+
+#include "stdint.h"
+#include "stdbool.h"
+
+#include "rc_radio.h"
+
+
+#define FAILSAFE_AUX_TYPE            (0x01UL)
+#define FAILSAFE_DEFAULT_TIMEOUT_MS  (500UL)
+#define FAILSAFE_MIN_TIMEOUT_MS      (20UL)
+#define FAILSAFE_MAX_TIMEOUT_MS      (5000UL)
+
+
+typedef enum
+{
+    FAILSAFE_ACTION_HOLD,    // Keep the last received value.
+    FAILSAFE_ACTION_NEUTRAL, // Throttle to minimum, surfaces to center.
+    FAILSAFE_ACTION_PRESET,  // Use the value from the profile's preset.
+    FAILSAFE_ACTION_COUNT
+} failsafe_action_t;
+
+
+// The channels are in the same order as the fields in rc_radio_data_t.
+typedef enum
+{
+    FAILSAFE_CHANNEL_THROTTLE,
+    FAILSAFE_CHANNEL_PITCH,
+    FAILSAFE_CHANNEL_ROLL,
+    FAILSAFE_CHANNEL_YAW,
+    FAILSAFE_CHANNEL_COUNT
+} failsafe_channel_t;
+
+
+typedef struct
+{
+    uint16_t        timeout_ms;
+    uint8_t         actions[FAILSAFE_CHANNEL_COUNT]; // failsafe_action_t
+    rc_radio_data_t preset;
+} failsafe_profile_t;
+
+
+/**
+ * Delivers the values that should be applied to the outputs. The handler is
+ * called with the failsafe values when the failsafe engages.
+ */
+typedef void (*failsafe_handler_t)(const rc_radio_data_t * p_data);
+
+
+/**
+ * The handler can not be NULL. The default profile uses
+ * FAILSAFE_DEFAULT_TIMEOUT_MS and FAILSAFE_ACTION_NEUTRAL for every channel.
+ */
+uint32_t failsafe_init(failsafe_handler_t handler);
+
+/**
+ * Must be called for every RC_RADIO_EVENT_DATA_RECEIVED event. Disengages
+ * the failsafe and restarts the hold period.
+ */
+void failsafe_data_received(const rc_radio_data_t * p_data);
+
+/**
+ * Should be called for every RC_RADIO_EVENT_AUX_RECEIVED event. Aux payloads
+ * that are not of type FAILSAFE_AUX_TYPE are ignored.
+ */
+void failsafe_aux_received(const rc_radio_aux_data_t * p_aux_data);
+
+/**
+ * Engages the failsafe immediately (e.g. when the receiver starts binding).
+ */
+void failsafe_trigger(void);
+
+/**
+ * Returns NRF_ERROR_INVALID_PARAM if the timeout is outside of the range
+ * [FAILSAFE_MIN_TIMEOUT_MS, FAILSAFE_MAX_TIMEOUT_MS] or an action is invalid.
+ */
+uint32_t failsafe_profile_set(const failsafe_profile_t * p_profile);
+
+/**
+ * Used by the transmitter to prepare a profile for rc_radio_aux_data_set.
+ */
+void failsafe_profile_encode(const failsafe_profile_t * p_profile,
+                                 rc_radio_aux_data_t * p_aux_data);
+
+bool failsafe_is_engaged(void);
+
+#endif
@@ -1,59 +1,179 @@
-/**
- * A simple wrapper that uses a timer and the PPI to trigger ADC reads. The
- * values are scaled before the joystick_event_handler is called.
- * 
- * Sometimes wiring is easier if one of the joysticks is mounted upside down.
- * The INVERT_L_X_AXIS, INVERT_L_Y_AXIS, INVERT_R_X_AXIS, and/or
- * INVERT_R_Y_AXIS symbols can be set to 1 in the Makefile to correct for this.
- */
-#ifndef JOYSTICK_H
-#define JOYSTICK_H
-
-#include "stdint.h"
-
-#ifdef NRF52840_XXAA
-#include "nrf52840_bitfields.h"
-#else
-#include "nrf52_bitfields.h"
-#endif
-
-
-#define JOYSTICK_MIN_VALUE      (0UL)
-#define JOYSTICK_MAX_VALUE      (100UL)
-#define JOYSTICK_INVALID_VALUE  (0xFFUL)
-
-
-typedef enum
-{
-    JOYSTICK_PIN_0        = SAADC_CH_PSELP_PSELP_AnalogInput0, // P0.2
-    JOYSTICK_PIN_1        = SAADC_CH_PSELP_PSELP_AnalogInput1, // P0.3
-    JOYSTICK_PIN_2        = SAADC_CH_PSELP_PSELP_AnalogInput2, // P0.4
-    JOYSTICK_PIN_3        = SAADC_CH_PSELP_PSELP_AnalogInput3, // P0.5
-    JOYSTICK_PIN_4        = SAADC_CH_PSELP_PSELP_AnalogInput4, // P0.28
-    JOYSTICK_PIN_5        = SAADC_CH_PSELP_PSELP_AnalogInput5, // P0.29
-    JOYSTICK_PIN_6        = SAADC_CH_PSELP_PSELP_AnalogInput6, // P0.30
-    JOYSTICK_PIN_7        = SAADC_CH_PSELP_PSELP_AnalogInput7, // P0.31
-    JOYSTICK_PIN_NOT_USED = 0xFF,
-    JOYSTICK_PIN_AIN_COUNT
-} joystick_pin_t;
-
-
-typedef void (*joystick_event_handler_t)(uint8_t l_axis_x_value,
-	                                         uint8_t l_axis_y_value,
-	                                         uint8_t r_axis_x_value,
-	                                         uint8_t r_axis_y_value);
-
-
-/**
- * Inits a timer that triggers the SAADC at the given rate. The timer instance
- * is used to select a free timer peripheral (e.g. 0 is converted to TIMER0).
- */
-uint32_t joystick_init(uint8_t timer_instance_index,
-	                       uint8_t update_rate_hz,
-	                       joystick_event_handler_t joystick_event_handler,
-	                       joystick_pin_t l_x_axis_pin,
-	                       joystick_pin_t l_y_axis_pin,
-	                       joystick_pin_t r_x_axis_pin,
-	                       joystick_pin_t r_y_axis_pin);
-
-#endif
+/**
+ * A simple wrapper that uses a timer and the PPI to trigger ADC reads. The
+ * values are scaled before the joystick_event_handler is called.
+ *
+ * joystick_channels_init samples up to JOYSTICK_MAX_CHANNELS analog inputs
+ * (sticks, sliders, pots or a battery divider) that are described by a
+ * channel table. The SAADC scans every channel into one buffer with EasyDMA
+ * and the values are delivered as an array in the order of the table.
+ * joystick_init is a wrapper for the common case of two sticks.
+ *
+ * The values are scaled to [0, 100] by default. If RC_RADIO_HIGH_RES is set
+ * to 1 they are scaled to [0, 4095] instead so that none of the SAADC's 12
+ * bits of resolution are lost.
+ * 
+ * Each stick axis is scaled from a per-channel calibration (the raw SAADC
+ * readings at the axis' minimum, center and maximum) so that the center always
+ * maps to the middle of the range. Calibrations are recorded with
+ * joystick_calibration_start and joystick_calibration_stop and are kept in
+ * the last page of flash. The defaults suit the SainSmart sticks.
+ *
+ * Sometimes wiring is easier if one of the joysticks is mounted upside down.
+ * The INVERT_L_X_AXIS, INVERT_L_Y_AXIS, INVERT_R_X_AXIS, and/or
+ * INVERT_R_Y_AXIS symbols can be set to 1 in the Makefile to correct for this.
+ */
+#ifndef JOYSTICK_H
+#define JOYSTICK_H
+
+#include "stdint.h"
+#include "stdbool.h"
+
+#include "rc_radio.h"
+
+#ifdef NRF52840_XXAA
+#include "nrf52840_bitfields.h"
+#else
+#include "nrf52_bitfields.h"
+#endif
+
+
+#if RC_RADIO_HIGH_RES
+#define JOYSTICK_MIN_VALUE      (0UL)
+#define JOYSTICK_MAX_VALUE      (4095UL)
+#define JOYSTICK_INVALID_VALUE  (0xFFFFUL)
+
+typedef uint16_t joystick_value_t;
+#else
+#define JOYSTICK_MIN_VALUE      (0UL)
+#define JOYSTICK_MAX_VALUE      (100UL)
+#define JOYSTICK_INVALID_VALUE  (0xFFUL)
+
+typedef uint8_t joystick_value_t;
+#endif
+
+
+typedef enum
+{
+    JOYSTICK_PIN_0        = SAADC_CH_PSELP_PSELP_AnalogInput0, // P0.2
+    JOYSTICK_PIN_1        = SAADC_CH_PSELP_PSELP_AnalogInput1, // P0.3
+    JOYSTICK_PIN_2        = SAADC_CH_PSELP_PSELP_AnalogInput2, // P0.4
+    JOYSTICK_PIN_3        = SAADC_CH_PSELP_PSELP_AnalogInput3, // P0.5
+    JOYSTICK_PIN_4        = SAADC_CH_PSELP_PSELP_AnalogInput4, // P0.28
+    JOYSTICK_PIN_5        = SAADC_CH_PSELP_PSELP_AnalogInput5, // P0.29
+    JOYSTICK_PIN_6        = SAADC_CH_PSELP_PSELP_AnalogInput6, // P0.30
+    JOYSTICK_PIN_7        = SAADC_CH_PSELP_PSELP_AnalogInput7, // P0.31
+    JOYSTICK_PIN_NOT_USED = 0xFF,
+    JOYSTICK_PIN_AIN_COUNT
+} joystick_pin_t;
+
+
+#define JOYSTICK_MAX_CHANNELS   (8UL) // One per SAADC input
+
+
+// The axes in the order of the joystick_event_handler_t parameters.
+typedef enum
+{
+    JOYSTICK_AXIS_L_X,
+    JOYSTICK_AXIS_L_Y,
+    JOYSTICK_AXIS_R_X,
+    JOYSTICK_AXIS_R_Y,
+    JOYSTICK_AXIS_COUNT
+} joystick_axis_t;
+
+
+typedef enum
+{
+    JOYSTICK_CHANNEL_TYPE_STICK,  // Self-centering, has a deadband at its center
+    JOYSTICK_CHANNEL_TYPE_LINEAR, // Sliders and pots, calibrated ends only
+    JOYSTICK_CHANNEL_TYPE_RAW     // The full SAADC range, never calibrated
+} joystick_channel_type_t;
+
+
+typedef struct
+{
+    joystick_pin_t          pin;
+    joystick_channel_type_t type;
+    bool                    invert;
+} joystick_channel_config_t;
+
+
+// Raw SAADC readings.
+typedef struct
+{
+    uint16_t min;
+    uint16_t center;
+    uint16_t max;
+} joystick_axis_calibration_t;
+
+
+// p_values holds one value per entry of the channel table.
+typedef void (*joystick_channels_handler_t)(const joystick_value_t * p_values,
+                                                uint32_t count);
+
+
+typedef void (*joystick_event_handler_t)(joystick_value_t l_axis_x_value,
+	                                         joystick_value_t l_axis_y_value,
+	                                         joystick_value_t r_axis_x_value,
+	                                         joystick_value_t r_axis_y_value);
+
+
+/**
+ * Inits a timer that triggers the SAADC at the given rate. The timer instance
+ * is used to select a free timer peripheral (e.g. 0 is converted to TIMER0).
+ * The table is copied. Calibrations are stored by table index so the order of
+ * the table shouldn't change between firmware versions.
+ */
+uint32_t joystick_channels_init(uint8_t timer_instance_index,
+                                    uint8_t update_rate_hz,
+                                    joystick_channels_handler_t channels_handler,
+                                    const joystick_channel_config_t * p_channels,
+                                    uint32_t channel_count);
+
+/**
+ * Inits the sticks as channels of JOYSTICK_CHANNEL_TYPE_STICK. Axes that are
+ * set to JOYSTICK_PIN_NOT_USED are reported as JOYSTICK_INVALID_VALUE.
+ */
+uint32_t joystick_init(uint8_t timer_instance_index,
+	                       uint8_t update_rate_hz,
+	                       joystick_event_handler_t joystick_event_handler,
+	                       joystick_pin_t l_x_axis_pin,
+	                       joystick_pin_t l_y_axis_pin,
+	                       joystick_pin_t r_x_axis_pin,
+	                       joystick_pin_t r_y_axis_pin);
+
+/**
+ * Starts recording the extents of every channel. The event handler is not
+ * called until joystick_calibration_stop is called so the application should
+ * put its outputs into a safe state first. Each stick should then be moved
+ * through its full range of motion.
+ */
+uint32_t joystick_calibration_start(void);
+
+/**
+ * Stops recording and uses the current position of each stick axis as its
+ * center, so the sticks should be released first. Returns
+ * NRF_ERROR_INVALID_STATE if no calibration was started and
+ * NRF_ERROR_INVALID_DATA (keeping the previous calibration) if a channel
+ * didn't move far enough in both directions. If save is true the calibration is written to flash, which
+ * stalls the CPU for roughly 90 ms while the page is erased.
+ *
+ * NOTE: The stall also holds off every interrupt, including rc_radio's, so
+ *       it must not happen while the link is running. The transmitter stops
+ *       with save set to false and calls joystick_calibration_save from its
+ *       main loop while rc_radio is disabled.
+ */
+uint32_t joystick_calibration_stop(bool save);
+
+/**
+ * Writes the calibration in use to flash. Returns NRF_ERROR_INVALID_STATE if
+ * a calibration is being recorded. Stalls the CPU for roughly 90 ms (see
+ * joystick_calibration_stop).
+ */
+uint32_t joystick_calibration_save(void);
+
+/**
+ * Copies the calibration that is in use.
+ */
+void joystick_calibration_get(joystick_axis_calibration_t p_calibrations[JOYSTICK_MAX_CHANNELS]);
+
+#endif
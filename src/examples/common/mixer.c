@@ -0,0 +1,274 @@
+#include "string.h"
+
+#include "nrf.h"
+#include "app_util.h"
+#include "app_util_platform.h"
+#include "nrf_error.h"
+
+#include "joystick.h"
+#include "mixer.h"
+
+
+#define TABLE_BUFF_COUNT (2UL)
+
+#define Q15_MIN          (-MIXER_Q15_ONE)
+#define Q15_MAX          (MIXER_Q15_ONE)
+
+// (JOYSTICK_MAX_VALUE - JOYSTICK_MIN_VALUE) / 2 maps to MIXER_Q15_ONE.
+#define HALF_RANGE       ((int32_t)(JOYSTICK_MAX_VALUE - JOYSTICK_MIN_VALUE) / 2)
+#define CENTER           ((int32_t)JOYSTICK_MIN_VALUE + HALF_RANGE)
+#define INPUT_SCALE      (MIXER_Q15_ONE / HALF_RANGE)
+
+
+// The channel index is sent in front of the output.
+STATIC_ASSERT((sizeof(mixer_output_t) + 1) <= RC_RADIO_AUX_DATA_LEN);
+
+
+typedef struct
+{
+    mixer_output_t outputs[MIXER_CHANNEL_COUNT];
+} mixer_table_t;
+
+
+// The active table is swapped instead of being modified in place so that
+// mixer_apply never uses a partially updated output.
+static mixer_table_t m_tables[TABLE_BUFF_COUNT];
+static volatile uint8_t m_table_index;
+
+static int32_t m_prev_outputs[MIXER_CHANNEL_COUNT];
+static bool    m_have_prev=false;
+
+#if MIXER_CYCLE_STATS
+static uint32_t m_max_cycles;
+static uint32_t m_over_budget;
+#endif
+
+
+static inline int32_t m_saturate(int32_t value)
+{
+    if (Q15_MIN > value)
+    {
+        return Q15_MIN;
+    }
+    else if (Q15_MAX < value)
+    {
+        return Q15_MAX;
+    }
+
+    return value;
+}
+
+
+static inline int32_t m_to_q15(uint32_t value)
+{
+    return m_saturate(((int32_t)value - CENTER) * INPUT_SCALE);
+}
+
+
+static inline uint32_t m_from_q15(int32_t value)
+{
+    // Round to the nearest integer.
+    return (uint32_t)(CENTER + ((value * HALF_RANGE + (1L << 14)) >> 15));
+}
+
+
+static inline uint32_t m_pack(int32_t lo, int32_t hi)
+{
+    return (((uint32_t)hi << 16) | ((uint32_t)lo & 0xFFFF));
+}
+
+
+// Returns the weighted sum of the inputs in Q30.
+static inline int32_t m_weighted_sum(const mixer_output_t * p_output,
+                                         const uint32_t packed_inputs[2])
+{
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+    uint32_t packed_weights[2];
+
+    memcpy(packed_weights, p_output->weights, sizeof(packed_weights));
+
+    return (int32_t)__SMLAD(packed_weights[1],
+                                packed_inputs[1],
+                                __SMLAD(packed_weights[0], packed_inputs[0], 0));
+#else
+    int32_t  sum=0;
+    uint32_t i;
+
+    for (i = 0; i < MIXER_CHANNEL_COUNT; i++)
+    {
+        sum += ((int32_t)p_output->weights[i] *
+                    (int16_t)(packed_inputs[i / 2] >> (16 * (i % 2))));
+    }
+
+    return sum;
+#endif
+}
+
+
+void mixer_init(void)
+{
+    uint32_t i;
+
+    memset(&m_tables[0], 0, sizeof(mixer_table_t));
+    for (i = 0; i < MIXER_CHANNEL_COUNT; i++)
+    {
+        m_tables[0].outputs[i].weights[i] = MIXER_Q15_ONE;
+    }
+
+    m_table_index = 0;
+    m_have_prev   = false;
+
+#if MIXER_CYCLE_STATS
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+
+uint32_t mixer_output_set(mixer_channel_t channel,
+                              const mixer_output_t * p_output)
+{
+    uint32_t i;
+    int32_t  weight_sum=0;
+    uint8_t  next_index;
+
+    if ((MIXER_CHANNEL_COUNT <= channel) || (0 > p_output->expo))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    for (i = 0; i < MIXER_CHANNEL_COUNT; i++)
+    {
+        weight_sum += ((0 > p_output->weights[i]) ?
+                           -p_output->weights[i] : p_output->weights[i]);
+    }
+
+    if (MIXER_MAX_WEIGHT_SUM < weight_sum)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    CRITICAL_REGION_ENTER();
+
+    next_index = ((m_table_index + 1) % TABLE_BUFF_COUNT);
+    memcpy(&m_tables[next_index], &m_tables[m_table_index], sizeof(mixer_table_t));
+    memcpy(&m_tables[next_index].outputs[channel], p_output, sizeof(mixer_output_t));
+    m_table_index = next_index;
+
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+
+void mixer_apply(const rc_radio_data_t * p_in, rc_radio_data_t * p_out)
+{
+    const mixer_table_t *p_table;
+    uint32_t            packed_inputs[2];
+    int32_t             outputs[MIXER_CHANNEL_COUNT];
+    uint32_t            i;
+
+#if MIXER_CYCLE_STATS
+    uint32_t            start = DWT->CYCCNT;
+#endif
+
+    p_table = &m_tables[m_table_index];
+
+    packed_inputs[0] = m_pack(m_to_q15(p_in->throttle), m_to_q15(p_in->pitch));
+    packed_inputs[1] = m_pack(m_to_q15(p_in->roll), m_to_q15(p_in->yaw));
+
+    for (i = 0; i < MIXER_CHANNEL_COUNT; i++)
+    {
+        const mixer_output_t *p_output = &p_table->outputs[i];
+        int32_t              x;
+        int32_t              x3;
+
+        x = m_saturate(m_weighted_sum(p_output, packed_inputs) >> 15);
+
+        // y = x + expo * (x^3 - x)
+        if (0 != p_output->expo)
+        {
+            x3 = ((((x * x) >> 15) * x) >> 15);
+            x += ((p_output->expo * (x3 - x)) >> 15);
+        }
+
+        x = m_saturate(x + p_output->trim);
+
+        if (m_have_prev && (0 != p_output->rate_limit))
+        {
+            if ((m_prev_outputs[i] + p_output->rate_limit) < x)
+            {
+                x = (m_prev_outputs[i] + p_output->rate_limit);
+            }
+            else if ((m_prev_outputs[i] - p_output->rate_limit) > x)
+            {
+                x = (m_prev_outputs[i] - p_output->rate_limit);
+            }
+        }
+
+        outputs[i] = x;
+    }
+
+    memcpy(m_prev_outputs, outputs, sizeof(m_prev_outputs));
+    m_have_prev = true;
+
+    p_out->throttle = m_from_q15(outputs[MIXER_CHANNEL_THROTTLE]);
+    p_out->pitch    = m_from_q15(outputs[MIXER_CHANNEL_PITCH]);
+    p_out->roll     = m_from_q15(outputs[MIXER_CHANNEL_ROLL]);
+    p_out->yaw      = m_from_q15(outputs[MIXER_CHANNEL_YAW]);
+    p_out->switches = p_in->switches;
+
+#if MIXER_CYCLE_STATS
+    start = (DWT->CYCCNT - start);
+    if (m_max_cycles < start)
+    {
+        m_max_cycles = start;
+    }
+    if (MIXER_CYCLE_BUDGET < start)
+    {
+        m_over_budget++;
+    }
+#endif
+}
+
+
+void mixer_reset(void)
+{
+    m_have_prev = false;
+}
+
+
+#if MIXER_CYCLE_STATS
+void mixer_cycles_get(uint32_t * p_max_cycles, uint32_t * p_over_budget)
+{
+    *p_max_cycles  = m_max_cycles;
+    *p_over_budget = m_over_budget;
+}
+#endif
+
+
+void mixer_aux_received(const rc_radio_aux_data_t * p_aux_data)
+{
+    mixer_output_t output;
+
+    if (MIXER_AUX_TYPE != p_aux_data->type)
+    {
+        return;
+    }
+
+    memcpy(&output, &p_aux_data->data[1], sizeof(mixer_output_t));
+
+    (void)mixer_output_set((mixer_channel_t)p_aux_data->data[0], &output);
+}
+
+
+void mixer_output_encode(mixer_channel_t channel,
+                             const mixer_output_t * p_output,
+                             rc_radio_aux_data_t * p_aux_data)
+{
+    memset(p_aux_data, 0, sizeof(rc_radio_aux_data_t));
+
+    p_aux_data->type    = MIXER_AUX_TYPE;
+    p_aux_data->data[0] = channel;
+    memcpy(&p_aux_data->data[1], p_output, sizeof(mixer_output_t));
+}
@@ -0,0 +1,108 @@
+/**
+ * A table-driven mixer for the receiver. Each output is the weighted sum of
+ * the four rc_radio_data_t channels followed by expo, a trim and a rate
+ * limit. This covers elevons, V-tails and differential thrust without any
+ * changes to the receiver's mapping code because the mixed values are
+ * delivered as a rc_radio_data_t.
+ *
+ * All of the math is done in Q15 fixed point where every channel's
+ * [JOYSTICK_MIN_VALUE, JOYSTICK_MAX_VALUE] range (including throttle) is
+ * mapped to [-1, 1). The weights are packed in pairs so that the weighted
+ * sum can use the Cortex-M4's SMLAD instruction when it is available.
+ *
+ * The transmitter can change an output over the link by encoding it into a
+ * rc_radio_aux_data_t with mixer_output_encode and passing that to
+ * rc_radio_aux_data_set.
+ */
+#ifndef MIXER_H
+#define MIXER_H
+
+#include "stdint.h"
+
+#include "rc_radio.h"
+
+
+#define MIXER_AUX_TYPE      (0x02UL)
+
+#define MIXER_Q15_ONE       (32767L)
+
+// The sum of the absolute weights of an output is limited so that the
+// weighted sum can't overflow 32 bits.
+#define MIXER_MAX_WEIGHT_SUM (2 * MIXER_Q15_ONE)
+
+// When set, mixer_apply measures itself with the DWT cycle counter. The
+// budget is 20 us at 64 MHz, i.e. 1% of an update period at 500 Hz.
+#ifndef MIXER_CYCLE_STATS
+    #define MIXER_CYCLE_STATS  (0)
+#endif
+#define MIXER_CYCLE_BUDGET   (1280UL)
+
+
+// The inputs and outputs are in the same order as the fields in
+// rc_radio_data_t.
+typedef enum
+{
+    MIXER_CHANNEL_THROTTLE,
+    MIXER_CHANNEL_PITCH,
+    MIXER_CHANNEL_ROLL,
+    MIXER_CHANNEL_YAW,
+    MIXER_CHANNEL_COUNT
+} mixer_channel_t;
+
+
+typedef struct
+{
+    int16_t  weights[MIXER_CHANNEL_COUNT]; // Q15, indexed by input channel
+    int16_t  trim;                         // Q15, added after the expo
+    int16_t  expo;                         // Q15 in [0, 1), 0 is linear
+    uint16_t rate_limit;                   // Q15 change per update, 0 is off
+} mixer_output_t;
+
+
+/**
+ * Every output starts as a pass through of the input with the same index.
+ */
+void mixer_init(void);
+
+/**
+ * Returns NRF_ERROR_INVALID_PARAM if the channel is invalid, the expo is
+ * negative or the absolute weights sum to more than MIXER_MAX_WEIGHT_SUM.
+ */
+uint32_t mixer_output_set(mixer_channel_t channel,
+                              const mixer_output_t * p_output);
+
+/**
+ * Mixes p_in into p_out. Should be called once per output update because the
+ * rate limits are applied per call.
+ */
+void mixer_apply(const rc_radio_data_t * p_in, rc_radio_data_t * p_out);
+
+/**
+ * Forgets the previous outputs so that the next mixer_apply is not rate
+ * limited. Should be called before mixing the failsafe values so that they
+ * are applied at once instead of being ramped towards.
+ */
+void mixer_reset(void);
+
+#if MIXER_CYCLE_STATS
+/**
+ * Returns the most cycles that mixer_apply has taken and the number of calls
+ * that took more than MIXER_CYCLE_BUDGET.
+ */
+void mixer_cycles_get(uint32_t * p_max_cycles, uint32_t * p_over_budget);
+#endif
+
+/**
+ * Should be called for every RC_RADIO_EVENT_AUX_RECEIVED event. Aux payloads
+ * that are not of type MIXER_AUX_TYPE are ignored.
+ */
+void mixer_aux_received(const rc_radio_aux_data_t * p_aux_data);
+
+/**
+ * Used by the transmitter to prepare an output for rc_radio_aux_data_set.
+ */
+void mixer_output_encode(mixer_channel_t channel,
+                             const mixer_output_t * p_output,
+                             rc_radio_aux_data_t * p_aux_data);
+
+#endif
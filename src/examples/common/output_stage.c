@@ -0,0 +1,376 @@
+#include "string.h"
+
+#include "app_timer.h"
+#include "app_util_platform.h"
+#include "nrf_error.h"
+
+#include "joystick.h"
+#include "output_stage.h"
+
+
+#define CHANNEL_COUNT            (4UL)
+#define FRAC_BITS                (16UL)
+
+#define MIN_VALUE                ((int32_t)JOYSTICK_MIN_VALUE << FRAC_BITS)
+#define MAX_VALUE                ((int32_t)JOYSTICK_MAX_VALUE << FRAC_BITS)
+#define MAX_SLEW                 (((int32_t)OUTPUT_STAGE_RECOVERY_SLEW *             \
+                                      (int32_t)JOYSTICK_MAX_VALUE / 100) << FRAC_BITS)
+#define MAX_EXTRAPOLATION_TICKS  APP_TIMER_TICKS(OUTPUT_STAGE_MAX_EXTRAPOLATION_MS)
+
+
+typedef struct
+{
+    int32_t value;  // Newest received value
+    int32_t slope;  // Change per RTC tick (Q16)
+    int32_t output; // Most recently applied value (Q16)
+    int32_t offset; // What is left to slew out after a gap (Q16)
+} channel_t;
+
+
+APP_TIMER_DEF(m_timer_id);
+
+static output_stage_handler_t m_handler;
+static channel_t              m_channels[CHANNEL_COUNT];
+static uint8_t                m_switches; // Passed through as they are
+static uint32_t               m_frame_ticks;
+static uint32_t               m_frame_interval_ticks;
+static uint32_t               m_interval_ticks;  // Transmit interval, 0 until bound
+static uint32_t               m_keepalive_ticks; // Transmit interval, 0 unless a keepalive is used
+static bool                   m_have_frame=false;
+static bool                   m_holding=false;
+static bool                   m_recovering=false;
+
+
+static inline void m_unpack(const rc_radio_data_t * p_data,
+                                int32_t values[CHANNEL_COUNT])
+{
+    values[0] = p_data->throttle;
+    values[1] = p_data->pitch;
+    values[2] = p_data->roll;
+    values[3] = p_data->yaw;
+}
+
+
+static inline void m_pack(const int32_t values[CHANNEL_COUNT],
+                              rc_radio_data_t * p_data)
+{
+    // Round to the nearest integer.
+    p_data->throttle = ((values[0] + (1L << (FRAC_BITS - 1))) >> FRAC_BITS);
+    p_data->pitch    = ((values[1] + (1L << (FRAC_BITS - 1))) >> FRAC_BITS);
+    p_data->roll     = ((values[2] + (1L << (FRAC_BITS - 1))) >> FRAC_BITS);
+    p_data->yaw      = ((values[3] + (1L << (FRAC_BITS - 1))) >> FRAC_BITS);
+}
+
+
+static void m_update_handler(void * p_context)
+{
+    channel_t       channels[CHANNEL_COUNT];
+    int32_t         outputs[CHANNEL_COUNT];
+    rc_radio_data_t data;
+    uint8_t         switches;
+    uint32_t        frame_ticks;
+    uint32_t        interval;
+    uint32_t        max_age;
+    uint32_t        keepalive_ticks;
+    uint32_t        age;
+    uint32_t        i;
+    bool            holding;
+    bool            recovering;
+    bool            have_frame;
+    bool            slewing=false;
+
+    CRITICAL_REGION_ENTER();
+
+    frame_ticks     = m_frame_ticks;
+    interval        = ((0 != m_interval_ticks) ? m_interval_ticks :
+                                                 m_frame_interval_ticks);
+    keepalive_ticks = m_keepalive_ticks;
+    age             = app_timer_cnt_diff_compute(app_timer_cnt_get(), frame_ticks);
+    memcpy(channels, m_channels, sizeof(channels));
+    switches        = m_switches;
+    have_frame      = m_have_frame;
+    holding         = m_holding;
+    recovering      = m_recovering;
+
+    CRITICAL_REGION_EXIT();
+
+    if (!have_frame)
+    {
+        return;
+    }
+
+    // The newest frame is applied as it is while the frames are on time.
+    // Once the next one is late the outputs carry on along the slope from
+    // there, for up to one more interval. A frame that is later than that is
+    // a missed frame and the outputs are held where the prediction ended
+    // instead of carrying on towards the end of the range.
+    //
+    // With a keepalive the frame is late because the transmitter had nothing
+    // new to send so the last values are the right ones.
+    if ((0 == interval) || (0 != keepalive_ticks) || (interval >= age))
+    {
+        age = 0;
+    }
+    else
+    {
+        age -= interval;
+
+        max_age = interval;
+        if (MAX_EXTRAPOLATION_TICKS < max_age)
+        {
+            max_age = MAX_EXTRAPOLATION_TICKS;
+        }
+        if (max_age < age)
+        {
+            age = max_age;
+        }
+    }
+
+    for (i = 0; i < CHANNEL_COUNT; i++)
+    {
+        // A steep slope times the age doesn't fit in 32 bits so the target
+        // is clamped before it is narrowed.
+        int64_t target = ((int64_t)channels[i].value << FRAC_BITS);
+
+        if (!holding)
+        {
+            target += ((int64_t)channels[i].slope * age);
+        }
+
+        if (MIN_VALUE > target)
+        {
+            target = MIN_VALUE;
+        }
+        else if (MAX_VALUE < target)
+        {
+            target = MAX_VALUE;
+        }
+
+        if (recovering)
+        {
+            // The jump at the end of the gap is slewed out while the outputs
+            // follow the frames, so they don't lag behind a moving stick.
+            if (MAX_SLEW < channels[i].offset)
+            {
+                channels[i].offset -= MAX_SLEW;
+                slewing             = true;
+            }
+            else if (-MAX_SLEW > channels[i].offset)
+            {
+                channels[i].offset += MAX_SLEW;
+                slewing             = true;
+            }
+            else
+            {
+                channels[i].offset = 0;
+            }
+
+            target += channels[i].offset;
+
+            if (MIN_VALUE > target)
+            {
+                target = MIN_VALUE;
+            }
+            else if (MAX_VALUE < target)
+            {
+                target = MAX_VALUE;
+            }
+        }
+
+        outputs[i] = (int32_t)target;
+    }
+
+    CRITICAL_REGION_ENTER();
+    for (i = 0; i < CHANNEL_COUNT; i++)
+    {
+        m_channels[i].output = outputs[i];
+    }
+    // Recovery ends once every channel has caught up unless another frame
+    // arrived (and maybe started it again) in the meantime.
+    if (recovering && (frame_ticks == m_frame_ticks))
+    {
+        for (i = 0; i < CHANNEL_COUNT; i++)
+        {
+            m_channels[i].offset = channels[i].offset;
+        }
+        m_recovering = slewing;
+    }
+    CRITICAL_REGION_EXIT();
+
+    m_pack(outputs, &data);
+    data.switches = switches;
+    m_handler(&data);
+}
+
+
+uint32_t output_stage_init(uint32_t update_period_ms,
+                               output_stage_handler_t handler)
+{
+    uint32_t err_code;
+
+    if (NULL == handler)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    m_handler    = handler;
+    m_have_frame = false;
+    m_holding    = false;
+    m_recovering = false;
+
+    m_frame_interval_ticks = 0;
+    m_interval_ticks       = 0;
+    m_keepalive_ticks      = 0;
+
+    err_code = app_timer_create(&m_timer_id,
+                                    APP_TIMER_MODE_REPEATED,
+                                    m_update_handler);
+    if (NRF_SUCCESS != err_code)
+    {
+        return err_code;
+    }
+
+    return app_timer_start(m_timer_id, APP_TIMER_TICKS(update_period_ms), NULL);
+}
+
+
+void output_stage_frame_put(const rc_radio_data_t * p_data)
+{
+    int32_t  values[CHANNEL_COUNT];
+    uint32_t now;
+    uint32_t interval;
+    uint32_t nominal;
+    uint32_t i;
+    bool     gap = false;
+
+    m_unpack(p_data, values);
+    now = app_timer_cnt_get();
+
+    CRITICAL_REGION_ENTER();
+
+    interval = app_timer_cnt_diff_compute(now, m_frame_ticks);
+
+    if (!m_have_frame)
+    {
+        // Start from the first frame's values instead of slewing from zero.
+        for (i = 0; i < CHANNEL_COUNT; i++)
+        {
+            m_channels[i].value  = values[i];
+            m_channels[i].slope  = 0;
+            m_channels[i].output = (values[i] << FRAC_BITS);
+            m_channels[i].offset = 0;
+        }
+        interval = 0;
+    }
+    else if ((0 != m_keepalive_ticks) &&
+                 ((2 * interval) > (3 * m_keepalive_ticks)))
+    {
+        // The outputs have been held at the previous frame's values since
+        // the previous interval so they don't need to slew.
+        for (i = 0; i < CHANNEL_COUNT; i++)
+        {
+            m_channels[i].value = values[i];
+            m_channels[i].slope = 0;
+        }
+    }
+    else if (m_holding || (MAX_EXTRAPOLATION_TICKS < interval) || (0 == interval))
+    {
+        // The previous frame is too old to be used for a slope.
+        for (i = 0; i < CHANNEL_COUNT; i++)
+        {
+            m_channels[i].value = values[i];
+            m_channels[i].slope = 0;
+        }
+        gap = true;
+    }
+    else
+    {
+        // The slope is computed here (once per frame) so that the update
+        // handler doesn't need to divide.
+        for (i = 0; i < CHANNEL_COUNT; i++)
+        {
+            m_channels[i].slope = (((values[i] - m_channels[i].value) *
+                                       (1L << FRAC_BITS)) / (int32_t)interval);
+            m_channels[i].value = values[i];
+        }
+
+        // The prediction covers a single missed frame. A frame that arrives
+        // more than 2.5 intervals after the previous one means that the
+        // outputs have been held for a while and may be far from the real
+        // values. Slewing after every missed frame would lag behind the
+        // sticks by more than holding the last values does.
+        nominal = ((0 != m_interval_ticks) ? m_interval_ticks :
+                                             m_frame_interval_ticks);
+        if ((0 != nominal) && ((2 * interval) > (5 * nominal)))
+        {
+            gap = true;
+        }
+    }
+
+    if (gap)
+    {
+        for (i = 0; i < CHANNEL_COUNT; i++)
+        {
+            m_channels[i].offset = (m_channels[i].output - (values[i] << FRAC_BITS));
+        }
+        m_recovering = true;
+    }
+
+    // Only the interval of consecutive frames is used as the nominal one.
+    if (!m_recovering || (0 == m_frame_interval_ticks))
+    {
+        m_frame_interval_ticks = interval;
+    }
+
+    m_switches    = p_data->switches;
+    m_frame_ticks = now;
+    m_have_frame  = true;
+    m_holding     = false;
+
+    CRITICAL_REGION_EXIT();
+}
+
+
+void output_stage_bind_info_set(const rc_radio_bind_info_t * p_bind_info)
+{
+    uint32_t interval_ticks  = (APP_TIMER_TICKS(1000) / p_bind_info->transmit_rate_hz);
+    uint32_t keepalive_ticks = 0;
+
+    if (0 != p_bind_info->keepalive_interval)
+    {
+        keepalive_ticks = interval_ticks;
+    }
+
+    CRITICAL_REGION_ENTER();
+    m_interval_ticks  = interval_ticks;
+    m_keepalive_ticks = keepalive_ticks;
+    CRITICAL_REGION_EXIT();
+}
+
+
+void output_stage_hold(const rc_radio_data_t * p_data)
+{
+    int32_t  values[CHANNEL_COUNT];
+    uint32_t i;
+
+    m_unpack(p_data, values);
+
+    CRITICAL_REGION_ENTER();
+
+    for (i = 0; i < CHANNEL_COUNT; i++)
+    {
+        // The hold values are applied immediately.
+        m_channels[i].value  = values[i];
+        m_channels[i].slope  = 0;
+        m_channels[i].output = (values[i] << FRAC_BITS);
+        m_channels[i].offset = 0;
+    }
+
+    m_switches    = p_data->switches;
+    m_frame_ticks = app_timer_cnt_get();
+    m_have_frame  = true;
+    m_holding     = true;
+    m_recovering  = false;
+
+    CRITICAL_REGION_EXIT();
+}
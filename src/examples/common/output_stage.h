@@ -0,0 +1,64 @@
+/**
+ * Sits between the RC_RADIO_EVENT_DATA_RECEIVED event and the actuator
+ * drivers and updates the outputs at the PWM frame rate instead of the radio
+ * rate. Each frame is timestamped when it is received and applied as it is
+ * while the frames arrive on time. If a frame is late the outputs are
+ * linearly extrapolated from the last two frames, from the time it was due,
+ * for up to one frame interval (and never more than
+ * OUTPUT_STAGE_MAX_EXTRAPOLATION_MS) and are then held. When frames resume
+ * after a gap that is longer than the prediction covers (more than 2.5
+ * intervals, or after output_stage_hold) the outputs follow the new frames
+ * and the jump between the held and the new values is slewed out by at most
+ * OUTPUT_STAGE_RECOVERY_SLEW per update.
+ *
+ * When the transmitter uses a keepalive interval (see
+ * RC_RADIO_KEEPALIVE_INTERVAL) a late frame usually means that nothing has
+ * changed so the outputs are held at the last received values instead.
+ *
+ * NOTE: The app_timer module must be initialized (and the LFCLK started)
+ *       before output_stage_init is called.
+ */
+#ifndef OUTPUT_STAGE_H
+#define OUTPUT_STAGE_H
+
+#include "stdint.h"
+
+#include "rc_radio.h"
+
+
+#define OUTPUT_STAGE_MAX_EXTRAPOLATION_MS (100UL)
+#define OUTPUT_STAGE_RECOVERY_SLEW        (5UL) // Percent of the range per update
+
+
+/**
+ * Called once per update period with the values that should be applied to
+ * the outputs.
+ */
+typedef void (*output_stage_handler_t)(const rc_radio_data_t * p_data);
+
+
+/**
+ * The update_period_ms should match the PWM frame period of the actuators
+ * (e.g. 20 for 50 Hz servos). The handler can not be NULL.
+ */
+uint32_t output_stage_init(uint32_t update_period_ms,
+                               output_stage_handler_t handler);
+
+/**
+ * Timestamps a received frame and makes it the newest extrapolation point.
+ */
+void output_stage_frame_put(const rc_radio_data_t * p_data);
+
+/**
+ * Should be called with the bind info of every RC_RADIO_EVENT_BOUND event.
+ */
+void output_stage_bind_info_set(const rc_radio_bind_info_t * p_bind_info);
+
+/**
+ * Holds the outputs at the given values without extrapolation (e.g. when the
+ * failsafe engages). The outputs slew away from these values once frames
+ * are received again.
+ */
+void output_stage_hold(const rc_radio_data_t * p_data);
+
+#endif
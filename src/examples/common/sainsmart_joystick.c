@@ -1,344 +1,817 @@
-#include "nrf_saadc.h"
-#include "nrf_drv_saadc.h"
-#include "nrf_ppi.h"
-#include "nrf_drv_ppi.h"
-#include "nrf_drv_timer.h"
-
-#include "joystick.h"
-
-
-#ifndef INVERT_L_X_AXIS
-#define INVERT_L_X_AXIS 0
-#endif
-
-#ifndef INVERT_L_Y_AXIS
-#define INVERT_L_Y_AXIS 0
-#endif
-
-#ifndef INVERT_R_X_AXIS
-#define INVERT_R_X_AXIS 0
-#endif
-
-#ifndef INVERT_R_Y_AXIS
-#define INVERT_R_Y_AXIS 0
-#endif
-
-
-#define JOYSTICK_MAX_CHANNELS     (4UL)
-
-#define SAINSMART_MIN_VALUE        (0UL)
-#define SAINSMART_MAX_VALUE        (3120UL)
-#define SAINSMART_NEUTRAL_VALUE    (1620UL)
-
-
-// Simple function for mapping a value betwen [0, 100] to the
-// range [JOYSTICK_MIN_VALUE, JOYSTICK_MAX_VALUE].
-#define PAM(x) (((x) - SAINSMART_MIN_VALUE) * 100 / (SAINSMART_MAX_VALUE - SAINSMART_MIN_VALUE))
-
-
-static nrf_saadc_value_t        m_buffer_pool[2][JOYSTICK_MAX_CHANNELS];
-static nrf_ppi_channel_t        m_ppi_channel;
-static nrf_drv_timer_t          m_timer;
-static joystick_event_handler_t m_handler;
-static uint8_t                  m_enabled_channels;
-static bool                     m_l_x_enabled=false;
-static bool                     m_l_y_enabled=false;
-static bool                     m_r_x_enabled=false;
-static bool                     m_r_y_enabled=false;
-
-
-static void m_timer_handler(nrf_timer_event_t event_type, void * p_context)
-{
-    // Required but not used.
-}
-
-
-static uint32_t m_saadc_sampling_event_init(uint32_t sampling_interval_ms)
-{
-    ret_code_t err_code;
-    uint32_t   timer_compare_event_addr;
-    uint32_t   saadc_sample_task_addr;
-
-    err_code = nrf_drv_ppi_init();
-    if (NRF_SUCCESS != err_code)
-    {
-        return err_code;
-    }
-
-    nrf_drv_timer_config_t timer_cfg = NRF_DRV_TIMER_DEFAULT_CONFIG;
-    timer_cfg.bit_width              = NRF_TIMER_BIT_WIDTH_32;
-
-    err_code = nrf_drv_timer_init(&m_timer, &timer_cfg, m_timer_handler);
-    if (NRF_SUCCESS != err_code)
-    {
-        return err_code;
-    }
-
-    uint32_t ticks = nrf_drv_timer_ms_to_ticks(&m_timer, sampling_interval_ms);
-    nrf_drv_timer_extended_compare(&m_timer,
-                                   NRF_TIMER_CC_CHANNEL0,
-                                   ticks,
-                                   NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK,
-                                   false);
-    nrf_drv_timer_enable(&m_timer);
-
-    timer_compare_event_addr = nrf_drv_timer_compare_event_address_get(&m_timer,
-                                                                       NRF_TIMER_CC_CHANNEL0);
-    saadc_sample_task_addr   = nrf_drv_saadc_sample_task_get();
-
-    // Setup PPI channel so that timer compare event is triggering sample
-    // task in SAADC.
-    err_code = nrf_drv_ppi_channel_alloc(&m_ppi_channel);
-    if (NRF_SUCCESS != err_code)
-    {
-        return err_code;
-    }
-
-    err_code = nrf_drv_ppi_channel_assign(m_ppi_channel,
-                                          timer_compare_event_addr,
-                                          saadc_sample_task_addr);
-    return err_code;
-}
-
-
-static void m_saadc_callback(nrf_drv_saadc_evt_t const * p_event)
-{
-    if (p_event->type == NRF_DRV_SAADC_EVT_DONE)
-    {
-        ret_code_t err_code;
-        uint32_t   i = 0;
-        uint32_t   l_x, l_y, r_x, r_y;
-
-        err_code = nrf_drv_saadc_buffer_convert(p_event->data.done.p_buffer, m_enabled_channels);
-        APP_ERROR_CHECK(err_code);
-
-        if (m_l_x_enabled)
-        {
-            l_x = p_event->data.done.p_buffer[i];
-
-            if (l_x > SAINSMART_MAX_VALUE)
-            {
-                l_x = SAINSMART_MAX_VALUE;
-            }
-#if INVERT_L_X_AXIS
-            l_x = PAM(SAINSMART_MAX_VALUE - l_x);
-#else
-        	l_x = PAM(l_x);
-#endif
-        	i++;
-        }
-        else
-        {
-        	l_x = JOYSTICK_INVALID_VALUE;
-        }
-
-        if (m_l_y_enabled)
-        {
-            l_y = p_event->data.done.p_buffer[i];
-
-            if (l_y > SAINSMART_MAX_VALUE)
-            {
-                l_y = SAINSMART_MAX_VALUE;
-            }
-#if INVERT_L_Y_AXIS
-            l_y = PAM(SAINSMART_MAX_VALUE - l_y);
-#else
-            l_y = PAM(l_y);
-#endif
-        	i++;
-        }
-        else
-        {
-        	l_y = JOYSTICK_INVALID_VALUE;
-        }
-
-        if (m_r_x_enabled)
-        {
-            r_x = p_event->data.done.p_buffer[i];
-
-            if (r_x > SAINSMART_MAX_VALUE)
-            {
-                r_x = SAINSMART_MAX_VALUE;
-            }
-#if INVERT_R_X_AXIS
-            r_x = PAM(SAINSMART_MAX_VALUE - r_x);
-#else
-            r_x = PAM(r_x);
-#endif
-            i++;
-        }
-        else
-        {
-            r_x = JOYSTICK_INVALID_VALUE;
-        }
-
-        if (m_r_y_enabled)
-        {
-            r_y = p_event->data.done.p_buffer[i];
-
-            if (r_y > SAINSMART_MAX_VALUE)
-            {
-                r_y = SAINSMART_MAX_VALUE;
-            }
-#if INVERT_R_Y_AXIS
-            r_y = PAM(SAINSMART_MAX_VALUE - r_y);
-#else
-            r_y = PAM(r_y);
-#endif
-            i++;
-        }
-        else
-        {
-            r_y = JOYSTICK_INVALID_VALUE;
-        }
-
-        m_handler(l_x, l_y, r_x, r_y);
-    }
-}
-
-
-uint32_t joystick_init(uint8_t timer_instance_index,
-	                       uint8_t update_rate_hz,
-	                       joystick_event_handler_t joystick_event_handler,
-	                       joystick_pin_t l_x_axis_pin,
-	                       joystick_pin_t l_y_axis_pin,
-	                       joystick_pin_t r_x_axis_pin,
-	                       joystick_pin_t r_y_axis_pin)
-{
-    ret_code_t err_code;
-
-    if (NULL == joystick_event_handler)
-    {
-    	return NRF_ERROR_INVALID_PARAM;
-    }
-
-    m_handler = joystick_event_handler;
-
-    nrf_drv_saadc_config_t saadc_config = {
-        .resolution         = NRF_SAADC_RESOLUTION_12BIT,     \
-        .oversample         = NRF_SAADC_OVERSAMPLE_DISABLED,  \
-        .interrupt_priority = 7,                              \
-        .low_power_mode     = false                           \
-    };
-
-    err_code = nrf_drv_saadc_init(&saadc_config, m_saadc_callback);
-    if (NRF_SUCCESS != err_code)
-    {
-        return err_code;
-    }
-
-    m_enabled_channels = 0;
-
-    if (JOYSTICK_PIN_NOT_USED != l_x_axis_pin)
-    {
-    	nrf_saadc_channel_config_t channel_config =
-    	    NRF_DRV_SAADC_DEFAULT_CHANNEL_CONFIG_SE(l_x_axis_pin);
-
-   	    err_code = nrf_drv_saadc_channel_init(m_enabled_channels, &channel_config);
-        if (NRF_SUCCESS != err_code)
-        {
-            return err_code;
-        }
-   	    m_enabled_channels++;
-   	    m_l_x_enabled = true;
-    }
-
-    if (JOYSTICK_PIN_NOT_USED != l_y_axis_pin)
-    {
-    	nrf_saadc_channel_config_t channel_config =
-    	    NRF_DRV_SAADC_DEFAULT_CHANNEL_CONFIG_SE(l_y_axis_pin);
-
-   	    err_code = nrf_drv_saadc_channel_init(m_enabled_channels, &channel_config);
-   	    if (NRF_SUCCESS != err_code)
-        {
-            return err_code;
-        }
-   	    m_enabled_channels++;
-   	    m_l_y_enabled = true;
-    }
-
-    if (JOYSTICK_PIN_NOT_USED != r_x_axis_pin)
-    {
-    	nrf_saadc_channel_config_t channel_config =
-    	    NRF_DRV_SAADC_DEFAULT_CHANNEL_CONFIG_SE(r_x_axis_pin);
-
-   	    err_code = nrf_drv_saadc_channel_init(m_enabled_channels, &channel_config);
-   	    if (NRF_SUCCESS != err_code)
-        {
-            return err_code;
-        }
-   	    m_enabled_channels++;
-   	    m_r_x_enabled = true;
-    }
-
-    if (JOYSTICK_PIN_NOT_USED != r_y_axis_pin)
-    {
-    	nrf_saadc_channel_config_t channel_config =
-    	    NRF_DRV_SAADC_DEFAULT_CHANNEL_CONFIG_SE(r_y_axis_pin);
-
-   	    err_code = nrf_drv_saadc_channel_init(m_enabled_channels, &channel_config);
-   	    if (NRF_SUCCESS != err_code)
-        {
-            return err_code;
-        }
-   	    m_enabled_channels++;
-   	    m_r_y_enabled = true;
-    }
-
-    err_code = nrf_drv_saadc_buffer_convert(m_buffer_pool[0], m_enabled_channels);
-    if (NRF_SUCCESS != err_code)
-    {
-        return err_code;
-    }
-
-    err_code = nrf_drv_saadc_buffer_convert(m_buffer_pool[1], m_enabled_channels);
-    if (NRF_SUCCESS != err_code)
-    {
-        return err_code;
-    }
-
-	switch (timer_instance_index)
-    {
-    case 0:
-        m_timer.p_reg            = NRF_TIMER0;
-        m_timer.instance_id      = TIMER0_INSTANCE_INDEX;
-        m_timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(0);
-        break;
-    case 1:
-        m_timer.p_reg            = NRF_TIMER1;
-        m_timer.instance_id      = TIMER1_INSTANCE_INDEX;
-        m_timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(1);
-        break;
-    case 2:
-        m_timer.p_reg            = NRF_TIMER2;
-        m_timer.instance_id      = TIMER2_INSTANCE_INDEX;
-        m_timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(2);
-        break;
-    case 3:
-        m_timer.p_reg            = NRF_TIMER3;
-        m_timer.instance_id      = TIMER3_INSTANCE_INDEX;
-        m_timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(3);
-        break;
-    case 4:
-        m_timer.p_reg            = NRF_TIMER4;
-        m_timer.instance_id      = TIMER4_INSTANCE_INDEX;
-        m_timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(4);
-        break;
-    default:
-        return NRF_ERROR_INVALID_PARAM;
-    }
-
-    err_code = m_saadc_sampling_event_init(1000 / update_rate_hz);
-    if (NRF_SUCCESS != err_code)
-    {
-        return err_code;
-    }
-
-    err_code = nrf_drv_ppi_channel_enable(m_ppi_channel);
-    if (NRF_SUCCESS != err_code)
-    {
-        return err_code;
-    }
-
-    return NRF_SUCCESS;
-}
+#include "stddef.h"
+#include "string.h"
+
+#include "nrf.h"
+#include "nrf_nvmc.h"
+#include "nrf_saadc.h"
+#include "nrf_drv_saadc.h"
+#include "nrf_ppi.h"
+#include "nrf_drv_ppi.h"
+#include "nrf_drv_timer.h"
+#include "app_util.h"
+#include "app_util_platform.h"
+
+#include "joystick.h"
+
+
+#ifndef INVERT_L_X_AXIS
+#define INVERT_L_X_AXIS 0
+#endif
+
+#ifndef INVERT_L_Y_AXIS
+#define INVERT_L_Y_AXIS 0
+#endif
+
+#ifndef INVERT_R_X_AXIS
+#define INVERT_R_X_AXIS 0
+#endif
+
+#ifndef INVERT_R_Y_AXIS
+#define INVERT_R_Y_AXIS 0
+#endif
+
+// The SAADC averages this many conversions per sample in hardware. Burst mode
+// is used so that the averaging also works with several channels enabled.
+#ifndef JOYSTICK_OVERSAMPLE
+#define JOYSTICK_OVERSAMPLE NRF_SAADC_OVERSAMPLE_4X
+#endif
+
+// Set to 1 to pass each axis through a three sample median filter, which
+// removes single sample spikes at the cost of one sample of latency.
+#ifndef JOYSTICK_MEDIAN_FILTER
+#define JOYSTICK_MEDIAN_FILTER 0
+#endif
+
+// Each axis is low-pass filtered by y += (x - y) / 2^JOYSTICK_IIR_SHIFT. Zero
+// disables the filter. The step response takes roughly 2^JOYSTICK_IIR_SHIFT
+// samples to settle, which is 20 ms per sample at the transmitter's 50 Hz, so
+// the filter is off by default and the hardware oversampling does the
+// averaging. tools/host_check/joystick_check prints the noise against the
+// delay for each setting.
+#ifndef JOYSTICK_IIR_SHIFT
+#define JOYSTICK_IIR_SHIFT 0
+#endif
+
+// Raw readings within this many counts of an axis' calibrated center are
+// reported as neutral. The rest of the range is stretched so that the ends
+// are still reachable and the output has no step at the edge of the band.
+#ifndef JOYSTICK_DEADBAND
+#define JOYSTICK_DEADBAND 16
+#endif
+
+
+// The calibration is stored in the last page of flash by default. The linker
+// scripts leave that page out of the FLASH region.
+#ifndef JOYSTICK_CALIBRATION_PAGE_ADDR
+#define JOYSTICK_CALIBRATION_PAGE_ADDR (NRF_FICR->CODEPAGESIZE * (NRF_FICR->CODESIZE - 1))
+#endif
+
+
+// The default calibration.
+#define SAINSMART_MIN_VALUE        (0UL)
+#define SAINSMART_MAX_VALUE        (3120UL)
+#define SAINSMART_NEUTRAL_VALUE    (1620UL)
+
+#define SAADC_MAX_VALUE            (4095UL) // 12-bit resolution
+
+#define IIR_FRAC_BITS              (4UL)
+#define GAIN_FRAC_BITS             (16UL)
+
+// Each half of a calibrated axis has to be at least this many counts wide
+// outside of the deadband. This also keeps the gains from overflowing.
+#define CALIBRATION_MIN_SPAN       (256UL)
+#define CALIBRATION_MAGIC          (0x4A534332UL) // "JSC2"
+
+#define AXIS_CHANNEL_NOT_USED      (0xFFUL)
+
+#define OUTPUT_CENTER_VALUE        ((JOYSTICK_MIN_VALUE + JOYSTICK_MAX_VALUE) / 2)
+
+#if ((JOYSTICK_DEADBAND + CALIBRATION_MIN_SPAN) > (SAINSMART_MAX_VALUE - SAINSMART_NEUTRAL_VALUE)) || \
+    ((JOYSTICK_DEADBAND + CALIBRATION_MIN_SPAN) > (SAINSMART_NEUTRAL_VALUE - SAINSMART_MIN_VALUE))
+#error "JOYSTICK_DEADBAND is too large for the default calibration."
+#endif
+
+
+typedef struct
+{
+    bool     primed;
+#if JOYSTICK_MEDIAN_FILTER
+    uint16_t history[2];
+#endif
+#if JOYSTICK_IIR_SHIFT
+    uint32_t iir_state; // Q(IIR_FRAC_BITS)
+#endif
+} axis_filter_t;
+
+
+// Precomputed from an axis' calibration so that scaling a sample only needs a
+// multiplication and a shift.
+typedef struct
+{
+    uint16_t lo_edge; // Readings in [lo_edge, hi_edge] are neutral
+    uint16_t hi_edge;
+    uint32_t lo_gain; // Q(GAIN_FRAC_BITS) output counts per reading
+    uint32_t hi_gain;
+} axis_map_t;
+
+
+typedef struct
+{
+    uint16_t min;
+    uint16_t max;
+    uint16_t last;
+} axis_extents_t;
+
+
+// Stored in flash. The size is a multiple of the flash word size.
+typedef struct
+{
+    uint32_t                    magic;
+    joystick_axis_calibration_t channels[JOYSTICK_MAX_CHANNELS];
+    uint32_t                    checksum;
+} calibration_record_t;
+
+
+STATIC_ASSERT(0 == (sizeof(calibration_record_t) % sizeof(uint32_t)));
+
+
+static nrf_saadc_value_t           m_buffer_pool[2][JOYSTICK_MAX_CHANNELS];
+static joystick_channel_type_t     m_channel_types[JOYSTICK_MAX_CHANNELS];
+static uint8_t                     m_inverted_mask;
+static axis_filter_t               m_filters[JOYSTICK_MAX_CHANNELS];
+static axis_map_t                  m_maps[JOYSTICK_MAX_CHANNELS];
+static joystick_axis_calibration_t m_calibrations[JOYSTICK_MAX_CHANNELS];
+static axis_extents_t              m_extents[JOYSTICK_MAX_CHANNELS];
+static joystick_value_t            m_values[JOYSTICK_MAX_CHANNELS];
+static volatile bool               m_calibrating=false;
+static nrf_ppi_channel_t           m_ppi_channel;
+static nrf_drv_timer_t             m_timer;
+static joystick_channels_handler_t m_channels_handler;
+static uint8_t                     m_channel_count;
+
+// Used by joystick_init.
+static joystick_event_handler_t    m_axes_handler;
+static uint8_t                     m_axis_channels[JOYSTICK_AXIS_COUNT];
+
+
+static void m_timer_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    // Required but not used.
+}
+
+
+#if JOYSTICK_MEDIAN_FILTER
+static inline uint32_t m_median3(uint32_t a, uint32_t b, uint32_t c)
+{
+    if (a > b)
+    {
+        uint32_t tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    // Now a <= b, so the median is b unless c is smaller than b.
+    if (b > c)
+    {
+        b = ((a > c) ? a : c);
+    }
+
+    return b;
+}
+#endif
+
+
+// Runs the median and IIR filters on a raw sample. Only shifts and compares
+// are used so this adds a few dozen cycles per axis to the SAADC callback.
+static uint32_t m_axis_filter(axis_filter_t * p_filter, nrf_saadc_value_t sample)
+{
+    uint32_t value;
+
+    // Single-ended samples can be slightly negative near ground.
+    if (0 > sample)
+    {
+        sample = 0;
+    }
+    value = (uint32_t)sample;
+
+    if (!p_filter->primed)
+    {
+#if JOYSTICK_MEDIAN_FILTER
+        p_filter->history[0] = value;
+        p_filter->history[1] = value;
+#endif
+#if JOYSTICK_IIR_SHIFT
+        p_filter->iir_state = (value << IIR_FRAC_BITS);
+#endif
+        p_filter->primed = true;
+    }
+
+#if JOYSTICK_MEDIAN_FILTER
+    {
+        uint32_t median;
+
+        median = m_median3(p_filter->history[0], p_filter->history[1], value);
+
+        p_filter->history[0] = p_filter->history[1];
+        p_filter->history[1] = value;
+        value                = median;
+    }
+#endif
+
+#if JOYSTICK_IIR_SHIFT
+    p_filter->iir_state += ((int32_t)((value << IIR_FRAC_BITS) - p_filter->iir_state) >>
+                                JOYSTICK_IIR_SHIFT);
+    value = ((p_filter->iir_state + (1UL << (IIR_FRAC_BITS - 1))) >> IIR_FRAC_BITS);
+#endif
+
+    if (value > SAADC_MAX_VALUE)
+    {
+        value = SAADC_MAX_VALUE;
+    }
+
+    return value;
+}
+
+
+static inline nrf_saadc_burst_t m_burst_mode(void)
+{
+    return ((NRF_SAADC_OVERSAMPLE_DISABLED == JOYSTICK_OVERSAMPLE) ?
+                NRF_SAADC_BURST_DISABLED : NRF_SAADC_BURST_ENABLED);
+}
+
+
+// Applies the deadband and scales a filtered reading to
+// [JOYSTICK_MIN_VALUE, JOYSTICK_MAX_VALUE] with the center of the calibration
+// at OUTPUT_CENTER_VALUE.
+static uint32_t m_axis_map(const axis_map_t * p_map, uint32_t value)
+{
+    uint32_t delta;
+
+    if (p_map->hi_edge < value)
+    {
+        delta = (((value - p_map->hi_edge) * p_map->hi_gain +
+                     (1UL << (GAIN_FRAC_BITS - 1))) >> GAIN_FRAC_BITS);
+
+        return ((delta < (JOYSTICK_MAX_VALUE - OUTPUT_CENTER_VALUE)) ?
+                    (OUTPUT_CENTER_VALUE + delta) : JOYSTICK_MAX_VALUE);
+    }
+    else if (p_map->lo_edge > value)
+    {
+        delta = (((p_map->lo_edge - value) * p_map->lo_gain +
+                     (1UL << (GAIN_FRAC_BITS - 1))) >> GAIN_FRAC_BITS);
+
+        return ((delta < (OUTPUT_CENTER_VALUE - JOYSTICK_MIN_VALUE)) ?
+                    (OUTPUT_CENTER_VALUE - delta) : JOYSTICK_MIN_VALUE);
+    }
+
+    return OUTPUT_CENTER_VALUE;
+}
+
+
+static inline uint32_t m_deadband(joystick_channel_type_t type)
+{
+    return ((JOYSTICK_CHANNEL_TYPE_STICK == type) ? JOYSTICK_DEADBAND : 0);
+}
+
+
+static void m_default_calibration(joystick_channel_type_t type,
+                                      joystick_axis_calibration_t * p_calibration)
+{
+    switch (type)
+    {
+    case JOYSTICK_CHANNEL_TYPE_STICK:
+        p_calibration->min    = SAINSMART_MIN_VALUE;
+        p_calibration->center = SAINSMART_NEUTRAL_VALUE;
+        p_calibration->max    = SAINSMART_MAX_VALUE;
+        break;
+    case JOYSTICK_CHANNEL_TYPE_LINEAR:
+        p_calibration->min    = SAINSMART_MIN_VALUE;
+        p_calibration->center = ((SAINSMART_MIN_VALUE + SAINSMART_MAX_VALUE) / 2);
+        p_calibration->max    = SAINSMART_MAX_VALUE;
+        break;
+    default:
+        p_calibration->min    = 0;
+        p_calibration->center = ((SAADC_MAX_VALUE + 1) / 2);
+        p_calibration->max    = SAADC_MAX_VALUE;
+        break;
+    }
+}
+
+
+static bool m_calibration_is_valid(joystick_channel_type_t type,
+                                       const joystick_axis_calibration_t * p_calibration)
+{
+    uint32_t min_span = (m_deadband(type) + CALIBRATION_MIN_SPAN);
+
+    return ((p_calibration->max <= SAADC_MAX_VALUE) &&
+            (p_calibration->min < p_calibration->center) &&
+            (p_calibration->center < p_calibration->max) &&
+            ((uint32_t)(p_calibration->center - p_calibration->min) >= min_span) &&
+            ((uint32_t)(p_calibration->max - p_calibration->center) >= min_span));
+}
+
+
+// The divisions are only done when a calibration is applied. A linear channel
+// is a channel without a deadband whose center is halfway between its ends,
+// so both halves get the same gain.
+static void m_axis_map_init(axis_map_t * p_map,
+                                joystick_channel_type_t type,
+                                const joystick_axis_calibration_t * p_calibration)
+{
+    uint32_t lo_span;
+    uint32_t hi_span;
+
+    p_map->lo_edge = (p_calibration->center - m_deadband(type));
+    p_map->hi_edge = (p_calibration->center + m_deadband(type));
+
+    lo_span = (p_map->lo_edge - p_calibration->min);
+    hi_span = (p_calibration->max - p_map->hi_edge);
+
+    p_map->lo_gain = ((((OUTPUT_CENTER_VALUE - JOYSTICK_MIN_VALUE) << GAIN_FRAC_BITS) +
+                          (lo_span / 2)) / lo_span);
+    p_map->hi_gain = ((((JOYSTICK_MAX_VALUE - OUTPUT_CENTER_VALUE) << GAIN_FRAC_BITS) +
+                          (hi_span / 2)) / hi_span);
+}
+
+
+static void m_calibrations_apply(const joystick_axis_calibration_t p_calibrations[JOYSTICK_MAX_CHANNELS])
+{
+    axis_map_t maps[JOYSTICK_MAX_CHANNELS];
+    uint32_t   i;
+
+    for (i = 0; i < JOYSTICK_MAX_CHANNELS; i++)
+    {
+        m_axis_map_init(&maps[i], m_channel_types[i], &p_calibrations[i]);
+    }
+
+    CRITICAL_REGION_ENTER();
+    memcpy(m_calibrations, p_calibrations, sizeof(m_calibrations));
+    memcpy(m_maps, maps, sizeof(m_maps));
+    CRITICAL_REGION_EXIT();
+}
+
+
+static uint32_t m_record_checksum(const calibration_record_t * p_record)
+{
+    const uint32_t *p_words = (const uint32_t*)p_record;
+    uint32_t       sum      = 0;
+    uint32_t       i;
+
+    for (i = 0; i < ((offsetof(calibration_record_t, checksum)) / sizeof(uint32_t)); i++)
+    {
+        sum += p_words[i];
+    }
+
+    // An erased page reads as 0xFFFFFFFF so a sum of zero is never valid.
+    return ~sum;
+}
+
+
+// Falls back to the default calibration for any channel that has no valid
+// calibration in flash. Raw channels always use the default.
+static void m_calibrations_load(void)
+{
+    const calibration_record_t  *p_record;
+    joystick_axis_calibration_t calibrations[JOYSTICK_MAX_CHANNELS];
+    bool                        record_valid;
+    uint32_t                    i;
+
+    p_record     = (const calibration_record_t*)JOYSTICK_CALIBRATION_PAGE_ADDR;
+    record_valid = ((CALIBRATION_MAGIC == p_record->magic) &&
+                    (m_record_checksum(p_record) == p_record->checksum));
+
+    for (i = 0; i < JOYSTICK_MAX_CHANNELS; i++)
+    {
+        if (record_valid &&
+            (JOYSTICK_CHANNEL_TYPE_RAW != m_channel_types[i]) &&
+            m_calibration_is_valid(m_channel_types[i], &p_record->channels[i]))
+        {
+            calibrations[i] = p_record->channels[i];
+        }
+        else
+        {
+            m_default_calibration(m_channel_types[i], &calibrations[i]);
+        }
+    }
+
+    m_calibrations_apply(calibrations);
+}
+
+
+static void m_calibrations_save(void)
+{
+    calibration_record_t record;
+    uint32_t             page_addr;
+
+    memset(&record, 0, sizeof(record));
+
+    record.magic = CALIBRATION_MAGIC;
+    memcpy(record.channels, m_calibrations, sizeof(record.channels));
+    record.checksum = m_record_checksum(&record);
+
+    page_addr = JOYSTICK_CALIBRATION_PAGE_ADDR;
+
+    nrf_nvmc_page_erase(page_addr);
+    nrf_nvmc_write_words(page_addr,
+                         (const uint32_t*)&record,
+                         (sizeof(record) / sizeof(uint32_t)));
+}
+
+
+static void m_extents_update(axis_extents_t * p_extents, uint32_t value)
+{
+    if (p_extents->min > value)
+    {
+        p_extents->min = value;
+    }
+
+    if (p_extents->max < value)
+    {
+        p_extents->max = value;
+    }
+
+    p_extents->last = value;
+}
+
+
+static uint32_t m_saadc_sampling_event_init(uint32_t sampling_interval_ms)
+{
+    ret_code_t err_code;
+    uint32_t   timer_compare_event_addr;
+    uint32_t   saadc_sample_task_addr;
+
+    err_code = nrf_drv_ppi_init();
+    if (NRF_SUCCESS != err_code)
+    {
+        return err_code;
+    }
+
+    nrf_drv_timer_config_t timer_cfg = NRF_DRV_TIMER_DEFAULT_CONFIG;
+    timer_cfg.bit_width              = NRF_TIMER_BIT_WIDTH_32;
+
+    err_code = nrf_drv_timer_init(&m_timer, &timer_cfg, m_timer_handler);
+    if (NRF_SUCCESS != err_code)
+    {
+        return err_code;
+    }
+
+    uint32_t ticks = nrf_drv_timer_ms_to_ticks(&m_timer, sampling_interval_ms);
+    nrf_drv_timer_extended_compare(&m_timer,
+                                   NRF_TIMER_CC_CHANNEL0,
+                                   ticks,
+                                   NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK,
+                                   false);
+    nrf_drv_timer_enable(&m_timer);
+
+    timer_compare_event_addr = nrf_drv_timer_compare_event_address_get(&m_timer,
+                                                                       NRF_TIMER_CC_CHANNEL0);
+    saadc_sample_task_addr   = nrf_drv_saadc_sample_task_get();
+
+    // Setup PPI channel so that timer compare event is triggering sample
+    // task in SAADC.
+    err_code = nrf_drv_ppi_channel_alloc(&m_ppi_channel);
+    if (NRF_SUCCESS != err_code)
+    {
+        return err_code;
+    }
+
+    err_code = nrf_drv_ppi_channel_assign(m_ppi_channel,
+                                          timer_compare_event_addr,
+                                          saadc_sample_task_addr);
+    return err_code;
+}
+
+
+static void m_saadc_callback(nrf_drv_saadc_evt_t const * p_event)
+{
+    if (p_event->type == NRF_DRV_SAADC_EVT_DONE)
+    {
+        ret_code_t err_code;
+        uint32_t   value;
+        uint32_t   i;
+
+        err_code = nrf_drv_saadc_buffer_convert(p_event->data.done.p_buffer, m_channel_count);
+        APP_ERROR_CHECK(err_code);
+
+        for (i = 0; i < m_channel_count; i++)
+        {
+            value = m_axis_filter(&m_filters[i], p_event->data.done.p_buffer[i]);
+            m_extents_update(&m_extents[i], value);
+            value = m_axis_map(&m_maps[i], value);
+
+            if (m_inverted_mask & (1 << i))
+            {
+                value = (JOYSTICK_MAX_VALUE + JOYSTICK_MIN_VALUE - value);
+            }
+
+            m_values[i] = value;
+        }
+
+        if (!m_calibrating)
+        {
+            m_channels_handler(m_values, m_channel_count);
+        }
+    }
+}
+
+
+static void m_axes_handler_adapter(const joystick_value_t * p_values,
+                                       uint32_t count)
+{
+    joystick_value_t axes[JOYSTICK_AXIS_COUNT];
+    uint32_t         i;
+
+    for (i = 0; i < JOYSTICK_AXIS_COUNT; i++)
+    {
+        if (AXIS_CHANNEL_NOT_USED == m_axis_channels[i])
+        {
+            axes[i] = JOYSTICK_INVALID_VALUE;
+        }
+        else
+        {
+            axes[i] = p_values[m_axis_channels[i]];
+        }
+    }
+
+    m_axes_handler(axes[JOYSTICK_AXIS_L_X],
+                       axes[JOYSTICK_AXIS_L_Y],
+                       axes[JOYSTICK_AXIS_R_X],
+                       axes[JOYSTICK_AXIS_R_Y]);
+}
+
+
+uint32_t joystick_channels_init(uint8_t timer_instance_index,
+                                    uint8_t update_rate_hz,
+                                    joystick_channels_handler_t channels_handler,
+                                    const joystick_channel_config_t * p_channels,
+                                    uint32_t channel_count)
+{
+    ret_code_t err_code;
+    uint32_t   i;
+
+    if ((NULL == channels_handler) ||
+        (0 == channel_count) ||
+        (JOYSTICK_MAX_CHANNELS < channel_count))
+    {
+    	return NRF_ERROR_INVALID_PARAM;
+    }
+
+    for (i = 0; i < channel_count; i++)
+    {
+        if ((JOYSTICK_PIN_NOT_USED == p_channels[i].pin) ||
+            (JOYSTICK_CHANNEL_TYPE_RAW < p_channels[i].type))
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+    }
+
+    m_channels_handler = channels_handler;
+
+    nrf_drv_saadc_config_t saadc_config = {
+        .resolution         = NRF_SAADC_RESOLUTION_12BIT,     \
+        .oversample         = JOYSTICK_OVERSAMPLE,            \
+        .interrupt_priority = 7,                              \
+        .low_power_mode     = false                           \
+    };
+
+    err_code = nrf_drv_saadc_init(&saadc_config, m_saadc_callback);
+    if (NRF_SUCCESS != err_code)
+    {
+        return err_code;
+    }
+
+    memset(m_filters, 0, sizeof(m_filters));
+    m_calibrating   = false;
+    m_inverted_mask = 0;
+
+    // Unused entries are treated as raw channels so that they still get a
+    // valid calibration.
+    for (i = 0; i < JOYSTICK_MAX_CHANNELS; i++)
+    {
+        m_channel_types[i] = ((i < channel_count) ?
+                                  p_channels[i].type : JOYSTICK_CHANNEL_TYPE_RAW);
+    }
+    m_calibrations_load();
+
+    // The SAADC converts the channels in order of their index so the results
+    // land in the buffer in the order of the table.
+    for (i = 0; i < channel_count; i++)
+    {
+        nrf_saadc_channel_config_t channel_config =
+            NRF_DRV_SAADC_DEFAULT_CHANNEL_CONFIG_SE(p_channels[i].pin);
+        channel_config.burst = m_burst_mode();
+
+        err_code = nrf_drv_saadc_channel_init(i, &channel_config);
+        if (NRF_SUCCESS != err_code)
+        {
+            return err_code;
+        }
+
+        if (p_channels[i].invert)
+        {
+            m_inverted_mask |= (1 << i);
+        }
+    }
+    m_channel_count = channel_count;
+
+    err_code = nrf_drv_saadc_buffer_convert(m_buffer_pool[0], m_channel_count);
+    if (NRF_SUCCESS != err_code)
+    {
+        return err_code;
+    }
+
+    err_code = nrf_drv_saadc_buffer_convert(m_buffer_pool[1], m_channel_count);
+    if (NRF_SUCCESS != err_code)
+    {
+        return err_code;
+    }
+
+    switch (timer_instance_index)
+    {
+    case 0:
+        m_timer.p_reg            = NRF_TIMER0;
+        m_timer.instance_id      = TIMER0_INSTANCE_INDEX;
+        m_timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(0);
+        break;
+    case 1:
+        m_timer.p_reg            = NRF_TIMER1;
+        m_timer.instance_id      = TIMER1_INSTANCE_INDEX;
+        m_timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(1);
+        break;
+    case 2:
+        m_timer.p_reg            = NRF_TIMER2;
+        m_timer.instance_id      = TIMER2_INSTANCE_INDEX;
+        m_timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(2);
+        break;
+    case 3:
+        m_timer.p_reg            = NRF_TIMER3;
+        m_timer.instance_id      = TIMER3_INSTANCE_INDEX;
+        m_timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(3);
+        break;
+    case 4:
+        m_timer.p_reg            = NRF_TIMER4;
+        m_timer.instance_id      = TIMER4_INSTANCE_INDEX;
+        m_timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(4);
+        break;
+    default:
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    err_code = m_saadc_sampling_event_init(1000 / update_rate_hz);
+    if (NRF_SUCCESS != err_code)
+    {
+        return err_code;
+    }
+
+    err_code = nrf_drv_ppi_channel_enable(m_ppi_channel);
+    if (NRF_SUCCESS != err_code)
+    {
+        return err_code;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t joystick_init(uint8_t timer_instance_index,
+	                       uint8_t update_rate_hz,
+	                       joystick_event_handler_t joystick_event_handler,
+	                       joystick_pin_t l_x_axis_pin,
+	                       joystick_pin_t l_y_axis_pin,
+	                       joystick_pin_t r_x_axis_pin,
+	                       joystick_pin_t r_y_axis_pin)
+{
+    const joystick_pin_t pins[JOYSTICK_AXIS_COUNT] = {
+        l_x_axis_pin, l_y_axis_pin, r_x_axis_pin, r_y_axis_pin
+    };
+    const bool inverts[JOYSTICK_AXIS_COUNT] = {
+        INVERT_L_X_AXIS, INVERT_L_Y_AXIS, INVERT_R_X_AXIS, INVERT_R_Y_AXIS
+    };
+    joystick_channel_config_t channels[JOYSTICK_AXIS_COUNT];
+    uint32_t                  channel_count = 0;
+    uint32_t                  i;
+
+    if (NULL == joystick_event_handler)
+    {
+    	return NRF_ERROR_INVALID_PARAM;
+    }
+
+    m_axes_handler = joystick_event_handler;
+
+    for (i = 0; i < JOYSTICK_AXIS_COUNT; i++)
+    {
+        if (JOYSTICK_PIN_NOT_USED == pins[i])
+        {
+            m_axis_channels[i] = AXIS_CHANNEL_NOT_USED;
+            continue;
+        }
+
+        channels[channel_count].pin    = pins[i];
+        channels[channel_count].type   = JOYSTICK_CHANNEL_TYPE_STICK;
+        channels[channel_count].invert = inverts[i];
+        m_axis_channels[i]             = channel_count;
+        channel_count++;
+    }
+
+    return joystick_channels_init(timer_instance_index,
+                                      update_rate_hz,
+                                      m_axes_handler_adapter,
+                                      channels,
+                                      channel_count);
+}
+
+
+uint32_t joystick_calibration_start(void)
+{
+    uint32_t i;
+
+    if (m_calibrating)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    CRITICAL_REGION_ENTER();
+    for (i = 0; i < JOYSTICK_MAX_CHANNELS; i++)
+    {
+        m_extents[i].min  = SAADC_MAX_VALUE;
+        m_extents[i].max  = 0;
+        m_extents[i].last = 0;
+    }
+    m_calibrating = true;
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t joystick_calibration_stop(bool save)
+{
+    joystick_axis_calibration_t calibrations[JOYSTICK_MAX_CHANNELS];
+    uint32_t                    i;
+
+    if (!m_calibrating)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    CRITICAL_REGION_ENTER();
+    for (i = 0; i < JOYSTICK_MAX_CHANNELS; i++)
+    {
+        calibrations[i].min    = m_extents[i].min;
+        calibrations[i].center = m_extents[i].last;
+        calibrations[i].max    = m_extents[i].max;
+    }
+    m_calibrating = false;
+    CRITICAL_REGION_EXIT();
+
+    for (i = 0; i < JOYSTICK_MAX_CHANNELS; i++)
+    {
+        if ((m_channel_count <= i) ||
+            (JOYSTICK_CHANNEL_TYPE_RAW == m_channel_types[i]))
+        {
+            // Unused and raw channels keep whatever calibration they had.
+            calibrations[i] = m_calibrations[i];
+            continue;
+        }
+
+        if (JOYSTICK_CHANNEL_TYPE_LINEAR == m_channel_types[i])
+        {
+            calibrations[i].center = ((calibrations[i].min + calibrations[i].max) / 2);
+        }
+
+        if (!m_calibration_is_valid(m_channel_types[i], &calibrations[i]))
+        {
+            return NRF_ERROR_INVALID_DATA;
+        }
+    }
+
+    m_calibrations_apply(calibrations);
+
+    if (save)
+    {
+        m_calibrations_save();
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t joystick_calibration_save(void)
+{
+    if (m_calibrating)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    m_calibrations_save();
+
+    return NRF_SUCCESS;
+}
+
+
+void joystick_calibration_get(joystick_axis_calibration_t p_calibrations[JOYSTICK_MAX_CHANNELS])
+{
+    CRITICAL_REGION_ENTER();
+    memcpy(p_calibrations, m_calibrations, sizeof(m_calibrations));
+    CRITICAL_REGION_EXIT();
+}
@@ -0,0 +1,99 @@
+#include "string.h"
+
+#include "nrf.h"
+#include "nrf_gpio.h"
+#include "nrf_error.h"
+
+#include "switch_input.h"
+
+
+#define PORT_PIN_COUNT (32UL)
+
+
+static uint8_t  m_pins[SWITCH_INPUT_MAX_COUNT];
+static uint32_t m_pin_count;
+static uint32_t m_pin_mask;
+
+// Debounced state of every pin on the port (1 is closed) and the two bits of
+// each pin's counter.
+static uint32_t m_state;
+static uint32_t m_count_0;
+static uint32_t m_count_1;
+
+static uint8_t  m_switches;
+
+
+static uint8_t m_pack(uint32_t state)
+{
+    uint8_t  switches = 0;
+    uint32_t i;
+
+    for (i = 0; i < m_pin_count; i++)
+    {
+        if (state & (1UL << m_pins[i]))
+        {
+            switches |= (1 << i);
+        }
+    }
+
+    return switches;
+}
+
+
+uint32_t switch_input_init(const uint8_t * p_pins, uint32_t pin_count)
+{
+    uint32_t i;
+
+    if (SWITCH_INPUT_MAX_COUNT < pin_count)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    m_pin_mask = 0;
+
+    for (i = 0; i < pin_count; i++)
+    {
+        if (PORT_PIN_COUNT <= p_pins[i])
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+
+        nrf_gpio_cfg_input(p_pins[i], NRF_GPIO_PIN_PULLUP);
+        m_pin_mask |= (1UL << p_pins[i]);
+    }
+
+    memcpy(m_pins, p_pins, pin_count);
+    m_pin_count = pin_count;
+
+    // Every switch starts open with its counter at the top.
+    m_state    = 0;
+    m_count_0  = 0xFFFFFFFF;
+    m_count_1  = 0xFFFFFFFF;
+    m_switches = 0;
+
+    return NRF_SUCCESS;
+}
+
+
+uint8_t switch_input_sample(void)
+{
+    uint32_t changed;
+
+    // The pins are active-low.
+    changed = ((~nrf_gpio_port_in_read(NRF_P0) & m_pin_mask) ^ m_state);
+
+    // Each pin that differs from its debounced state counts down from three
+    // and toggles the state when its counter rolls over. Pins that match
+    // their state have their counter reset.
+    m_count_0 = ~(m_count_0 & changed);
+    m_count_1 = (m_count_0 ^ (m_count_1 & changed));
+    changed  &= (m_count_0 & m_count_1);
+    m_state  ^= changed;
+
+    if (0 != changed)
+    {
+        m_switches = m_pack(m_state);
+    }
+
+    return m_switches;
+}
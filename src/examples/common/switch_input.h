@@ -0,0 +1,38 @@
+/**
+ * Samples up to SWITCH_INPUT_MAX_COUNT switches or buttons and packs their
+ * debounced states into a bitfield for rc_radio_data_t's switches field.
+ *
+ * Every pin is read with a single read of the GPIO port's IN register and all
+ * of the pins are debounced at once with a two-bit vertical counter, so the
+ * cost of switch_input_sample doesn't depend on the number of switches. A
+ * switch changes state once it has read the same for
+ * SWITCH_INPUT_DEBOUNCE_SAMPLES consecutive samples. The bitfield is only
+ * rebuilt when a switch changes state.
+ *
+ * The switches are expected to be active-low (i.e. closed to ground) and the
+ * pins' pull-ups are enabled. Only pins on the first GPIO port can be used.
+ */
+#ifndef SWITCH_INPUT_H
+#define SWITCH_INPUT_H
+
+#include "stdint.h"
+
+
+#define SWITCH_INPUT_MAX_COUNT        (8UL) // Bits in rc_radio_data_t.switches
+#define SWITCH_INPUT_DEBOUNCE_SAMPLES (4UL)
+
+
+/**
+ * Bit i of the bitfield is set while the switch on p_pins[i] is closed.
+ * Returns NRF_ERROR_INVALID_PARAM if there are too many pins or a pin isn't on
+ * the first GPIO port.
+ */
+uint32_t switch_input_init(const uint8_t * p_pins, uint32_t pin_count);
+
+/**
+ * Should be called at a fixed rate (e.g. once per frame). Returns the
+ * debounced bitfield.
+ */
+uint8_t switch_input_sample(void);
+
+#endif
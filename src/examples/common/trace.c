@@ -0,0 +1,185 @@
+#include "stddef.h"
+
+#include "nrf.h"
+#include "nrf_error.h"
+#include "app_timer.h"
+#include "app_util.h"
+#include "SEGGER_RTT.h"
+
+#include "rc_radio_probe.h"
+#include "trace.h"
+
+
+#define RING_MASK      (TRACE_RING_SIZE - 1)
+#define RTT_BUFF_SIZE  (512UL)
+
+
+// The seq field is only used on the target. The rest of the record is sent to
+// the host as it is (little-endian, no padding).
+typedef struct
+{
+    volatile uint32_t seq; // Index of the write that filled the slot
+    uint32_t          timestamp;
+    uint16_t          id;
+    int16_t           args[TRACE_ARG_COUNT];
+} trace_record_t;
+
+#define RECORD_WIRE_OFFSET (offsetof(trace_record_t, timestamp))
+#define RECORD_WIRE_LEN    (sizeof(trace_record_t) - RECORD_WIRE_OFFSET)
+
+
+STATIC_ASSERT(0 == (TRACE_RING_SIZE & RING_MASK));
+STATIC_ASSERT(16 == RECORD_WIRE_LEN);
+
+
+static trace_record_t    m_ring[TRACE_RING_SIZE];
+static volatile uint32_t m_head;    // Next index to reserve
+static uint32_t          m_tail;    // Next index to send
+static volatile uint32_t m_dropped;
+static uint8_t           m_rtt_buff[RTT_BUFF_SIZE];
+
+
+static void m_dropped_add(uint32_t count)
+{
+    uint32_t dropped;
+
+    do
+    {
+        dropped = __LDREXW(&m_dropped);
+    } while (0 != __STREXW((dropped + count), &m_dropped));
+}
+
+
+uint32_t trace_init(void)
+{
+    uint32_t i;
+
+    // A slot holds the index from its previous lap until it is rewritten so
+    // that trace_process can tell when a reserved slot has been filled.
+    for (i = 0; i < TRACE_RING_SIZE; i++)
+    {
+        m_ring[i].seq = (i - TRACE_RING_SIZE);
+    }
+
+    m_head    = 0;
+    m_tail    = 0;
+    m_dropped = 0;
+
+    if (0 > SEGGER_RTT_ConfigUpBuffer(TRACE_RTT_CHANNEL,
+                                          "Trace",
+                                          m_rtt_buff,
+                                          sizeof(m_rtt_buff),
+                                          SEGGER_RTT_MODE_NO_BLOCK_SKIP))
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+void trace_write(trace_id_t id,
+                     int32_t arg0,
+                     int32_t arg1,
+                     int32_t arg2,
+                     int32_t arg3,
+                     int32_t arg4)
+{
+    trace_record_t * p_record;
+    uint32_t         index;
+
+    // Reserve the slot. Being preempted between the LDREX and the STREX makes
+    // the STREX fail so the loop only repeats when a higher priority
+    // interrupt has written a record in the meantime.
+    do
+    {
+        index = __LDREXW(&m_head);
+
+        if (TRACE_RING_SIZE <= (index - m_tail))
+        {
+            __CLREX();
+            m_dropped_add(1);
+            return;
+        }
+    } while (0 != __STREXW((index + 1), &m_head));
+
+    p_record = &m_ring[index & RING_MASK];
+
+    p_record->timestamp = app_timer_cnt_get();
+    p_record->id        = id;
+    p_record->args[0]   = (int16_t)arg0;
+    p_record->args[1]   = (int16_t)arg1;
+    p_record->args[2]   = (int16_t)arg2;
+    p_record->args[3]   = (int16_t)arg3;
+    p_record->args[4]   = (int16_t)arg4;
+
+    // The record has to be complete before it is marked as such.
+    __DMB();
+    p_record->seq = index;
+}
+
+
+bool trace_process(void)
+{
+    trace_record_t * p_record;
+    uint32_t         dropped;
+
+    while (m_tail != m_head)
+    {
+        p_record = &m_ring[m_tail & RING_MASK];
+
+        if (m_tail != p_record->seq)
+        {
+            // The writer that reserved the slot hasn't finished with it yet
+            // (only possible if this is called from an interrupt).
+            return true;
+        }
+
+        // RTT drops the record if its buffer is full, which it stays without
+        // a debugger attached. The record is counted and the slot is freed
+        // so that the main loop can still sleep.
+        if (0 == SEGGER_RTT_Write(TRACE_RTT_CHANNEL,
+                                      ((uint8_t*)p_record + RECORD_WIRE_OFFSET),
+                                      RECORD_WIRE_LEN))
+        {
+            m_dropped_add(1);
+        }
+
+        m_tail++;
+    }
+
+    if (0 != m_dropped)
+    {
+        trace_record_t record = {0};
+
+        do
+        {
+            dropped = __LDREXW(&m_dropped);
+        } while (0 != __STREXW(0, &m_dropped));
+
+        record.timestamp = app_timer_cnt_get();
+        record.id        = TRACE_ID_DROPPED;
+        record.args[0]   = (int16_t)((INT16_MAX < dropped) ? INT16_MAX : dropped);
+
+        // This follows the records that were sent before the drops started.
+        // The count is kept for the next call if RTT is full.
+        if (0 == SEGGER_RTT_Write(TRACE_RTT_CHANNEL,
+                                      ((uint8_t*)&record + RECORD_WIRE_OFFSET),
+                                      RECORD_WIRE_LEN))
+        {
+            m_dropped_add(dropped);
+        }
+    }
+
+    return false;
+}
+
+
+#if (RC_RADIO_PROBE_TRACE == RC_RADIO_PROBE)
+// rc_radio calls this for every probe when it is built with
+// -DRC_RADIO_PROBE=3 (RC_RADIO_PROBE_TRACE).
+void rc_radio_probe_hook(rc_radio_probe_t probe, uint16_t arg)
+{
+    TRACE(RADIO_PROBE, probe, arg);
+}
+#endif
@@ -0,0 +1,78 @@
+/**
+ * A binary trace for the hot paths (e.g. the joystick and radio handlers)
+ * where formatting a NRF_LOG_INFO string for every sample costs more than
+ * the work being logged.
+ *
+ * TRACE writes a fixed-size record (event id, app_timer timestamp and up to
+ * TRACE_ARG_COUNT arguments) to a ring buffer. A slot is reserved with a
+ * single LDREX/STREX pair so it can be called from any interrupt priority
+ * without disabling interrupts. Records are dropped (and counted) while the
+ * ring is full. trace_process is called from the main loop and copies the
+ * finished records to RTT up buffer TRACE_RTT_CHANNEL where they can be
+ * captured (e.g. with JLinkRTTLogger) and decoded with tools/trace_decode.py.
+ * Records that don't fit into the RTT buffer (e.g. because no debugger is
+ * reading it) are dropped and counted as well.
+ *
+ * The events are listed in trace_events.h. Building with -DTRACE_ENABLED=0
+ * removes every TRACE call.
+ */
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "stdint.h"
+#include "stdbool.h"
+
+
+#ifndef TRACE_ENABLED
+    #define TRACE_ENABLED (1)
+#endif
+
+#define TRACE_ARG_COUNT   (5UL)
+#define TRACE_RING_SIZE   (64UL) // Must be a power of two
+#define TRACE_RTT_CHANNEL (1UL)  // Channel 0 is used by NRF_LOG
+
+
+typedef enum
+{
+#define TRACE_EVENT_DEF(name, args) TRACE_ID_##name,
+#include "trace_events.h"
+#undef TRACE_EVENT_DEF
+    TRACE_ID_COUNT
+} trace_id_t;
+
+
+/**
+ * Configures the RTT up buffer. app_timer needs to be initialized before the
+ * first record is written because it provides the timestamps.
+ */
+uint32_t trace_init(void);
+
+/**
+ * Arguments are truncated to 16 bits. Use the TRACE macro instead of calling
+ * this directly so that unused arguments are zeroed and the calls are
+ * removed when TRACE_ENABLED is 0.
+ */
+void trace_write(trace_id_t id,
+                     int32_t arg0,
+                     int32_t arg1,
+                     int32_t arg2,
+                     int32_t arg3,
+                     int32_t arg4);
+
+/**
+ * Sends the finished records to the host. Returns true if a record is still
+ * being written by an interrupt, so the main loop only stays awake for that
+ * and not for a full RTT buffer.
+ */
+bool trace_process(void);
+
+
+#if TRACE_ENABLED
+    #define TRACE(...) TRACE_ARGS_(__VA_ARGS__, 0, 0, 0, 0, 0, 0)
+    #define TRACE_ARGS_(id, a0, a1, a2, a3, a4, ...) \
+        trace_write(TRACE_ID_##id, (a0), (a1), (a2), (a3), (a4))
+#else
+    #define TRACE(...)
+#endif
+
+#endif
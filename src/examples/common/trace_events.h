@@ -0,0 +1,16 @@
+/**
+ * The list of trace events. Each entry is the event's name and the names of
+ * its arguments (at most TRACE_ARG_COUNT). The ids are assigned in order so
+ * new events should be added to the end of the list.
+ *
+ * NOTE: tools/trace_decode.py parses this file to name the records so each
+ *       entry has to stay on a single line.
+ */
+TRACE_EVENT_DEF(DROPPED,          "count")
+TRACE_EVENT_DEF(TX_JOYSTICK_RAW,  "l_x l_y r_x r_y")
+TRACE_EVENT_DEF(TX_CHANNELS,      "yaw throttle roll pitch switches")
+TRACE_EVENT_DEF(TX_DATA_SENT,     "")
+TRACE_EVENT_DEF(RX_DATA_RECEIVED, "throttle pitch roll yaw switches")
+TRACE_EVENT_DEF(RX_CONTROLS,      "roll pitch yaw throttle switches")
+TRACE_EVENT_DEF(RX_PACKET_DROPPED, "")
+TRACE_EVENT_DEF(RADIO_PROBE,      "probe arg")
@@ -1,13 +1,32 @@
-#include "utility.h"
-
-
-inline uint32_t map(uint8_t value, uint32_t min, uint32_t max)
-{
-    return (value * (max - min) / 100 + min);
-}
-
-
-inline uint8_t pam(uint32_t value, uint32_t min, uint32_t max)
-{
-    return ((value - min) * 100 / (max - min));
-}
+#include "utility.h"
+
+#include "nrf_error.h"
+
+
+inline uint32_t map(uint8_t value, uint32_t min, uint32_t max)
+{
+    return (value * (max - min) / 100 + min);
+}
+
+
+inline uint8_t pam(uint32_t value, uint32_t min, uint32_t max)
+{
+    return ((value - min) * 100 / (max - min));
+}
+
+
+uint32_t scale_init(scale_t * p_scale, uint32_t min, uint32_t max)
+{
+    uint32_t range = (max - min);
+
+    if ((2 > range) || (SCALE_MAX_RANGE < range))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    p_scale->min        = min;
+    p_scale->range      = range;
+    p_scale->reciprocal = SCALE_RECIPROCAL(range);
+
+    return NRF_SUCCESS;
+}
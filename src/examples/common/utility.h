@@ -1,18 +1,81 @@
-#ifndef UTILITY_H
-#define UTILITY_H
-
-#include "stdint.h"
-
-
-/**
- * Maps a value from the range [0, 100] to [min, max].
- */
-uint32_t map(uint8_t value, uint32_t min, uint32_t max);
-
-/**
- * Maps a value from the range [min, max] to [0, 100].
- */
-uint8_t pam(uint32_t value, uint32_t min, uint32_t max);
-
-
-#endif
+#ifndef UTILITY_H
+#define UTILITY_H
+
+#include "stdint.h"
+
+
+// The largest range that scale_pam is exact for (see scale_t).
+#define SCALE_MAX_RANGE          (6553UL)
+
+// ceil(2^32 / range)
+#define SCALE_RECIPROCAL(range)  ((uint32_t)(((1ULL << 32) + (range) - 1) / (range)))
+
+// Evaluates to the range, or fails to build (with a negative array size) if
+// it is outside of [2, SCALE_MAX_RANGE].
+#define SCALE_RANGE_CHECK(range)                                \
+    ((range) + 0 * sizeof(char[((2 <= (range)) &&               \
+                                (SCALE_MAX_RANGE >= (range))) ? 1 : -1]))
+
+// Initializes a scale_t at compile time. The range (max - min) must be in
+// [2, SCALE_MAX_RANGE].
+#define SCALE_INIT(min_value, max_value)                        \
+{                                                               \
+    .min        = (min_value),                                  \
+    .range      = SCALE_RANGE_CHECK((max_value) - (min_value)), \
+    .reciprocal = SCALE_RECIPROCAL((max_value) - (min_value))   \
+}
+
+
+/**
+ * A precomputed [min, max] range for scale_map and scale_pam. The division
+ * in pam is replaced by a multiplication with the rounded up reciprocal of
+ * the range and a 32-bit shift. For a numerator n <= 100 * range the result
+ * is exact as long as 100 * range^2 < 2^32, which is what limits the range
+ * to SCALE_MAX_RANGE.
+ */
+typedef struct
+{
+    uint32_t min;
+    uint32_t range;
+    uint32_t reciprocal;
+} scale_t;
+
+
+/**
+ * Maps a value from the range [0, 100] to [min, max].
+ */
+uint32_t map(uint8_t value, uint32_t min, uint32_t max);
+
+/**
+ * Maps a value from the range [min, max] to [0, 100].
+ */
+uint8_t pam(uint32_t value, uint32_t min, uint32_t max);
+
+/**
+ * Returns NRF_ERROR_INVALID_PARAM if max - min is outside of the range
+ * [2, SCALE_MAX_RANGE].
+ */
+uint32_t scale_init(scale_t * p_scale, uint32_t min, uint32_t max);
+
+/**
+ * Same result as map(value, min, max). The division by 100 is a constant so
+ * the compiler already replaces it with a multiplication.
+ */
+static inline uint32_t scale_map(const scale_t * p_scale, uint8_t value)
+{
+    return (value * p_scale->range / 100 + p_scale->min);
+}
+
+/**
+ * Same result as pam(value, min, max) for a value in [min, max] but without
+ * a division.
+ */
+static inline uint8_t scale_pam(const scale_t * p_scale, uint32_t value)
+{
+    uint32_t numerator = ((value - p_scale->min) * 100);
+
+    return (uint8_t)(((uint64_t)numerator * p_scale->reciprocal) >> 32);
+}
+
+
+#endif
@@ -1,357 +1,627 @@
-#include <stdbool.h>
-#include <stdint.h>
-#include "sdk_common.h"
-#include "nrf.h"
-#include "nrf_esb_error_codes.h"
-#include "nrf_delay.h"
-#include "nrf_gpio.h"
-#include "nrf_error.h"
-#include "boards.h"
-
-#define NRF_LOG_MODULE_NAME "APP"
-#include "nrf_log.h"
-#include "nrf_log_ctrl.h"
-
-#include "joystick.h"
-#include "servo.h"
-#include "rc_radio.h"
-#include "utility.h"
-
-
-#define RADIO_TIMER_INSTANCE    (0UL)
-#define SERVO_PWM_INSTANCE      (0UL)
-#define THROTTLE_PWM_INSTANCE   (1UL)
-
-#define BOUND_LED_PIN           (7UL)
-
-#define YAW_SERVO_PIN           (31UL)
-#define ROLL_SERVO_PIN          (30UL)
-#define PITCH_SERVO_PIN         (29UL)
-#define THROTTLE_PIN            (28UL)
-
-#define YAW_SERVO_CHAN          (0UL)
-#define ROLL_SERVO_CHAN         (1UL)
-#define PITCH_SERVO_CHAN        (2UL)
-
-#define THROTTLE_CHAN           (0UL)
-
-// Don't allow the servos to swing further than MAX_SERVO_DELTA
-// in either direction from SERVO_NEUTRAL_VALUE.
-#define MAX_SERVO_DELTA         (15UL)
-
-
-#ifndef INVERT_ROLL
-#define INVERT_ROLL 0
-#endif
-
-#ifndef INVERT_YAW
-#define INVERT_YAW 0
-#endif
-
-#ifndef INVERT_PITCH
-#define INVERT_PITCH 0
-#endif
-
-#ifndef BDCM
-#define BDCM 0
-#endif
-
-#ifndef ESC
-#define ESC 0
-#endif
-
-#if (0 == BDCM)
-  #if (0 == ESC)
-    #error Either BDCM or ESC needs to be specified.
-  #endif
-#endif
-
-#if BDCM
-  #if ESC
-    #error Either BDCM or ESC needs to be specified but not both.
-  #endif
-#endif
-
-#if BDCM
-#include "brushed_dc_motor.h"
-#else
-#include "electronic_speed_controller.h"
-#endif
-
-
-static servo_group_t m_servo_group;
-
-#if BDCM
-static brushed_dc_motor_group_t m_brushed_dc_motor_group;
-#else
-static esc_throttle_group_t     m_esc_group;
-#endif
-
-
-static void m_controls_reset(void)
-{
-    uint32_t err_code;
-
-    err_code = servo_value_set(&m_servo_group,
-                                   ROLL_SERVO_CHAN,
-                                   SERVO_NEUTRAL_VALUE);
-    APP_ERROR_CHECK(err_code);
-
-    err_code = servo_value_set(&m_servo_group,
-                                   PITCH_SERVO_CHAN,
-                                   SERVO_NEUTRAL_VALUE);
-    APP_ERROR_CHECK(err_code);
-
-    err_code = servo_value_set(&m_servo_group,
-                                   YAW_SERVO_CHAN,
-                                   SERVO_NEUTRAL_VALUE);
-    APP_ERROR_CHECK(err_code);
-
-#if BDCM
-    err_code = brushed_dc_motor_value_set(&m_brushed_dc_motor_group,
-                                              THROTTLE_CHAN,
-                                              BRUSHED_DC_MOTOR_MIN_VALUE);
-    APP_ERROR_CHECK(err_code);
-#else
-    err_code = esc_throttle_value_set(&m_esc_group,
-                                              THROTTLE_CHAN,
-                                              ESC_THROTTLE_MIN_VALUE);
-    APP_ERROR_CHECK(err_code);
-#endif
-
-    NRF_LOG_INFO("Controls reset.\r\n");
-}
-
-
-static void m_roll_set(uint8_t raw_roll)
-{
-    uint32_t err_code;
-    uint8_t  roll;
-
-#if INVERT_ROLL
-    raw_roll = (JOYSTICK_MAX_VALUE - raw_roll);
-#endif
-
-    if (SERVO_NEUTRAL_VALUE < raw_roll)
-    {
-        roll = pam(raw_roll, SERVO_NEUTRAL_VALUE, SERVO_MAX_VALUE);
-        roll = map(roll,
-                         SERVO_NEUTRAL_VALUE,
-                         (SERVO_NEUTRAL_VALUE + MAX_SERVO_DELTA));
-    }
-    else
-    {
-        roll = pam(raw_roll, SERVO_MIN_VALUE, SERVO_NEUTRAL_VALUE);
-        roll = map(roll,
-                         (SERVO_NEUTRAL_VALUE - MAX_SERVO_DELTA),
-                         SERVO_NEUTRAL_VALUE);
-    }
-
-    err_code = servo_value_set(&m_servo_group,
-                                   ROLL_SERVO_CHAN,
-                                   roll);
-    APP_ERROR_CHECK(err_code);
-
-    NRF_LOG_INFO("  Roll: (%d) -> (%d)\r\n",  raw_roll, roll);
-}
-
-
-static void m_pitch_set(uint8_t raw_pitch)
-{
-    uint32_t err_code;
-    uint8_t  pitch;
-
-#if INVERT_PITCH
-    raw_pitch = (JOYSTICK_MAX_VALUE - raw_pitch);
-#endif
-
-    if (SERVO_NEUTRAL_VALUE < raw_pitch)
-    {
-        pitch = pam(raw_pitch, SERVO_NEUTRAL_VALUE, SERVO_MAX_VALUE);
-        pitch = map(pitch,
-                         SERVO_NEUTRAL_VALUE,
-                         (SERVO_NEUTRAL_VALUE + MAX_SERVO_DELTA));
-    }
-    else
-    {
-        pitch = pam(raw_pitch, SERVO_MIN_VALUE, SERVO_NEUTRAL_VALUE);
-        pitch = map(pitch,
-                         (SERVO_NEUTRAL_VALUE - MAX_SERVO_DELTA),
-                         SERVO_NEUTRAL_VALUE);
-    }
-
-    err_code = servo_value_set(&m_servo_group,
-                                   PITCH_SERVO_CHAN,
-                                   pitch);
-    APP_ERROR_CHECK(err_code);
-
-    NRF_LOG_INFO("  Pitch: (%d) -> (%d)\r\n",  raw_pitch, pitch);
-}
-
-
-static void m_yaw_set(uint8_t raw_yaw)
-{
-    uint32_t err_code;
-    uint8_t  yaw;
-
-#if INVERT_YAW
-    raw_yaw = (JOYSTICK_MAX_VALUE - raw_yaw);
-#endif
-
-    if (SERVO_NEUTRAL_VALUE < raw_yaw)
-    {
-        yaw = pam(raw_yaw, SERVO_NEUTRAL_VALUE, SERVO_MAX_VALUE);
-        yaw = map(yaw,
-                     SERVO_NEUTRAL_VALUE,
-                     (SERVO_NEUTRAL_VALUE + MAX_SERVO_DELTA));
-    }
-    else
-    {
-        yaw = pam(raw_yaw, SERVO_MIN_VALUE, SERVO_NEUTRAL_VALUE);
-        yaw = map(yaw,
-                     (SERVO_NEUTRAL_VALUE - MAX_SERVO_DELTA),
-                     SERVO_NEUTRAL_VALUE);
-    }
-
-    err_code = servo_value_set(&m_servo_group,
-                                   YAW_SERVO_CHAN,
-                                   yaw);
-    APP_ERROR_CHECK(err_code);
-
-    NRF_LOG_INFO("  Yaw: (%d) -> (%d)\r\n",  raw_yaw, yaw);
-}
-
-
-static void m_throttle_set(uint8_t raw_throttle)
-{
-    uint32_t err_code;
-    uint8_t  throttle;
-
-#if BDCM
-    throttle = map(raw_throttle,
-                       BRUSHED_DC_MOTOR_MIN_VALUE,
-                       BRUSHED_DC_MOTOR_MAX_VALUE);
-
-    err_code = brushed_dc_motor_value_set(&m_brushed_dc_motor_group,
-                                              THROTTLE_CHAN,
-                                              throttle);
-    APP_ERROR_CHECK(err_code);
-#else
-    throttle = map(raw_throttle,
-                       ESC_THROTTLE_MIN_VALUE,
-                       ESC_THROTTLE_MAX_VALUE);
-
-    err_code = esc_throttle_value_set(&m_esc_group,
-                                          THROTTLE_CHAN,
-                                          throttle);
-    APP_ERROR_CHECK(err_code);
-#endif
-
-    NRF_LOG_INFO("  Throttle: (%d) -> (%d)\r\n",  raw_throttle, throttle);
-}
-
-
-static void m_rc_radio_handler(rc_radio_event_t event, const void * const p_context)
-{
-    switch (event)
-    {
-    case RC_RADIO_EVENT_BINDING:
-        // Reset all of the control values so the plane doesn't keep flying
-        // if the transmitter drops.
-        m_controls_reset();
-
-        nrf_gpio_pin_set(BOUND_LED_PIN);
-        NRF_LOG_INFO("Binding...\r\n");
-        break;
-    case RC_RADIO_EVENT_BOUND:
-    {
-        rc_radio_bind_info_t * p_bind_info;
-        p_bind_info = (rc_radio_bind_info_t*) p_context;
-
-        nrf_gpio_pin_clear(BOUND_LED_PIN);
-        NRF_LOG_INFO("Bound. (%d, %d)\r\n",
-                         p_bind_info->transmitter_channel,
-                         p_bind_info->transmit_rate_hz);
-    }
-        break;
-    case RC_RADIO_EVENT_DATA_RECEIVED:
-    {
-        rc_radio_data_t * p_rc_data;
-        p_rc_data = (rc_radio_data_t*) p_context;
-
-        nrf_gpio_pin_clear(BOUND_LED_PIN);
-        NRF_LOG_INFO("Data recieved:\r\n");
-
-        m_roll_set(p_rc_data->roll);
-        m_pitch_set(p_rc_data->pitch);
-        m_throttle_set(p_rc_data->throttle);
-        m_yaw_set(p_rc_data->yaw);
-    }
-        break;
-    case RC_RADIO_EVENT_PACKET_DROPPED:
-        nrf_gpio_pin_set(BOUND_LED_PIN);
-        NRF_LOG_INFO("Packet dropped.\r\n");
-        break;
-    default:
-        break;
-    };
-}
-
-
-static void m_gpio_init(void)
-{
-    nrf_gpio_cfg_output(BOUND_LED_PIN);
-    nrf_gpio_pin_set(BOUND_LED_PIN);
-}
-
-
-int main(void)
-{
-    uint32_t err_code;
-
-    err_code = NRF_LOG_INIT(NULL);
-    APP_ERROR_CHECK(err_code);
-
-    m_gpio_init();
-
-    err_code = servo_group_init(&m_servo_group,
-                                    SERVO_PWM_INSTANCE,
-                                    YAW_SERVO_PIN,
-                                    ROLL_SERVO_PIN,
-                                    PITCH_SERVO_PIN,
-                                    SERVO_PIN_NOT_USED);
-    APP_ERROR_CHECK(err_code);
-
-#if BDCM
-    err_code = brushed_dc_motor_group_init(&m_brushed_dc_motor_group,
-                                              THROTTLE_PWM_INSTANCE,
-                                              THROTTLE_PIN,
-                                              BRUSHED_DC_MOTOR_PIN_NOT_USED,
-                                              BRUSHED_DC_MOTOR_PIN_NOT_USED,
-                                              BRUSHED_DC_MOTOR_PIN_NOT_USED);
-    APP_ERROR_CHECK(err_code);
-#else
-    err_code = esc_throttle_group_init(&m_esc_group,
-                                           THROTTLE_PWM_INSTANCE,
-                                           THROTTLE_PIN,
-                                           ESC_THROTTLE_PIN_NOT_USED,
-                                           ESC_THROTTLE_PIN_NOT_USED,
-                                           ESC_THROTTLE_PIN_NOT_USED);
-    APP_ERROR_CHECK(err_code);
-#endif
-
-    err_code = rc_radio_receiver_init(RADIO_TIMER_INSTANCE,
-                                          m_rc_radio_handler);
-    APP_ERROR_CHECK(err_code);
-
-    err_code = rc_radio_enable();
-    APP_ERROR_CHECK(err_code);
-
-    while (true)
-    {
-        if (false == NRF_LOG_PROCESS())
-        {
-            __WFE();
-        }
-    }
-}
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "sdk_common.h"
+#include "nrf.h"
+#include "nrf_esb_error_codes.h"
+#include "nrf_delay.h"
+#include "nrf_gpio.h"
+#include "nrf_error.h"
+#include "boards.h"
+
+#define NRF_LOG_MODULE_NAME "APP"
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+
+#include "joystick.h"
+#include "servo.h"
+#include "rc_radio.h"
+#include "utility.h"
+#include "failsafe.h"
+#include "trace.h"
+#include "app_timer.h"
+#include "app_util_platform.h"
+
+
+#define RADIO_TIMER_INSTANCE    (0UL)
+#define SERVO_PWM_INSTANCE      (0UL)
+#define THROTTLE_PWM_INSTANCE   (1UL)
+
+#define BOUND_LED_PIN           (7UL)
+
+#define YAW_SERVO_PIN           (31UL)
+#define ROLL_SERVO_PIN          (30UL)
+#define PITCH_SERVO_PIN         (29UL)
+#define THROTTLE_PIN            (28UL)
+
+#define YAW_SERVO_CHAN          (0UL)
+#define ROLL_SERVO_CHAN         (1UL)
+#define PITCH_SERVO_CHAN        (2UL)
+
+#define THROTTLE_CHAN           (0UL)
+
+// Don't allow the servos to swing further than MAX_SERVO_DELTA
+// in either direction from SERVO_NEUTRAL_VALUE.
+#define MAX_SERVO_DELTA         (15UL)
+
+
+#ifndef INVERT_ROLL
+#define INVERT_ROLL 0
+#endif
+
+#ifndef INVERT_YAW
+#define INVERT_YAW 0
+#endif
+
+#ifndef INVERT_PITCH
+#define INVERT_PITCH 0
+#endif
+
+#ifndef BDCM
+#define BDCM 0
+#endif
+
+#ifndef ESC
+#define ESC 0
+#endif
+
+#ifndef DIVERSITY
+#define DIVERSITY 0
+#endif
+
+#ifndef OUTPUT_STAGE
+#define OUTPUT_STAGE 0
+#endif
+
+#ifndef MIXER
+#define MIXER 0
+#endif
+
+#if (0 == BDCM)
+  #if (0 == ESC)
+    #error Either BDCM or ESC needs to be specified.
+  #endif
+#endif
+
+#if BDCM
+  #if ESC
+    #error Either BDCM or ESC needs to be specified but not both.
+  #endif
+#endif
+
+#if BDCM
+#include "brushed_dc_motor.h"
+#else
+#include "electronic_speed_controller.h"
+
+// Can be set to any esc_protocol_t from the Makefile (e.g. to
+// ESC_PROTOCOL_DSHOT600) if the ESC supports it.
+#ifndef ESC_PROTOCOL
+#define ESC_PROTOCOL ESC_PROTOCOL_PWM
+#endif
+#endif
+
+#if OUTPUT_STAGE
+#include "output_stage.h"
+
+// The outputs are updated once per servo PWM frame (rounded down to whole
+// milliseconds so that no frame is skipped).
+#define OUTPUT_STAGE_UPDATE_MS  (SERVO_FRAME_PERIOD_US / 1000UL)
+#endif
+
+#if MIXER
+#include "mixer.h"
+#endif
+
+#if DIVERSITY
+#include "nrf_drv_uart.h"
+#include "diversity.h"
+
+// The partner receiver's TX pin is connected to this receiver's RX pin and
+// vice versa.
+#define DIVERSITY_LINK_TX_PIN   (11UL)
+#define DIVERSITY_LINK_RX_PIN   (12UL)
+#define DIVERSITY_LINK_SYNC     (0xA5UL)
+
+typedef struct
+{
+    uint8_t         sync;
+    uint8_t         event;
+    rc_radio_data_t data;
+} diversity_link_msg_t;
+#endif
+
+
+static servo_group_t m_servo_group;
+
+#if RC_RADIO_HIGH_RES
+// The surface and throttle values are in the actuator's high resolution range
+// instead of [0, 100].
+typedef uint16_t output_value_t;
+
+#define HR_SERVO_NEUTRAL_VALUE  (SERVO_HR_MAX_VALUE / 2)
+#else
+typedef uint8_t  output_value_t;
+
+// The halves of the servo range that the surface inputs are scaled from.
+static const scale_t m_upper_half_scale = SCALE_INIT(SERVO_NEUTRAL_VALUE,
+                                                         SERVO_MAX_VALUE);
+static const scale_t m_lower_half_scale = SCALE_INIT(SERVO_MIN_VALUE,
+                                                         SERVO_NEUTRAL_VALUE);
+#endif
+
+#if BDCM
+static brushed_dc_motor_group_t m_brushed_dc_motor_group;
+#else
+static esc_throttle_group_t     m_esc_group;
+#endif
+
+// These groups are committed together by m_controls_apply.
+#if BDCM
+static actuator_group_t * const m_output_groups[] = {
+    &m_servo_group,
+    &m_brushed_dc_motor_group
+};
+#else
+static actuator_group_t * const m_output_groups[] = {
+    &m_servo_group,
+    &m_esc_group
+};
+#endif
+
+#if DIVERSITY
+static nrf_drv_uart_t           m_link_uart = NRF_DRV_UART_INSTANCE(0);
+static diversity_link_msg_t     m_link_tx_msg;
+static diversity_link_msg_t     m_link_rx_msg;
+#endif
+
+
+
+// Maps a surface input to within MAX_SERVO_DELTA percent of the servo's
+// neutral position.
+static output_value_t m_surface_map(joystick_value_t raw)
+{
+#if RC_RADIO_HIGH_RES
+    // Every divisor is a constant so no runtime division is needed.
+    int32_t delta;
+
+    delta = (((int32_t)raw - (int32_t)(JOYSTICK_MAX_VALUE / 2)) *
+                 (int32_t)(2 * MAX_SERVO_DELTA * SERVO_HR_MAX_VALUE) /
+                 (int32_t)(100 * JOYSTICK_MAX_VALUE));
+
+    return (output_value_t)((int32_t)HR_SERVO_NEUTRAL_VALUE + delta);
+#else
+    output_value_t value;
+
+    if (SERVO_NEUTRAL_VALUE < raw)
+    {
+        value = scale_pam(&m_upper_half_scale, raw);
+        value = map(value,
+                        SERVO_NEUTRAL_VALUE,
+                        (SERVO_NEUTRAL_VALUE + MAX_SERVO_DELTA));
+    }
+    else
+    {
+        value = scale_pam(&m_lower_half_scale, raw);
+        value = map(value,
+                        (SERVO_NEUTRAL_VALUE - MAX_SERVO_DELTA),
+                        SERVO_NEUTRAL_VALUE);
+    }
+
+    return value;
+#endif
+}
+
+
+static output_value_t m_roll_map(joystick_value_t raw_roll)
+{
+    output_value_t roll;
+
+#if INVERT_ROLL
+    raw_roll = (JOYSTICK_MAX_VALUE - raw_roll);
+#endif
+
+    roll = m_surface_map(raw_roll);
+
+    return roll;
+}
+
+
+static output_value_t m_pitch_map(joystick_value_t raw_pitch)
+{
+    output_value_t pitch;
+
+#if INVERT_PITCH
+    raw_pitch = (JOYSTICK_MAX_VALUE - raw_pitch);
+#endif
+
+    pitch = m_surface_map(raw_pitch);
+
+    return pitch;
+}
+
+
+static output_value_t m_yaw_map(joystick_value_t raw_yaw)
+{
+    output_value_t yaw;
+
+#if INVERT_YAW
+    raw_yaw = (JOYSTICK_MAX_VALUE - raw_yaw);
+#endif
+
+    yaw = m_surface_map(raw_yaw);
+
+    return yaw;
+}
+
+
+static output_value_t m_throttle_map(joystick_value_t raw_throttle)
+{
+    output_value_t throttle;
+
+#if RC_RADIO_HIGH_RES
+    throttle = (output_value_t)((uint32_t)raw_throttle *
+                                    ACTUATOR_HR_MAX_VALUE /
+                                    JOYSTICK_MAX_VALUE);
+#elif BDCM
+    throttle = map(raw_throttle,
+                       BRUSHED_DC_MOTOR_MIN_VALUE,
+                       BRUSHED_DC_MOTOR_MAX_VALUE);
+#else
+    throttle = map(raw_throttle,
+                       ESC_THROTTLE_MIN_VALUE,
+                       ESC_THROTTLE_MAX_VALUE);
+#endif
+
+    return throttle;
+}
+
+
+static void m_controls_apply(const rc_radio_data_t * p_rc_data)
+{
+    uint32_t       servo_err_code;
+    uint32_t       throttle_err_code;
+    output_value_t servo_values[SERVO_CHANNEL_COUNT] = {0};
+    output_value_t throttle;
+
+#if MIXER
+    rc_radio_data_t mixed_data;
+
+    // The failsafe values are mixed as well because they are stick values.
+    mixer_apply(p_rc_data, &mixed_data);
+    p_rc_data = &mixed_data;
+#endif
+
+    servo_values[ROLL_SERVO_CHAN]  = m_roll_map(p_rc_data->roll);
+    servo_values[PITCH_SERVO_CHAN] = m_pitch_map(p_rc_data->pitch);
+    servo_values[YAW_SERVO_CHAN]   = m_yaw_map(p_rc_data->yaw);
+    throttle                       = m_throttle_map(p_rc_data->throttle);
+
+    TRACE(RX_CONTROLS,
+              servo_values[ROLL_SERVO_CHAN],
+              servo_values[PITCH_SERVO_CHAN],
+              servo_values[YAW_SERVO_CHAN],
+              throttle,
+              p_rc_data->switches);
+
+    // Every output is staged and then committed together so that no PWM
+    // frame mixes values from different rc_radio_data_t frames. The region
+    // also keeps the failsafe from staging in between.
+    CRITICAL_REGION_ENTER();
+
+#if RC_RADIO_HIGH_RES
+    servo_err_code = servo_values_hr_stage(&m_servo_group, servo_values);
+#if BDCM
+    throttle_err_code = brushed_dc_motor_value_hr_stage(&m_brushed_dc_motor_group,
+                                                            THROTTLE_CHAN,
+                                                            throttle);
+#else
+    throttle_err_code = esc_throttle_value_hr_stage(&m_esc_group,
+                                                        THROTTLE_CHAN,
+                                                        throttle);
+#endif
+#else
+    servo_err_code = servo_values_stage(&m_servo_group, servo_values);
+#if BDCM
+    throttle_err_code = brushed_dc_motor_value_stage(&m_brushed_dc_motor_group,
+                                                         THROTTLE_CHAN,
+                                                         throttle);
+#else
+    throttle_err_code = esc_throttle_value_stage(&m_esc_group,
+                                                     THROTTLE_CHAN,
+                                                     throttle);
+#endif
+#endif
+    actuator_commit(m_output_groups, ARRAY_SIZE(m_output_groups));
+
+    CRITICAL_REGION_EXIT();
+
+    APP_ERROR_CHECK(servo_err_code);
+    APP_ERROR_CHECK(throttle_err_code);
+}
+
+
+static void m_failsafe_handler(const rc_radio_data_t * p_rc_data)
+{
+    nrf_gpio_pin_set(BOUND_LED_PIN);
+    NRF_LOG_INFO("Failsafe engaged:\r\n");
+
+#if OUTPUT_STAGE
+    output_stage_hold(p_rc_data);
+#endif
+#if MIXER
+    // The failsafe values must not be ramped towards by the rate limits.
+    mixer_reset();
+#endif
+    m_controls_apply(p_rc_data);
+}
+
+
+static void m_rc_radio_handler(rc_radio_event_t event, const void * const p_context)
+{
+    switch (event)
+    {
+    case RC_RADIO_EVENT_BINDING:
+        // The transmitter has gone away so don't wait for the rest of the
+        // failsafe hold period.
+        failsafe_trigger();
+
+        nrf_gpio_pin_set(BOUND_LED_PIN);
+        NRF_LOG_INFO("Binding...\r\n");
+        break;
+    case RC_RADIO_EVENT_BOUND:
+    {
+        rc_radio_bind_info_t * p_bind_info;
+        p_bind_info = (rc_radio_bind_info_t*) p_context;
+
+        nrf_gpio_pin_clear(BOUND_LED_PIN);
+        NRF_LOG_INFO("Bound. (%d, %d)\r\n",
+                         p_bind_info->transmitter_channel,
+                         p_bind_info->transmit_rate_hz);
+#if OUTPUT_STAGE
+        output_stage_bind_info_set(p_bind_info);
+#endif
+    }
+        break;
+    case RC_RADIO_EVENT_DATA_RECEIVED:
+    {
+        rc_radio_data_t * p_rc_data;
+        p_rc_data = (rc_radio_data_t*) p_context;
+
+        nrf_gpio_pin_clear(BOUND_LED_PIN);
+        TRACE(RX_DATA_RECEIVED,
+                  p_rc_data->throttle,
+                  p_rc_data->pitch,
+                  p_rc_data->roll,
+                  p_rc_data->yaw,
+                  p_rc_data->switches);
+
+        failsafe_data_received(p_rc_data);
+#if OUTPUT_STAGE
+        output_stage_frame_put(p_rc_data);
+#else
+        m_controls_apply(p_rc_data);
+#endif
+    }
+        break;
+    case RC_RADIO_EVENT_AUX_RECEIVED:
+        failsafe_aux_received((const rc_radio_aux_data_t*) p_context);
+#if MIXER
+        mixer_aux_received((const rc_radio_aux_data_t*) p_context);
+#endif
+        break;
+    case RC_RADIO_EVENT_PACKET_DROPPED:
+        // The failsafe decides when the link is lost; a single drop only
+        // means the last values are held for one more period.
+        TRACE(RX_PACKET_DROPPED);
+        break;
+    default:
+        break;
+    };
+}
+
+
+static void m_gpio_init(void)
+{
+    nrf_gpio_cfg_output(BOUND_LED_PIN);
+    nrf_gpio_pin_set(BOUND_LED_PIN);
+}
+
+
+static void lfclk_start(void)
+{
+    NRF_CLOCK->LFCLKSRC             = (CLOCK_LFCLKSRC_SRC_Xtal << CLOCK_LFCLKSRC_SRC_Pos);
+    NRF_CLOCK->EVENTS_LFCLKSTARTED  = 0;
+    NRF_CLOCK->TASKS_LFCLKSTART     = 1;
+    while (0 == NRF_CLOCK->EVENTS_LFCLKSTARTED)
+    {
+    }
+    NRF_CLOCK->EVENTS_LFCLKSTARTED = 0;
+}
+
+
+#if DIVERSITY
+static void m_link_send(rc_radio_event_t event, const rc_radio_data_t * p_data)
+{
+    // If the previous message is still being sent then this one is dropped;
+    // the partner will treat it the same as a missed packet. The message
+    // buffer is still being read by EasyDMA so it can't be touched.
+    if (nrf_drv_uart_tx_in_progress(&m_link_uart))
+    {
+        return;
+    }
+
+    m_link_tx_msg.sync  = DIVERSITY_LINK_SYNC;
+    m_link_tx_msg.event = event;
+
+    if (NULL != p_data)
+    {
+        memcpy(&m_link_tx_msg.data, p_data, sizeof(rc_radio_data_t));
+    }
+
+    (void)nrf_drv_uart_tx(&m_link_uart,
+                              (uint8_t*)&m_link_tx_msg,
+                              sizeof(diversity_link_msg_t));
+}
+
+
+static void m_link_uart_handler(nrf_drv_uart_event_t * p_event, void * p_context)
+{
+    switch (p_event->type)
+    {
+    case NRF_DRV_UART_EVT_RX_DONE:
+        if (&m_link_rx_msg.sync == p_event->data.rxtx.p_data)
+        {
+            if (DIVERSITY_LINK_SYNC == m_link_rx_msg.sync)
+            {
+                // Read the remainder of the message.
+                APP_ERROR_CHECK(nrf_drv_uart_rx(&m_link_uart,
+                                                    &m_link_rx_msg.event,
+                                                    (sizeof(diversity_link_msg_t) - 1)));
+                break;
+            }
+        }
+        else
+        {
+            diversity_remote_event_put((rc_radio_event_t)m_link_rx_msg.event,
+                                           &m_link_rx_msg.data);
+        }
+
+        APP_ERROR_CHECK(nrf_drv_uart_rx(&m_link_uart, &m_link_rx_msg.sync, 1));
+        break;
+    case NRF_DRV_UART_EVT_ERROR:
+        // Resynchronize on the next sync byte.
+        APP_ERROR_CHECK(nrf_drv_uart_rx(&m_link_uart, &m_link_rx_msg.sync, 1));
+        break;
+    default:
+        break;
+    }
+}
+
+
+static uint32_t m_link_init(void)
+{
+    uint32_t              err_code;
+    nrf_drv_uart_config_t uart_config = NRF_DRV_UART_DEFAULT_CONFIG;
+
+    uart_config.pseltxd            = DIVERSITY_LINK_TX_PIN;
+    uart_config.pselrxd            = DIVERSITY_LINK_RX_PIN;
+    uart_config.baudrate           = NRF_UART_BAUDRATE_1000000;
+    // The combiner's state is shared with the rc_radio callback.
+    uart_config.interrupt_priority = RC_RADIO_CALLBACK_IRQ_PRIORITY;
+
+    err_code = nrf_drv_uart_init(&m_link_uart, &uart_config, m_link_uart_handler);
+    if (NRF_SUCCESS != err_code)
+    {
+        return err_code;
+    }
+
+    return nrf_drv_uart_rx(&m_link_uart, &m_link_rx_msg.sync, 1);
+}
+
+#endif
+
+
+int main(void)
+{
+    uint32_t err_code;
+
+    err_code = NRF_LOG_INIT(NULL);
+    APP_ERROR_CHECK(err_code);
+
+    m_gpio_init();
+
+    err_code = servo_group_init(&m_servo_group,
+                                    SERVO_PWM_INSTANCE,
+                                    YAW_SERVO_PIN,
+                                    ROLL_SERVO_PIN,
+                                    PITCH_SERVO_PIN,
+                                    SERVO_PIN_NOT_USED);
+    APP_ERROR_CHECK(err_code);
+
+#if BDCM
+    err_code = brushed_dc_motor_group_init(&m_brushed_dc_motor_group,
+                                              THROTTLE_PWM_INSTANCE,
+                                              THROTTLE_PIN,
+                                              BRUSHED_DC_MOTOR_PIN_NOT_USED,
+                                              BRUSHED_DC_MOTOR_PIN_NOT_USED,
+                                              BRUSHED_DC_MOTOR_PIN_NOT_USED);
+    APP_ERROR_CHECK(err_code);
+#else
+    err_code = esc_throttle_group_init(&m_esc_group,
+                                           THROTTLE_PWM_INSTANCE,
+                                           ESC_PROTOCOL,
+                                           THROTTLE_PIN,
+                                           ESC_THROTTLE_PIN_NOT_USED,
+                                           ESC_THROTTLE_PIN_NOT_USED,
+                                           ESC_THROTTLE_PIN_NOT_USED);
+    APP_ERROR_CHECK(err_code);
+#endif
+
+    // Started as a set so that the servos and the throttle switch to each
+    // commit at the same PWM boundary. A DShot ESC can't be padded to the
+    // servo frame so it is started on its own and may switch up to two of
+    // its sequences apart from the servos.
+    err_code = actuator_groups_start(m_output_groups, ARRAY_SIZE(m_output_groups));
+    if (NRF_ERROR_INVALID_PARAM == err_code)
+    {
+        uint32_t i;
+
+        for (i = 0; i < ARRAY_SIZE(m_output_groups); i++)
+        {
+            err_code = actuator_groups_start(&m_output_groups[i], 1);
+            APP_ERROR_CHECK(err_code);
+        }
+    }
+    APP_ERROR_CHECK(err_code);
+
+    // The app_timer module requires an LFCLK source.
+    lfclk_start();
+    err_code = app_timer_init();
+    APP_ERROR_CHECK(err_code);
+
+    err_code = trace_init();
+    APP_ERROR_CHECK(err_code);
+
+#if MIXER
+    mixer_init();
+#endif
+
+    err_code = failsafe_init(m_failsafe_handler);
+    APP_ERROR_CHECK(err_code);
+
+#if OUTPUT_STAGE
+    err_code = output_stage_init(OUTPUT_STAGE_UPDATE_MS, m_controls_apply);
+    APP_ERROR_CHECK(err_code);
+#endif
+
+#if DIVERSITY
+    err_code = diversity_init(m_rc_radio_handler, m_link_send);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = m_link_init();
+    APP_ERROR_CHECK(err_code);
+
+    err_code = rc_radio_receiver_init(RADIO_TIMER_INSTANCE,
+                                          diversity_rc_radio_handler);
+    APP_ERROR_CHECK(err_code);
+#else
+    err_code = rc_radio_receiver_init(RADIO_TIMER_INSTANCE,
+                                          m_rc_radio_handler);
+    APP_ERROR_CHECK(err_code);
+#endif
+
+    err_code = rc_radio_enable();
+    APP_ERROR_CHECK(err_code);
+
+    while (true)
+    {
+        bool log_pending   = NRF_LOG_PROCESS();
+        bool trace_pending = trace_process();
+
+        if ((false == log_pending) && (false == trace_pending))
+        {
+            __WFE();
+        }
+    }
+}
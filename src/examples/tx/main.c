@@ -1,337 +1,509 @@
- /**
- * The throttle is kept at neutral until its value exceeds
- * THROTTLE_SAFETY_MARGIN. This is meant to keep noise on the joystick ADC pin
- * from activating the throttle unexpectedly.
- *
- * There are typically two types of throttle joysticks on RC transmitters:
- *   1) Ones that automatically return to the center position on both X
- *      and Y axis
- *   2) Ones that automatically return to the center position on the X
- *      axis but can be left at an arbitrary position on the Y axis
- *
- * This module assumes that the throttle control is linked to the left
- * joystick's Y axis. There are three throttle control modes:
- *    1) THROTTLE_CTL_FWD_ONLY_NEUTRAL_0 - Throttle is neutral at joystick
- *       position 0 and values match the joystick's position.
- *    2) THROTTLE_CTL_FWD_ONLY_NEUTRAL_50 - Throttle is neutral at joystick
- *       position 50. Joystick values below 50 are considered 0. Values are
- *       mapped from joystick range [50, 100] to [0, 100].
- *    3) THROTTLE_CTL_FWD_BKWD_NEUTRAL_50 - The same as
- *       THROTTLE_CTL_FWD_ONLY_NEUTRAL_0 except THROTTLE_SAFETY_MARGIN is
- *       applied to values on both sides of the neutral point.
- *
- * BOUND_LED_PIN selects an LED to light after a receiver has ACK'd and the
- * transmitter begins transmitting data.
- *
- * INVERT_PITCH_BUTTON_PIN is used as a toggle to invert the pitch data (right
- * joystick's Y axis). INVERTED_PITCH_LED_PIN selects an LED to light when the
- * pitch is inverted.
- *
- * THROT_CTL_BUTTON_PIN is used as a cycle through the possible throttle_ctl_t
- * modes. THROT_CTL_CHANGED_LED_PIN selects an LED to light when the mode
- * has been changed from the default mode (i.e. a warning).
- *
- * BIND_RESET_BUTTON_PIN is used to reset the transmitter back to binding mode.
- */
-#include <stdbool.h>
-#include <stdint.h>
-#include <stdio.h>
-#include <string.h>
-#include "nrf.h"
-#include "boards.h"
-#include "app_error.h"
-#include "nrf_delay.h"
-#include "app_util_platform.h"
-#include "nrf_gpio.h"
-#include "app_timer.h"
-#include "app_button.h"
-
-#define NRF_LOG_MODULE_NAME "APP"
-#include "nrf_log.h"
-#include "nrf_log_ctrl.h"
-
-#include "joystick.h"
-#include "rc_radio.h"
-#include "utility.h"
-
-
-#define RADIO_TIMER_INSTANCE      (0UL)
-#define JOYSTICK_TIMER_INSTANCE   (1UL)
-
-#define RADIO_UPDATE_RATE_HZ      (100UL)
-#define JOYSTICK_UPDATE_RATE_HZ   (50UL)
-
-#define THROTTLE_CTL_DEFAULT      (THROTTLE_CTL_FWD_ONLY_NEUTRAL_50)
-#define THROTTLE_SAFETY_MARGIN    (8UL)
-
-#define INVERTED_PITCH_LED_PIN    (LED_1)
-#define THROT_CTL_CHANGED_LED_PIN (LED_3)
-#define BOUND_LED_PIN             (LED_4)
-#define INVERT_PITCH_BUTTON_PIN   (BUTTON_1)
-#define THROT_CTL_BUTTON_PIN      (BUTTON_3)
-#define BIND_RESET_BUTTON_PIN     (BUTTON_4)
-#define LEFT_X_JS_PIN             (JOYSTICK_PIN_1) // P0.3
-#define LEFT_Y_JS_PIN             (JOYSTICK_PIN_2) // P0.4
-#define RIGHT_X_JS_PIN            (JOYSTICK_PIN_4) // P0.28
-#define RIGHT_Y_JS_PIN            (JOYSTICK_PIN_5) // P0.29
-
-#define NEUTRAL_50_JOYSTICK_VALUE (50UL)
-
-
-typedef enum
-{
-    THROTTLE_CTL_FWD_ONLY_NEUTRAL_0,
-    THROTTLE_CTL_FWD_ONLY_NEUTRAL_50,
-    THROTTLE_CTL_FWD_BKWD_NEUTRAL_50,
-    THROTTLE_CTL_COUNT
-} throttle_ctl_t;
-
-
-static void m_button_handler(uint8_t pin_no, uint8_t button_action);
-
-static rc_radio_data_t  m_radio_data;
-static bool             m_invert_y_axis=false;
-static throttle_ctl_t   m_throttle_ctl=THROTTLE_CTL_DEFAULT;
-static app_button_cfg_t m_buttons[] =
-{
-    {
-        INVERT_PITCH_BUTTON_PIN,
-        BUTTONS_ACTIVE_STATE,
-        BUTTON_PULL,
-        m_button_handler
-    },
-    {
-        THROT_CTL_BUTTON_PIN,
-        BUTTONS_ACTIVE_STATE,
-        BUTTON_PULL,
-        m_button_handler
-    },
-    {
-        BIND_RESET_BUTTON_PIN,
-        BUTTONS_ACTIVE_STATE,
-        BUTTON_PULL,
-        m_button_handler
-    }
-};
-
-
-static void m_joystick_handler(uint8_t l_x,
-                                   uint8_t l_y,
-                                   uint8_t r_x,
-                                   uint8_t r_y)
-{
-    NRF_LOG_INFO("-----Raw joystick data-----\r\n");
-    NRF_LOG_INFO("Left X:\t%d\r\n",  l_x);
-    NRF_LOG_INFO("Left Y:\t%d\r\n",  l_y);
-    NRF_LOG_INFO("Right X:\t%d\r\n", r_x);
-    NRF_LOG_INFO("Right Y:\t%d\r\n", r_y);
-
-    m_radio_data.yaw  = l_x;
-    m_radio_data.roll = r_x;
-
-    if (!m_invert_y_axis)
-    {
-        m_radio_data.pitch = r_y;
-    }
-    else
-    {
-        m_radio_data.pitch = (JOYSTICK_MAX_VALUE - r_y);
-    }
-
-    switch (m_throttle_ctl)
-    {
-    case THROTTLE_CTL_FWD_ONLY_NEUTRAL_0:
-        if (THROTTLE_SAFETY_MARGIN <= l_y)
-        {
-            m_radio_data.throttle = l_y;
-        }
-        else
-        {
-            m_radio_data.throttle = 0;
-        }
-        break;
-    case THROTTLE_CTL_FWD_ONLY_NEUTRAL_50:
-        if ((NEUTRAL_50_JOYSTICK_VALUE + THROTTLE_SAFETY_MARGIN) <= l_y)
-        {
-            // Convert from [50, 100] to [0, 100].
-            m_radio_data.throttle = pam(l_y,
-                                            NEUTRAL_50_JOYSTICK_VALUE,
-                                            JOYSTICK_MAX_VALUE);
-        }
-        else
-        {
-            m_radio_data.throttle = 0;
-        }
-        break;
-    case THROTTLE_CTL_FWD_BKWD_NEUTRAL_50:
-        if (((NEUTRAL_50_JOYSTICK_VALUE + THROTTLE_SAFETY_MARGIN) > l_y) &&
-               ((NEUTRAL_50_JOYSTICK_VALUE - THROTTLE_SAFETY_MARGIN) < l_y))
-        {
-            m_radio_data.throttle = NEUTRAL_50_JOYSTICK_VALUE;
-        }
-        else
-        {
-            m_radio_data.throttle = l_y;
-        }
-        break;
-    default:
-        break;
-    }
-
-    NRF_LOG_INFO("-----Channel data-----\r\n");
-    NRF_LOG_INFO("Yaw:\t\t%d\r\n",    m_radio_data.yaw);
-    NRF_LOG_INFO("Throttle:\t%d\r\n", m_radio_data.throttle);
-    NRF_LOG_INFO("Roll:\t%d\r\n",     m_radio_data.roll);
-    NRF_LOG_INFO("Pitch:\t%d\r\n",    m_radio_data.pitch);
-
-    APP_ERROR_CHECK(rc_radio_data_set(&m_radio_data));
-}
-
-
-static void m_rc_radio_handler(rc_radio_event_t event,
-                                    const void * const p_context)
-{
-    switch (event)
-    {
-    case RC_RADIO_EVENT_BINDING:
-        nrf_gpio_pin_set(BOUND_LED_PIN);
-        NRF_LOG_INFO("Binding...\r\n");
-        break;
-    case RC_RADIO_EVENT_BOUND:
-    {
-        rc_radio_bind_info_t * p_bind_info;
-        p_bind_info = (rc_radio_bind_info_t*) p_context;
-
-        nrf_gpio_pin_clear(BOUND_LED_PIN);
-        NRF_LOG_INFO("Bound. (%d, %d)\r\n",
-                         p_bind_info->transmitter_channel,
-                         p_bind_info->transmit_rate_hz);
-    }
-        break;
-    case RC_RADIO_EVENT_DATA_SENT:
-        NRF_LOG_INFO("Data sent.\r\n");
-        break;
-    default:
-        break;
-    };
-}
-
-
-static void m_button_handler(uint8_t pin_no, uint8_t button_action)
-{
-    NRF_LOG_INFO("Button %d action %d.\r\n", pin_no, button_action);
-
-    if (button_action)
-    {
-        switch (pin_no)
-        {
-        case INVERT_PITCH_BUTTON_PIN:
-            m_invert_y_axis = !m_invert_y_axis;
-
-            if (m_invert_y_axis)
-            {
-                nrf_gpio_pin_clear(INVERTED_PITCH_LED_PIN);
-            }
-            else
-            {
-                nrf_gpio_pin_set(INVERTED_PITCH_LED_PIN);
-            }
-            break;
-        case THROT_CTL_BUTTON_PIN:
-            m_throttle_ctl = ((m_throttle_ctl + 1) % THROTTLE_CTL_COUNT);
-            if (THROTTLE_CTL_DEFAULT != m_throttle_ctl)
-            {
-                nrf_gpio_pin_clear(THROT_CTL_CHANGED_LED_PIN);
-            }
-            else
-            {
-                nrf_gpio_pin_set(THROT_CTL_CHANGED_LED_PIN);
-            }
-            NRF_LOG_INFO("Throttle ctl mode set to: %d\r\n", m_throttle_ctl);
-            break;
-        case BIND_RESET_BUTTON_PIN:
-            rc_radio_disable();
-            rc_radio_enable();
-            break;
-        default:
-            break;
-        }
-    }
-}
-
-
-static void m_gpio_init(void)
-{
-    nrf_gpio_cfg_output(BOUND_LED_PIN);
-    nrf_gpio_cfg_output(INVERTED_PITCH_LED_PIN);
-    nrf_gpio_cfg_output(THROT_CTL_CHANGED_LED_PIN);
-    nrf_gpio_pin_set(BOUND_LED_PIN);
-    nrf_gpio_pin_set(INVERTED_PITCH_LED_PIN);
-    nrf_gpio_pin_set(THROT_CTL_CHANGED_LED_PIN);
-}
-
-
-static void lfclk_start(void)
-{
-    NRF_CLOCK->LFCLKSRC             = (CLOCK_LFCLKSRC_SRC_Xtal << CLOCK_LFCLKSRC_SRC_Pos);
-    NRF_CLOCK->EVENTS_LFCLKSTARTED  = 0;
-    NRF_CLOCK->TASKS_LFCLKSTART     = 1;
-    while (0 == NRF_CLOCK->EVENTS_LFCLKSTARTED)
-    {
-    }
-    NRF_CLOCK->EVENTS_LFCLKSTARTED = 0;
-}
-
-
-int main(void)
-{
-    uint32_t err_code;
-
-    NRF_POWER->DCDCEN = true;
-
-    err_code = NRF_LOG_INIT(NULL);
-    APP_ERROR_CHECK(err_code);
-
-    m_gpio_init();
-
-    // The app_timer module requires an LFCLK source.
-    lfclk_start();
-    err_code = app_timer_init();
-    APP_ERROR_CHECK(err_code);
-
-    err_code = app_button_init(m_buttons,
-                                   (sizeof(m_buttons) / sizeof(m_buttons[0])),
-                                   APP_TIMER_TICKS(50));
-    APP_ERROR_CHECK(err_code);
-
-    err_code = app_button_enable();
-    APP_ERROR_CHECK(err_code);
-
-    memset((uint8_t*)&m_radio_data, 0, sizeof(m_radio_data));
-
-    err_code = rc_radio_transmitter_init(RADIO_TIMER_INSTANCE,
-                                             RADIO_UPDATE_RATE_HZ,
-                                             RC_RADIO_TRANSMITTER_CHANNEL_A,
-                                             m_rc_radio_handler);
-    APP_ERROR_CHECK(err_code);
-
-    err_code = rc_radio_enable();
-    APP_ERROR_CHECK(err_code);
-
-    err_code = joystick_init(JOYSTICK_TIMER_INSTANCE,
-                                 JOYSTICK_UPDATE_RATE_HZ,
-                                 m_joystick_handler,
-                                 LEFT_X_JS_PIN,
-                                 LEFT_Y_JS_PIN,
-                                 RIGHT_X_JS_PIN,
-                                 RIGHT_Y_JS_PIN);
-    APP_ERROR_CHECK(err_code);
-
-    while (true)
-    {
-        if (false == NRF_LOG_PROCESS())
-        {
-            __WFE();
-        }
-    }
-}
+ /**
+ * The throttle is kept at neutral until its value exceeds
+ * THROTTLE_SAFETY_MARGIN. This is meant to keep noise on the joystick ADC pin
+ * from activating the throttle unexpectedly.
+ *
+ * There are typically two types of throttle joysticks on RC transmitters:
+ *   1) Ones that automatically return to the center position on both X
+ *      and Y axis
+ *   2) Ones that automatically return to the center position on the X
+ *      axis but can be left at an arbitrary position on the Y axis
+ *
+ * This module assumes that the throttle control is linked to the left
+ * joystick's Y axis. There are three throttle control modes:
+ *    1) THROTTLE_CTL_FWD_ONLY_NEUTRAL_0 - Throttle is neutral at joystick
+ *       position 0 and values match the joystick's position.
+ *    2) THROTTLE_CTL_FWD_ONLY_NEUTRAL_50 - Throttle is neutral at joystick
+ *       position 50. Joystick values below 50 are considered 0. Values are
+ *       mapped from joystick range [50, 100] to [0, 100].
+ *    3) THROTTLE_CTL_FWD_BKWD_NEUTRAL_50 - The same as
+ *       THROTTLE_CTL_FWD_ONLY_NEUTRAL_0 except THROTTLE_SAFETY_MARGIN is
+ *       applied to values on both sides of the neutral point.
+ *
+ * BOUND_LED_PIN selects an LED to light after a receiver has ACK'd and the
+ * transmitter begins transmitting data.
+ *
+ * INVERT_PITCH_BUTTON_PIN is used as a toggle to invert the pitch data (right
+ * joystick's Y axis). INVERTED_PITCH_LED_PIN selects an LED to light when the
+ * pitch is inverted.
+ *
+ * CALIBRATE_BUTTON_PIN starts a joystick calibration. Each stick should then
+ * be moved to its limits and released before the button is pressed again to
+ * save the calibration. CALIBRATING_LED_PIN selects an LED to light while the
+ * calibration is running. The link is stopped while the calibration is saved
+ * so the receiver's failsafe engages until the link is bound again.
+ *
+ * THROT_CTL_BUTTON_PIN is used as a cycle through the possible throttle_ctl_t
+ * modes. THROT_CTL_CHANGED_LED_PIN selects an LED to light when the mode
+ * has been changed from the default mode (i.e. a warning).
+ *
+ * BIND_RESET_BUTTON_PIN is used to reset the transmitter back to binding mode.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "nrf.h"
+#include "boards.h"
+#include "app_error.h"
+#include "nrf_delay.h"
+#include "app_util_platform.h"
+#include "nrf_gpio.h"
+#include "app_timer.h"
+#include "app_button.h"
+
+#define NRF_LOG_MODULE_NAME "APP"
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+
+#include "joystick.h"
+#include "rc_radio.h"
+#include "utility.h"
+#include "failsafe.h"
+#include "switch_input.h"
+#include "trace.h"
+
+
+#define RADIO_TIMER_INSTANCE      (0UL)
+#define JOYSTICK_TIMER_INSTANCE   (1UL)
+
+#define RADIO_UPDATE_RATE_HZ      (100UL)
+#define JOYSTICK_UPDATE_RATE_HZ   (50UL)
+
+#define THROTTLE_CTL_DEFAULT      (THROTTLE_CTL_FWD_ONLY_NEUTRAL_50)
+#define THROTTLE_SAFETY_MARGIN    (8UL * JOYSTICK_MAX_VALUE / 100)
+
+#define INVERTED_PITCH_LED_PIN    (LED_1)
+#define CALIBRATING_LED_PIN       (LED_2)
+#define THROT_CTL_CHANGED_LED_PIN (LED_3)
+#define BOUND_LED_PIN             (LED_4)
+#define INVERT_PITCH_BUTTON_PIN   (BUTTON_1)
+#define CALIBRATE_BUTTON_PIN      (BUTTON_2)
+#define THROT_CTL_BUTTON_PIN      (BUTTON_3)
+#define BIND_RESET_BUTTON_PIN     (BUTTON_4)
+#define LEFT_X_JS_PIN             (JOYSTICK_PIN_1) // P0.3
+#define LEFT_Y_JS_PIN             (JOYSTICK_PIN_2) // P0.4
+#define RIGHT_X_JS_PIN            (JOYSTICK_PIN_4) // P0.28
+#define RIGHT_Y_JS_PIN            (JOYSTICK_PIN_5) // P0.29
+
+// Toggle switches that are sent to the receiver as aux channels. They have to
+// be on the first GPIO port (see switch_input.h). P0.22 and P0.23 go to the
+// QSPI flash on the PCA10056 and P0.24 and P0.25 to its buttons.
+#if defined(BOARD_PCA10056)
+#define SWITCH_0_PIN              (26UL)
+#define SWITCH_1_PIN              (27UL)
+#define SWITCH_2_PIN              (30UL)
+#define SWITCH_3_PIN              (31UL)
+#else
+#define SWITCH_0_PIN              (22UL)
+#define SWITCH_1_PIN              (23UL)
+#define SWITCH_2_PIN              (24UL)
+#define SWITCH_3_PIN              (25UL)
+#endif
+
+#define BOARD_PIN_USED(pin)       (((pin) == BUTTON_1) || ((pin) == BUTTON_2) || \
+                                   ((pin) == BUTTON_3) || ((pin) == BUTTON_4) || \
+                                   ((pin) == LED_1) || ((pin) == LED_2) ||       \
+                                   ((pin) == LED_3) || ((pin) == LED_4))
+
+#if (BOARD_PIN_USED(SWITCH_0_PIN) || BOARD_PIN_USED(SWITCH_1_PIN) || \
+         BOARD_PIN_USED(SWITCH_2_PIN) || BOARD_PIN_USED(SWITCH_3_PIN))
+    #error "A switch pin is also used by one of the board's buttons or LEDs."
+#endif
+
+#define NEUTRAL_50_JOYSTICK_VALUE (JOYSTICK_MAX_VALUE / 2)
+
+// The receiver cuts the throttle and centers the control surfaces if no
+// packets are received for this long.
+#define FAILSAFE_TIMEOUT_MS       (250UL)
+
+// A single lost keepalive must not engage the receiver's failsafe (see
+// RC_RADIO_KEEPALIVE_INTERVAL).
+#if ((2 * RC_RADIO_KEEPALIVE_INTERVAL * 1000UL) >= \
+         (FAILSAFE_TIMEOUT_MS * RADIO_UPDATE_RATE_HZ))
+    #error "RC_RADIO_KEEPALIVE_INTERVAL is too long for FAILSAFE_TIMEOUT_MS."
+#endif
+
+
+typedef enum
+{
+    THROTTLE_CTL_FWD_ONLY_NEUTRAL_0,
+    THROTTLE_CTL_FWD_ONLY_NEUTRAL_50,
+    THROTTLE_CTL_FWD_BKWD_NEUTRAL_50,
+    THROTTLE_CTL_COUNT
+} throttle_ctl_t;
+
+
+static void m_button_handler(uint8_t pin_no, uint8_t button_action);
+
+static rc_radio_data_t  m_radio_data;
+static const uint8_t    m_switch_pins[] = {
+    SWITCH_0_PIN,
+    SWITCH_1_PIN,
+    SWITCH_2_PIN,
+    SWITCH_3_PIN
+};
+static bool             m_invert_y_axis=false;
+static bool             m_calibrating=false;
+static volatile bool    m_calibration_save_pending=false;
+static throttle_ctl_t   m_throttle_ctl=THROTTLE_CTL_DEFAULT;
+static app_button_cfg_t m_buttons[] =
+{
+    {
+        INVERT_PITCH_BUTTON_PIN,
+        BUTTONS_ACTIVE_STATE,
+        BUTTON_PULL,
+        m_button_handler
+    },
+    {
+        CALIBRATE_BUTTON_PIN,
+        BUTTONS_ACTIVE_STATE,
+        BUTTON_PULL,
+        m_button_handler
+    },
+    {
+        THROT_CTL_BUTTON_PIN,
+        BUTTONS_ACTIVE_STATE,
+        BUTTON_PULL,
+        m_button_handler
+    },
+    {
+        BIND_RESET_BUTTON_PIN,
+        BUTTONS_ACTIVE_STATE,
+        BUTTON_PULL,
+        m_button_handler
+    }
+};
+
+
+static void m_joystick_handler(joystick_value_t l_x,
+                                   joystick_value_t l_y,
+                                   joystick_value_t r_x,
+                                   joystick_value_t r_y)
+{
+    TRACE(TX_JOYSTICK_RAW, l_x, l_y, r_x, r_y);
+
+    m_radio_data.yaw      = l_x;
+    m_radio_data.roll     = r_x;
+    m_radio_data.switches = switch_input_sample();
+
+    if (!m_invert_y_axis)
+    {
+        m_radio_data.pitch = r_y;
+    }
+    else
+    {
+        m_radio_data.pitch = (JOYSTICK_MAX_VALUE - r_y);
+    }
+
+    switch (m_throttle_ctl)
+    {
+    case THROTTLE_CTL_FWD_ONLY_NEUTRAL_0:
+        if (THROTTLE_SAFETY_MARGIN <= l_y)
+        {
+            m_radio_data.throttle = l_y;
+        }
+        else
+        {
+            m_radio_data.throttle = 0;
+        }
+        break;
+    case THROTTLE_CTL_FWD_ONLY_NEUTRAL_50:
+        if ((NEUTRAL_50_JOYSTICK_VALUE + THROTTLE_SAFETY_MARGIN) <= l_y)
+        {
+            // Convert from [50%, 100%] to [0%, 100%]. The divisor is a
+            // constant so this doesn't need a runtime division.
+            m_radio_data.throttle = ((l_y - NEUTRAL_50_JOYSTICK_VALUE) *
+                                         JOYSTICK_MAX_VALUE /
+                                         (JOYSTICK_MAX_VALUE - NEUTRAL_50_JOYSTICK_VALUE));
+        }
+        else
+        {
+            m_radio_data.throttle = 0;
+        }
+        break;
+    case THROTTLE_CTL_FWD_BKWD_NEUTRAL_50:
+        if (((NEUTRAL_50_JOYSTICK_VALUE + THROTTLE_SAFETY_MARGIN) > l_y) &&
+               ((NEUTRAL_50_JOYSTICK_VALUE - THROTTLE_SAFETY_MARGIN) < l_y))
+        {
+            m_radio_data.throttle = NEUTRAL_50_JOYSTICK_VALUE;
+        }
+        else
+        {
+            m_radio_data.throttle = l_y;
+        }
+        break;
+    default:
+        break;
+    }
+
+    TRACE(TX_CHANNELS,
+              m_radio_data.yaw,
+              m_radio_data.throttle,
+              m_radio_data.roll,
+              m_radio_data.pitch,
+              m_radio_data.switches);
+
+    // The link is stopped while the calibration is being saved.
+    if (!m_calibration_save_pending)
+    {
+        APP_ERROR_CHECK(rc_radio_data_set(&m_radio_data));
+    }
+}
+
+
+static void m_rc_radio_handler(rc_radio_event_t event,
+                                    const void * const p_context)
+{
+    switch (event)
+    {
+    case RC_RADIO_EVENT_BINDING:
+        nrf_gpio_pin_set(BOUND_LED_PIN);
+        NRF_LOG_INFO("Binding...\r\n");
+        break;
+    case RC_RADIO_EVENT_BOUND:
+    {
+        rc_radio_bind_info_t * p_bind_info;
+        p_bind_info = (rc_radio_bind_info_t*) p_context;
+
+        nrf_gpio_pin_clear(BOUND_LED_PIN);
+        NRF_LOG_INFO("Bound. (%d, %d)\r\n",
+                         p_bind_info->transmitter_channel,
+                         p_bind_info->transmit_rate_hz);
+    }
+        break;
+    case RC_RADIO_EVENT_DATA_SENT:
+        TRACE(TX_DATA_SENT);
+        break;
+    default:
+        break;
+    };
+}
+
+
+// The joystick driver stops reporting while it is being calibrated so the
+// sticks are sent as released until it is done.
+static void m_calibration_toggle(void)
+{
+    uint32_t err_code;
+
+    if (!m_calibrating)
+    {
+        m_radio_data.yaw   = NEUTRAL_50_JOYSTICK_VALUE;
+        m_radio_data.roll  = NEUTRAL_50_JOYSTICK_VALUE;
+        m_radio_data.pitch = NEUTRAL_50_JOYSTICK_VALUE;
+        if (THROTTLE_CTL_FWD_BKWD_NEUTRAL_50 == m_throttle_ctl)
+        {
+            m_radio_data.throttle = NEUTRAL_50_JOYSTICK_VALUE;
+        }
+        else
+        {
+            m_radio_data.throttle = JOYSTICK_MIN_VALUE;
+        }
+        APP_ERROR_CHECK(rc_radio_data_set(&m_radio_data));
+
+        APP_ERROR_CHECK(joystick_calibration_start());
+        m_calibrating = true;
+        nrf_gpio_pin_clear(CALIBRATING_LED_PIN);
+        NRF_LOG_INFO("Calibrating. Move the sticks to their limits, release them and press again.\r\n");
+    }
+    else
+    {
+        // The calibration is saved from the main loop (see
+        // m_calibration_save) instead of from this handler.
+        err_code = joystick_calibration_stop(false);
+        if (NRF_ERROR_INVALID_DATA == err_code)
+        {
+            NRF_LOG_INFO("Calibration failed. The previous calibration is kept.\r\n");
+        }
+        else
+        {
+            APP_ERROR_CHECK(err_code);
+            m_calibration_save_pending = true;
+        }
+        m_calibrating = false;
+        nrf_gpio_pin_set(CALIBRATING_LED_PIN);
+    }
+}
+
+
+// Erasing the calibration's flash page stalls the CPU for about 90 ms, which
+// would stop the radio's interrupts in the middle of the link. The link is
+// stopped for the save instead and the receiver's failsafe holds the outputs
+// until the link is bound again.
+static void m_calibration_save(void)
+{
+    rc_radio_disable();
+    APP_ERROR_CHECK(joystick_calibration_save());
+    APP_ERROR_CHECK(rc_radio_enable());
+
+    // The joystick handler resumes sending, which binds the link again.
+    m_calibration_save_pending = false;
+
+    NRF_LOG_INFO("Calibration saved.\r\n");
+}
+
+
+static void m_button_handler(uint8_t pin_no, uint8_t button_action)
+{
+    NRF_LOG_INFO("Button %d action %d.\r\n", pin_no, button_action);
+
+    if (button_action)
+    {
+        switch (pin_no)
+        {
+        case INVERT_PITCH_BUTTON_PIN:
+            m_invert_y_axis = !m_invert_y_axis;
+
+            if (m_invert_y_axis)
+            {
+                nrf_gpio_pin_clear(INVERTED_PITCH_LED_PIN);
+            }
+            else
+            {
+                nrf_gpio_pin_set(INVERTED_PITCH_LED_PIN);
+            }
+            break;
+        case CALIBRATE_BUTTON_PIN:
+            m_calibration_toggle();
+            break;
+        case THROT_CTL_BUTTON_PIN:
+            m_throttle_ctl = ((m_throttle_ctl + 1) % THROTTLE_CTL_COUNT);
+            if (THROTTLE_CTL_DEFAULT != m_throttle_ctl)
+            {
+                nrf_gpio_pin_clear(THROT_CTL_CHANGED_LED_PIN);
+            }
+            else
+            {
+                nrf_gpio_pin_set(THROT_CTL_CHANGED_LED_PIN);
+            }
+            NRF_LOG_INFO("Throttle ctl mode set to: %d\r\n", m_throttle_ctl);
+            break;
+        case BIND_RESET_BUTTON_PIN:
+            rc_radio_disable();
+            rc_radio_enable();
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+
+static void m_gpio_init(void)
+{
+    nrf_gpio_cfg_output(BOUND_LED_PIN);
+    nrf_gpio_cfg_output(INVERTED_PITCH_LED_PIN);
+    nrf_gpio_cfg_output(CALIBRATING_LED_PIN);
+    nrf_gpio_cfg_output(THROT_CTL_CHANGED_LED_PIN);
+    nrf_gpio_pin_set(BOUND_LED_PIN);
+    nrf_gpio_pin_set(INVERTED_PITCH_LED_PIN);
+    nrf_gpio_pin_set(CALIBRATING_LED_PIN);
+    nrf_gpio_pin_set(THROT_CTL_CHANGED_LED_PIN);
+}
+
+
+static uint32_t m_failsafe_profile_set(void)
+{
+    rc_radio_aux_data_t aux_data;
+    failsafe_profile_t  profile;
+
+    memset((uint8_t*)&profile, 0, sizeof(profile));
+
+    profile.timeout_ms                          = FAILSAFE_TIMEOUT_MS;
+    profile.actions[FAILSAFE_CHANNEL_THROTTLE]  = FAILSAFE_ACTION_NEUTRAL;
+    profile.actions[FAILSAFE_CHANNEL_PITCH]     = FAILSAFE_ACTION_NEUTRAL;
+    profile.actions[FAILSAFE_CHANNEL_ROLL]      = FAILSAFE_ACTION_NEUTRAL;
+    profile.actions[FAILSAFE_CHANNEL_YAW]       = FAILSAFE_ACTION_NEUTRAL;
+
+    failsafe_profile_encode(&profile, &aux_data);
+
+    return rc_radio_aux_data_set(&aux_data);
+}
+
+
+static void lfclk_start(void)
+{
+    NRF_CLOCK->LFCLKSRC             = (CLOCK_LFCLKSRC_SRC_Xtal << CLOCK_LFCLKSRC_SRC_Pos);
+    NRF_CLOCK->EVENTS_LFCLKSTARTED  = 0;
+    NRF_CLOCK->TASKS_LFCLKSTART     = 1;
+    while (0 == NRF_CLOCK->EVENTS_LFCLKSTARTED)
+    {
+    }
+    NRF_CLOCK->EVENTS_LFCLKSTARTED = 0;
+}
+
+
+int main(void)
+{
+    uint32_t err_code;
+
+    NRF_POWER->DCDCEN = true;
+
+    err_code = NRF_LOG_INIT(NULL);
+    APP_ERROR_CHECK(err_code);
+
+    m_gpio_init();
+
+    // The app_timer module requires an LFCLK source.
+    lfclk_start();
+    err_code = app_timer_init();
+    APP_ERROR_CHECK(err_code);
+
+    err_code = trace_init();
+    APP_ERROR_CHECK(err_code);
+
+    err_code = app_button_init(m_buttons,
+                                   (sizeof(m_buttons) / sizeof(m_buttons[0])),
+                                   APP_TIMER_TICKS(50));
+    APP_ERROR_CHECK(err_code);
+
+    err_code = app_button_enable();
+    APP_ERROR_CHECK(err_code);
+
+    memset((uint8_t*)&m_radio_data, 0, sizeof(m_radio_data));
+
+    err_code = rc_radio_transmitter_init(RADIO_TIMER_INSTANCE,
+                                             RADIO_UPDATE_RATE_HZ,
+                                             RC_RADIO_TRANSMITTER_CHANNEL_A,
+                                             m_rc_radio_handler);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = m_failsafe_profile_set();
+    APP_ERROR_CHECK(err_code);
+
+    err_code = rc_radio_enable();
+    APP_ERROR_CHECK(err_code);
+
+    err_code = switch_input_init(m_switch_pins,
+                                     (sizeof(m_switch_pins) / sizeof(m_switch_pins[0])));
+    APP_ERROR_CHECK(err_code);
+
+    err_code = joystick_init(JOYSTICK_TIMER_INSTANCE,
+                                 JOYSTICK_UPDATE_RATE_HZ,
+                                 m_joystick_handler,
+                                 LEFT_X_JS_PIN,
+                                 LEFT_Y_JS_PIN,
+                                 RIGHT_X_JS_PIN,
+                                 RIGHT_Y_JS_PIN);
+    APP_ERROR_CHECK(err_code);
+
+    while (true)
+    {
+        bool log_pending;
+        bool trace_pending;
+
+        if (m_calibration_save_pending)
+        {
+            m_calibration_save();
+        }
+
+        log_pending   = NRF_LOG_PROCESS();
+        trace_pending = trace_process();
+
+        if ((false == log_pending) && (false == trace_pending))
+        {
+            __WFE();
+        }
+    }
+}
@@ -4,23 +4,20 @@
 #include "app_error.h"
 #include "nrf_clock.h"
 #include "nrf_drv_timer.h"
-#include "nrf_gpio.h"
+#include "app_util.h"
+#include "app_util_platform.h"
 
 #include "rc_radio.h"
+#include "rc_radio_probe.h"
 
 
-#define ENABLE_GPIO_DBG    (1UL)
-#define GPIO_DBG_PIN_1     (26UL)
-#define GPIO_DBG_PIN_2     (27UL)
-
 #define BITRATE            (1000000UL)
 #define ADDR_LEN           (5UL)
 #define CHANNEL_MAP_LEN    (10UL)
 #define BIND_CHANNEL       (10UL)
-#define DATA_BUFF_COUNT    (2UL)
 #define MIN_TX_RATE_HZ     (10UL)
 #define MAX_TX_RATE_HZ     (500UL)
-#define TIMER_ISR_PRIORITY (1UL)
+#define TIMER_ISR_PRIORITY (RC_RADIO_IRQ_PRIORITY)
 
 #define ADDR_BITS          (ADDR_LEN * 8UL)
 #define DATA_BITS          (sizeof(rc_radio_data_t) * 8UL)
@@ -37,15 +34,80 @@
 #define RX_WIDENING_US     (100UL)
 #define RX_SAFETY_US       (100UL)
 
+// The crystals on the two ends can be this far apart. The receiver's timer
+// isn't corrected between keepalives so they drift by up to KEEPALIVE_MAX_US
+// times this before the receive window is missed.
+#define CLOCK_DRIFT_PPM    (40UL)
+#define KEEPALIVE_MAX_US   (((RX_SAFETY_US / 2) * 1000000ULL) / CLOCK_DRIFT_PPM)
+
+// A relay sends its downstream packet RELAY_TX_DELAY_US after the upstream
+// packet cleared its timer and gives the radio back to the upstream link
+// RELAY_SLOT_US later. The slot has to cover the longest downstream exchange,
+// a bind packet and its ACK, and what is left is for re-initializing nrf_esb.
+#define RELAY_TX_DELAY_US  (200UL)
+#define RELAY_SLOT_US      (800UL)
+#define RAMP_UP_US         (140UL) /* TX or RX ramp up of the nRF52 radio. */
+#define AIR_US(length)     (RAMP_UP_US +                                      \
+                                LEN_US((PKT_OVERHEAD_BITS + ADDR_BITS +     \
+                                            ((length) * 8UL))))
+
+#if RC_RADIO_ISR_STATS
+#ifndef RC_RADIO_STATS_CLOCK
+    #define RC_RADIO_STATS_CLOCK()      (DWT->CYCCNT)
+    #define RC_RADIO_STATS_CLOCK_INIT()                        \
+        do                                                     \
+        {                                                      \
+            CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;    \
+            DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;        \
+        } while (0)
+#endif
+#ifndef RC_RADIO_STATS_CLOCK_INIT
+    #define RC_RADIO_STATS_CLOCK_INIT()
+#endif
+    #define STATS_START()     uint32_t stats_start = RC_RADIO_STATS_CLOCK()
+    #define STATS_STOP(isr)   m_stats_add((isr),                               \
+                                          (RC_RADIO_STATS_CLOCK() - stats_start))
+#else
+    #define RC_RADIO_STATS_CLOCK_INIT()
+    #define STATS_START()
+    #define STATS_STOP(isr)
+#endif
+
+
+// The receiver uses the payload length to tell data and aux payloads apart.
+STATIC_ASSERT(sizeof(rc_radio_aux_data_t) != sizeof(rc_radio_data_t));
+STATIC_ASSERT(sizeof(rc_radio_aux_data_t) <= NRF_ESB_MAX_PAYLOAD_LENGTH);
+
+// The receiver would give up on the link after a single lost keepalive
+// otherwise.
+STATIC_ASSERT((2 * RC_RADIO_KEEPALIVE_INTERVAL) <= RC_RADIO_MISSED_PACKET_TOLERANCE);
+
+// The window opens RX_WIDENING_US early and closes RX_SAFETY_US late so the
+// drift allowed by KEEPALIVE_MAX_US fits on both sides.
+STATIC_ASSERT(RX_SAFETY_US <= RX_WIDENING_US);
 
-typedef enum
+
+#define EVENT_QUEUE_MASK   (RC_RADIO_EVENT_QUEUE_LEN - 1)
+
+STATIC_ASSERT(0 == (RC_RADIO_EVENT_QUEUE_LEN & EVENT_QUEUE_MASK));
+
+// The pool is tracked with 32-bit masks.
+STATIC_ASSERT(RC_RADIO_RX_POOL_LEN <= 32);
+
+
+typedef struct
 {
-    RC_RADIO_STATE_DISABLED,
-    RC_RADIO_STATE_ENABLED,
-    RC_RADIO_STATE_BINDING,
-    RC_RADIO_STATE_STARTED,
-    RC_RADIO_STATE_COUNT
-} rc_radio_state_t;
+    volatile uint32_t seq; // Index of the post that filled the entry
+    rc_radio_ctx_t *  p_ctx;
+    rc_radio_event_t  event;
+    const void *      p_context;
+    union
+    {
+        rc_radio_bind_info_t bind_info;
+        rc_radio_data_t      data;
+        rc_radio_aux_data_t  aux_data;
+    } context;
+} event_entry_t;
 
 
 static const uint8_t
@@ -72,50 +134,379 @@ ADDRESSES[RC_RADIO_TRANSMITTER_CHANNEL_COUNT][ADDR_LEN] = {
 static const uint8_t
 BINDING_ACK_PAYLOAD[] = "RC_RADIO";
 
+#if RC_RADIO_RELAY
+// The relay's slot moves back by RX_SAFETY_US after a miss, like the upstream
+// window, and has to be over before that window opens at the highest rate.
+STATIC_ASSERT(RX_SAFETY_US < RELAY_TX_DELAY_US);
+STATIC_ASSERT((RELAY_TX_DELAY_US + RELAY_SLOT_US) <
+              ((1000000UL / MAX_TX_RATE_HZ) -
+                   OVERHEAD_US - PKT_LEN_US - RX_WIDENING_US));
+
+// Every payload that is forwarded has to be on air within the slot.
+STATIC_ASSERT(AIR_US(sizeof(rc_radio_data_t)) <= RELAY_SLOT_US);
+STATIC_ASSERT(AIR_US(sizeof(rc_radio_aux_data_t)) <= RELAY_SLOT_US);
+STATIC_ASSERT((AIR_US(sizeof(rc_radio_bind_info_t)) +
+                   AIR_US(sizeof(BINDING_ACK_PAYLOAD))) <= RELAY_SLOT_US);
+#endif
+
 
 static nrf_esb_payload_t              m_rx_payload;
 static nrf_esb_payload_t              m_tx_payload;
 
-static nrf_esb_mode_t                 m_mode;
-static rc_radio_event_handler_t       m_callback;
-static nrf_drv_timer_t                m_timer;
 static bool                           m_hfclk_was_running;
-static uint8_t                        m_tx_data_index;
-static rc_radio_data_t                m_tx_data[DATA_BUFF_COUNT];
 
-static volatile rc_radio_state_t      m_state=RC_RADIO_STATE_DISABLED;
-static volatile rc_radio_bind_info_t  m_bind_info;
-static volatile uint32_t              m_missed_packets;
-static volatile uint8_t               m_channel_index;
+// The instance that nrf_esb is currently initialized for.
+static rc_radio_ctx_t * volatile      m_p_radio_ctx;
+
+// The instance used by the functions without a context.
+static rc_radio_ctx_t                 m_ctx;
+
+#if RC_RADIO_DEFERRED_EVENTS
+static event_entry_t                  m_event_queue[RC_RADIO_EVENT_QUEUE_LEN];
+static volatile uint32_t              m_event_head;
+static volatile uint32_t              m_event_tail;
+#endif
+
+#if RC_RADIO_ZERO_COPY_RX
+static nrf_esb_payload_t              m_rx_pool[RC_RADIO_RX_POOL_LEN];
+static volatile uint32_t              m_rx_pool_free;     // Bit per buffer
+static volatile uint32_t              m_rx_pool_retained; // Bit per buffer
+#endif
+
+#if RC_RADIO_ISR_STATS
+static rc_radio_isr_stats_t           m_isr_stats[RC_RADIO_ISR_COUNT];
+static uint32_t                       m_callback_budget;
+#endif
+
+#if (RC_RADIO_PROBE_DWT == RC_RADIO_PROBE)
+rc_radio_probe_log_t                  rc_radio_probe_log;
+#endif
+
+
+static uint32_t m_radio_start(rc_radio_ctx_t * p_ctx);
+static uint32_t m_esb_init(rc_radio_ctx_t * p_ctx);
+
+
+static inline uint32_t m_channel_lookup(rc_radio_ctx_t * p_ctx)
+{
+    return CHANNEL_MAP[p_ctx->bind_info.transmitter_channel]
+                      [p_ctx->channel_index];
+}
+
+
+static inline void m_channel_increment(rc_radio_ctx_t * p_ctx)
+{
+    p_ctx->channel_index = ((p_ctx->channel_index + 1) % CHANNEL_MAP_LEN);
+
+    RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_HOP, (uint16_t)m_channel_lookup(p_ctx));
+}
+
+
+#if RC_RADIO_ISR_STATS
+static void m_stats_add(rc_radio_isr_t isr, uint32_t ticks)
+{
+    rc_radio_isr_stats_t * p_stats = &m_isr_stats[isr];
+    uint32_t               bin;
+
+    bin = ((0 == ticks) ? 0 : (31 - __builtin_clz(ticks)));
+    if (RC_RADIO_ISR_HISTOGRAM_BINS <= bin)
+    {
+        bin = (RC_RADIO_ISR_HISTOGRAM_BINS - 1);
+    }
+
+    // The callback stats aren't only updated from the handlers. The
+    // callbacks also run from rc_radio_data_set and, with
+    // RC_RADIO_DEFERRED_EVENTS, from the event SWI, and either can be
+    // preempted by a handler that invokes a callback as well.
+    CRITICAL_REGION_ENTER();
+
+    if ((0 == p_stats->count) || (ticks < p_stats->min_ticks))
+    {
+        p_stats->min_ticks = ticks;
+    }
+
+    if (ticks > p_stats->max_ticks)
+    {
+        p_stats->max_ticks = ticks;
+    }
+
+    p_stats->count++;
+    p_stats->total_ticks += ticks;
+    p_stats->histogram[bin]++;
+
+    CRITICAL_REGION_EXIT();
+}
+#endif
+
+
+#if RC_RADIO_ZERO_COPY_RX
+static void m_mask_update(volatile uint32_t * p_mask,
+                              uint32_t set_bits,
+                              uint32_t clear_bits)
+{
+    uint32_t mask;
+
+    do
+    {
+        mask = __LDREXW(p_mask);
+    } while (0 != __STREXW(((mask | set_bits) & ~clear_bits), p_mask));
+}
 
 
-static uint32_t m_radio_start(void);
+// Returns RC_RADIO_RX_POOL_LEN if p_data isn't the payload of a pool buffer.
+static uint32_t m_rx_buffer_index(const void * p_data)
+{
+    uint32_t i;
 
+    for (i = 0; i < RC_RADIO_RX_POOL_LEN; i++)
+    {
+        if (p_data == m_rx_pool[i].data)
+        {
+            break;
+        }
+    }
 
-static inline uint32_t m_channel_lookup(void)
+    return i;
+}
+
+
+// Returns m_rx_payload if every buffer is in use. The packet still needs to
+// be read out of the nrf_esb FIFO in that case.
+static nrf_esb_payload_t * m_rx_buffer_alloc(void)
 {
-    return CHANNEL_MAP[m_bind_info.transmitter_channel][m_channel_index];
+    uint32_t mask;
+    uint32_t i;
+
+    do
+    {
+        mask = __LDREXW(&m_rx_pool_free);
+
+        if (0 == mask)
+        {
+            __CLREX();
+            return &m_rx_payload;
+        }
+
+        i = __builtin_ctz(mask);
+    } while (0 != __STREXW((mask & ~(1UL << i)), &m_rx_pool_free));
+
+    return &m_rx_pool[i];
 }
 
 
-static inline void m_channel_increment(void)
+// Called once the payload has been delivered (or couldn't be queued).
+static void m_rx_buffer_done(const void * p_data)
 {
-    m_channel_index = ((m_channel_index + 1) % CHANNEL_MAP_LEN);
+    uint32_t i = m_rx_buffer_index(p_data);
+
+    if ((RC_RADIO_RX_POOL_LEN > i) && (0 == (m_rx_pool_retained & (1UL << i))))
+    {
+        m_mask_update(&m_rx_pool_free, (1UL << i), 0);
+    }
 }
+#else
+#define m_rx_buffer_done(p_data)
+#endif
 
 
-static inline uint32_t m_timer_interval_calc(void)
+// The transmitter's callback can be NULL.
+static void m_callback_invoke(rc_radio_ctx_t * p_ctx,
+                                  rc_radio_event_t event,
+                                  const void * p_context)
 {
-    return (1000000UL / m_bind_info.transmit_rate_hz);
+#if RC_RADIO_ISR_STATS
+    uint32_t start;
+    uint32_t ticks;
+#endif
+
+    if (NULL == p_ctx->callback)
+    {
+        m_rx_buffer_done(p_context);
+        return;
+    }
+
+#if RC_RADIO_ISR_STATS
+    start = RC_RADIO_STATS_CLOCK();
+#endif
+
+    RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_CALLBACK_ENTER, event);
+    p_ctx->callback(event, p_context);
+    RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_CALLBACK_EXIT, event);
+
+    m_rx_buffer_done(p_context);
+
+#if RC_RADIO_ISR_STATS
+    ticks = (RC_RADIO_STATS_CLOCK() - start);
+    m_stats_add(RC_RADIO_ISR_CALLBACK, ticks);
+
+    if ((0 != m_callback_budget) &&
+            (m_callback_budget < ticks) &&
+            (RC_RADIO_EVENT_CALLBACK_OVERRUN != event))
+    {
+        rc_radio_callback_overrun_t overrun;
+
+        overrun.event = event;
+        overrun.ticks = ticks;
+
+        m_callback_invoke(p_ctx, RC_RADIO_EVENT_CALLBACK_OVERRUN, &overrun);
+    }
+#endif
+}
+
+
+#if RC_RADIO_DEFERRED_EVENTS
+static uint32_t m_event_context_len(rc_radio_event_t event)
+{
+    switch (event)
+    {
+    case RC_RADIO_EVENT_BOUND:
+        return sizeof(rc_radio_bind_info_t);
+#if !RC_RADIO_ZERO_COPY_RX
+    case RC_RADIO_EVENT_DATA_RECEIVED:
+        return sizeof(rc_radio_data_t);
+    case RC_RADIO_EVENT_AUX_RECEIVED:
+        return sizeof(rc_radio_aux_data_t);
+#endif
+    default:
+        return 0;
+    }
 }
 
 
-static inline uint32_t m_write_bind_info_pl(void)
+void RC_RADIO_EVENT_IRQHandler(void)
+{
+    event_entry_t * p_entry;
+
+    while (m_event_tail != m_event_head)
+    {
+        p_entry = &m_event_queue[m_event_tail & EVENT_QUEUE_MASK];
+
+        if (m_event_tail != p_entry->seq)
+        {
+            // Still being written by an interrupt that this preempted.
+            break;
+        }
+
+        m_callback_invoke(p_entry->p_ctx, p_entry->event, p_entry->p_context);
+
+        m_event_tail++;
+    }
+}
+#endif
+
+
+static void m_event_deliver(rc_radio_ctx_t * p_ctx,
+                                rc_radio_event_t event,
+                                const void * p_context)
+{
+#if RC_RADIO_DEFERRED_EVENTS
+    event_entry_t * p_entry;
+    uint32_t        index;
+
+    if (NULL == p_ctx->callback)
+    {
+        return;
+    }
+
+    // The same reservation as the binary trace: the events are posted from
+    // the interrupt handlers as well as from rc_radio_data_set.
+    do
+    {
+        index = __LDREXW(&m_event_head);
+
+        if (RC_RADIO_EVENT_QUEUE_LEN <= (index - m_event_tail))
+        {
+            __CLREX();
+            m_rx_buffer_done(p_context);
+            return;
+        }
+    } while (0 != __STREXW((index + 1), &m_event_head));
+
+    p_entry            = &m_event_queue[index & EVENT_QUEUE_MASK];
+    p_entry->p_ctx     = p_ctx;
+    p_entry->event     = event;
+    p_entry->p_context = p_context;
+
+    // Pooled payloads are passed on as they are.
+    if (0 != m_event_context_len(event))
+    {
+        memcpy(&p_entry->context, p_context, m_event_context_len(event));
+        p_entry->p_context = &p_entry->context;
+    }
+
+    __DMB();
+    p_entry->seq = index;
+
+    NVIC_SetPendingIRQ(RC_RADIO_EVENT_IRQn);
+#else
+    m_callback_invoke(p_ctx, event, p_context);
+#endif
+}
+
+
+static inline uint32_t m_timer_interval_calc(rc_radio_ctx_t * p_ctx)
+{
+    return (1000000UL / p_ctx->bind_info.transmit_rate_hz);
+}
+
+
+// Returns true if the receiver stays in sync with a transmitter that sends a
+// keepalive every keepalive_interval intervals. After a lost keepalive it goes
+// without a packet for two of them: the link has to survive that, and the
+// clocks can only drift apart by half of RX_SAFETY_US in that time (the other
+// half is for the latency of the interrupts).
+static bool m_keepalive_interval_valid(uint16_t transmit_rate_hz,
+                                           uint32_t keepalive_interval)
+{
+    uint64_t gap_us;
+
+    gap_us = ((2ULL * keepalive_interval * 1000000UL) / transmit_rate_hz);
+
+    return (((2 * keepalive_interval) <= RC_RADIO_MISSED_PACKET_TOLERANCE) &&
+            (gap_us <= KEEPALIVE_MAX_US));
+}
+
+
+static inline uint32_t m_delta(int32_t a, int32_t b)
+{
+    return (uint32_t)((a > b) ? (a - b) : (b - a));
+}
+
+
+// This needs to be kept in step with rc_radio_data_t.
+static bool m_data_changed(const rc_radio_data_t * p_new,
+                               const rc_radio_data_t * p_old)
+{
+    return ((RC_RADIO_CHANGE_THRESHOLD < m_delta(p_new->throttle,
+                                                     p_old->throttle)) ||
+            (RC_RADIO_CHANGE_THRESHOLD < m_delta(p_new->pitch,
+                                                     p_old->pitch)) ||
+            (RC_RADIO_CHANGE_THRESHOLD < m_delta(p_new->roll,
+                                                     p_old->roll)) ||
+            (RC_RADIO_CHANGE_THRESHOLD < m_delta(p_new->yaw,
+                                                     p_old->yaw)) ||
+            (p_new->switches != p_old->switches));
+}
+
+
+// Returns true if the transmitter has nothing to send in this interval.
+static inline bool m_tx_interval_idle(rc_radio_ctx_t * p_ctx)
+{
+    if (p_ctx->tx_pending || (0 == p_ctx->bind_info.keepalive_interval))
+    {
+        return false;
+    }
+
+    return (0 != --p_ctx->keepalive_countdown);
+}
+
+
+static inline uint32_t m_write_bind_info_pl(rc_radio_ctx_t * p_ctx)
 {
     m_tx_payload.length = sizeof(rc_radio_bind_info_t);
     m_tx_payload.noack  = false;
     memcpy(m_tx_payload.data,
-               (uint8_t*)&m_bind_info,
+               (uint8_t*)&p_ctx->bind_info,
                sizeof(rc_radio_bind_info_t));
 
     return nrf_esb_write_payload(&m_tx_payload);
@@ -135,21 +526,123 @@ static inline uint8_t m_write_ack_pl(void)
 }
 
 
-static void m_timer_handler(nrf_timer_event_t event_type, void * p_context)
+#if RC_RADIO_RELAY
+// nrf_esb has to be initialized again to switch a relay between receiving
+// from upstream and transmitting downstream. The events that it delivers
+// then go to p_ctx.
+static void m_relay_switch(rc_radio_ctx_t * p_ctx)
 {
-#if ENABLE_GPIO_DBG
-    nrf_gpio_pin_set(GPIO_DBG_PIN_1);
+    const uint8_t * addr;
+
+    (void)nrf_esb_disable();
+
+    m_p_radio_ctx = p_ctx;
+
+    // This leaves the radio on the bind address and channel.
+    APP_ERROR_CHECK(m_esb_init(p_ctx));
+
+    if (RC_RADIO_STATE_STARTED == p_ctx->state)
+    {
+        addr = ADDRESSES[p_ctx->bind_info.transmitter_channel];
+
+        APP_ERROR_CHECK(nrf_esb_set_base_address_0(addr));
+        APP_ERROR_CHECK(nrf_esb_set_prefixes(&addr[ADDR_LEN - 1], 1));
+        APP_ERROR_CHECK(nrf_esb_set_tx_power(RC_RADIO_TX_POWER));
+        APP_ERROR_CHECK(nrf_esb_set_rf_channel(m_channel_lookup(p_ctx)));
+    }
+}
+
+
+// Called with the upstream side of a relay when its slot starts.
+static void m_relay_slot_start(rc_radio_ctx_t * p_ctx)
+{
+    rc_radio_ctx_t * p_down = p_ctx->p_relay;
+
+    if (!p_down->tx_pending)
+    {
+        // Nothing was received from upstream in this interval so the
+        // downstream receiver misses a packet too. It hops regardless.
+        if (RC_RADIO_STATE_STARTED == p_down->state)
+        {
+            m_channel_increment(p_down);
+        }
+        return;
+    }
+
+    m_relay_switch(p_down);
+
+    // Writing a payload starts the transmission immediately.
+    if (RC_RADIO_STATE_BINDING == p_down->state)
+    {
+        RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_TX_START, BIND_CHANNEL);
+        APP_ERROR_CHECK(m_write_bind_info_pl(p_down));
+    }
+    else
+    {
+        RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_TX_START,
+                               (uint16_t)m_channel_lookup(p_down));
+        APP_ERROR_CHECK(nrf_esb_write_payload(&p_down->tx_data_pl[0]));
+    }
+}
+
+
+// Called with the upstream side of a relay when its slot ends.
+static void m_relay_slot_end(rc_radio_ctx_t * p_ctx)
+{
+    // A packet is only forwarded in the interval that it was received in.
+    // This also drops the flag that is set when the bind packet is ACK'd.
+    p_ctx->p_relay->tx_pending = false;
+
+    if (p_ctx != m_p_radio_ctx)
+    {
+        m_relay_switch(p_ctx);
+    }
+}
+
+
+// Moves the relay's slot along with the upstream window.
+static void m_relay_slot_move(rc_radio_ctx_t * p_ctx, int32_t delta_us)
+{
+    uint32_t ticks;
+
+    ticks = nrf_drv_timer_capture_get(&p_ctx->timer, NRF_TIMER_CC_CHANNEL2);
+    nrf_timer_cc_write(p_ctx->timer.p_reg,
+                           NRF_TIMER_CC_CHANNEL2,
+                           (ticks + delta_us));
+
+    ticks = nrf_drv_timer_capture_get(&p_ctx->timer, NRF_TIMER_CC_CHANNEL3);
+    nrf_timer_cc_write(p_ctx->timer.p_reg,
+                           NRF_TIMER_CC_CHANNEL3,
+                           (ticks + delta_us));
+}
+#else
+#define m_relay_slot_start(p_ctx)
+#define m_relay_slot_end(p_ctx)
+#define m_relay_slot_move(p_ctx, delta_us)
 #endif
 
+
+static void m_timer_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    rc_radio_ctx_t * p_ctx = (rc_radio_ctx_t*)p_context;
+
+    STATS_START();
+
+    RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_TIMER_ISR_ENTER, 0);
+
     switch (event_type)
     {
     case NRF_TIMER_EVENT_COMPARE0:
-        if (NRF_ESB_MODE_PTX == m_mode)
+        if (NRF_ESB_MODE_PTX == p_ctx->mode)
         {
             // Writing a payload starts the transmission immediately.
-            if (RC_RADIO_STATE_BINDING == m_state)
+            if (RC_RADIO_STATE_BINDING == p_ctx->state)
             {
-                uint32_t err_code = m_write_bind_info_pl();
+                uint32_t err_code;
+
+                RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_TX_START, BIND_CHANNEL);
+
+                err_code = m_write_bind_info_pl(p_ctx);
 
                 if (NRF_ERROR_NO_MEM == err_code)
                 {
@@ -160,70 +653,114 @@ static void m_timer_handler(nrf_timer_event_t event_type, void * p_context)
                     APP_ERROR_CHECK(err_code);
                 }
             }
+            else if (m_tx_interval_idle(p_ctx))
+            {
+                // Nothing has changed so nothing is sent. The channel still
+                // hops so that the receiver, which hops at the end of every
+                // interval, stays on the same one.
+                m_channel_increment(p_ctx);
+                nrf_esb_set_rf_channel(m_channel_lookup(p_ctx));
+            }
+            else if ((RC_RADIO_AUX_BUFF_COUNT > p_ctx->aux_data_index) &&
+                         (0 == --p_ctx->aux_countdown))
+            {
+                p_ctx->aux_countdown       = RC_RADIO_AUX_INTERVAL;
+                p_ctx->keepalive_countdown =
+                    p_ctx->bind_info.keepalive_interval;
+
+                RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_TX_START,
+                                       (uint16_t)m_channel_lookup(p_ctx));
+
+                APP_ERROR_CHECK(nrf_esb_write_payload(
+                                &p_ctx->aux_data_pl[p_ctx->aux_data_index]));
+            }
             else
             {
-                m_tx_payload.length = sizeof(rc_radio_data_t);
-                m_tx_payload.noack  = true;
-                memcpy(&m_tx_payload.data[0],
-                           (uint8_t*)&m_tx_data[m_tx_data_index],
-                           sizeof(rc_radio_data_t));
-                APP_ERROR_CHECK(nrf_esb_write_payload(&m_tx_payload));
+                // The payload was staged by rc_radio_data_set. The buffer
+                // stays untouched until another one has been sent because
+                // rc_radio_data_set compares the new data against it.
+                p_ctx->tx_pending          = false;
+                p_ctx->keepalive_countdown =
+                    p_ctx->bind_info.keepalive_interval;
+                p_ctx->tx_sent_index       = p_ctx->tx_data_index;
+
+                RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_TX_START,
+                                       (uint16_t)m_channel_lookup(p_ctx));
+
+                APP_ERROR_CHECK(nrf_esb_write_payload(
+                                    &p_ctx->tx_data_pl[p_ctx->tx_sent_index]));
             }
         }
         else
         {
+            RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_RX_WINDOW_OPEN, 0);
             APP_ERROR_CHECK(nrf_esb_start_rx());
         }
         break;
     case NRF_TIMER_EVENT_COMPARE2:
-#if ENABLE_GPIO_DBG
-        nrf_gpio_pin_clear(GPIO_DBG_PIN_1);
-        nrf_gpio_pin_set(GPIO_DBG_PIN_1);
-        nrf_gpio_pin_clear(GPIO_DBG_PIN_1);
-        nrf_gpio_pin_set(GPIO_DBG_PIN_1);
-#endif
-
+        if (NULL != p_ctx->p_relay)
+        {
+            m_relay_slot_end(p_ctx);
+            break;
+        }
+        RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_RX_WINDOW_OPEN, 0);
         APP_ERROR_CHECK(nrf_esb_start_rx());
         break;
+    case NRF_TIMER_EVENT_COMPARE3:
+        // Only used by a relay.
+        m_relay_slot_start(p_ctx);
+        break;
     case NRF_TIMER_EVENT_COMPARE1:
-#if ENABLE_GPIO_DBG
-        nrf_gpio_pin_clear(GPIO_DBG_PIN_1);
-        nrf_gpio_pin_set(GPIO_DBG_PIN_1);
-#endif
+        RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_RX_WINDOW_CLOSE, 0);
 
-        m_missed_packets++;
+        p_ctx->missed_packets++;
 
-        if (RC_RADIO_MISSED_PACKET_TOLERANCE > m_missed_packets)
+        if (RC_RADIO_MISSED_PACKET_TOLERANCE > p_ctx->missed_packets)
         {
-            if (1 == m_missed_packets)
+            if (1 == p_ctx->missed_packets)
             {
                 uint32_t ticks;
 
-                ticks = nrf_drv_timer_capture_get(&m_timer, NRF_TIMER_CC_CHANNEL0);
-                nrf_timer_cc_write(m_timer.p_reg,
+                ticks = nrf_drv_timer_capture_get(&p_ctx->timer,
+                                                      NRF_TIMER_CC_CHANNEL0);
+                nrf_timer_cc_write(p_ctx->timer.p_reg,
                                        NRF_TIMER_CC_CHANNEL0,
                                        (ticks - RX_SAFETY_US));
 
-                ticks = nrf_drv_timer_capture_get(&m_timer, NRF_TIMER_CC_CHANNEL1);
-                nrf_timer_cc_write(m_timer.p_reg,
+                ticks = nrf_drv_timer_capture_get(&p_ctx->timer,
+                                                      NRF_TIMER_CC_CHANNEL1);
+                nrf_timer_cc_write(p_ctx->timer.p_reg,
                                        NRF_TIMER_CC_CHANNEL1,
                                        (ticks - RX_SAFETY_US));
+
+                if (NULL != p_ctx->p_relay)
+                {
+                    m_relay_slot_move(p_ctx, -(int32_t)RX_SAFETY_US);
+                }
             }
 
-            m_channel_increment();
+            m_channel_increment(p_ctx);
 
             APP_ERROR_CHECK(nrf_esb_stop_rx());
-            APP_ERROR_CHECK(nrf_esb_set_rf_channel(m_channel_lookup()));
-
-            m_callback(RC_RADIO_EVENT_PACKET_DROPPED, NULL);
+            APP_ERROR_CHECK(nrf_esb_set_rf_channel(m_channel_lookup(p_ctx)));
+
+            // Nothing is expected between keepalives if the data hasn't
+            // changed so only the intervals in which a keepalive was due are
+            // counted as drops.
+            if ((0 == p_ctx->bind_info.keepalive_interval) ||
+                    (0 == (p_ctx->missed_packets %
+                               p_ctx->bind_info.keepalive_interval)))
+            {
+                m_event_deliver(p_ctx, RC_RADIO_EVENT_PACKET_DROPPED, NULL);
+            }
         }
         else
         {
             // The transmitter has gone away.
-            nrf_drv_timer_disable(&m_timer);
+            nrf_drv_timer_disable(&p_ctx->timer);
             APP_ERROR_CHECK(nrf_esb_stop_rx());
 
-            m_callback(RC_RADIO_EVENT_PACKET_DROPPED, NULL);
+            m_event_deliver(p_ctx, RC_RADIO_EVENT_PACKET_DROPPED, NULL);
 
             // NOTE: Calling m_esb_init seems like a good idea. Unfortunately,
             //       that sometimes causes a situation where the receiver does
@@ -234,17 +771,17 @@ static void m_timer_handler(nrf_timer_event_t event_type, void * p_context)
             APP_ERROR_CHECK(m_write_ack_pl());
             APP_ERROR_CHECK(nrf_esb_start_rx());
 
-            m_state = RC_RADIO_STATE_BINDING;
-            m_callback(RC_RADIO_EVENT_BINDING, NULL);
+            p_ctx->state = RC_RADIO_STATE_BINDING;
+            m_event_deliver(p_ctx, RC_RADIO_EVENT_BINDING, NULL);
         }
         break;
     default:
         break;
     }
 
-#if ENABLE_GPIO_DBG
-    nrf_gpio_pin_clear(GPIO_DBG_PIN_1);
-#endif
+    RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_TIMER_ISR_EXIT, 0);
+
+    STATS_STOP(RC_RADIO_ISR_TIMER);
 }
 
 
@@ -261,7 +798,41 @@ static inline bool m_reciver_ackd(void)
 }
 
 
-static inline void m_bind_info_received(void)
+#if RC_RADIO_RELAY
+// Sets up the relay's slot once the upstream link is bound. The downstream
+// link then (re)binds with the upstream link's rate.
+static void m_relay_bind(rc_radio_ctx_t * p_ctx)
+{
+    rc_radio_ctx_t * p_down = p_ctx->p_relay;
+
+    // CC3 starts the slot in which the radio is used for the downstream link
+    // and CC2 ends it. Both move with the window after a miss.
+    nrf_drv_timer_compare(&p_ctx->timer,
+                              NRF_TIMER_CC_CHANNEL3,
+                              RELAY_TX_DELAY_US,
+                              true);
+    nrf_drv_timer_compare(&p_ctx->timer,
+                              NRF_TIMER_CC_CHANNEL2,
+                              (RELAY_TX_DELAY_US + RELAY_SLOT_US),
+                              true);
+
+    nrf_timer_event_clear(p_ctx->timer.p_reg, NRF_TIMER_EVENT_COMPARE2);
+    nrf_timer_event_clear(p_ctx->timer.p_reg, NRF_TIMER_EVENT_COMPARE3);
+
+    p_down->bind_info.transmit_rate_hz   = p_ctx->bind_info.transmit_rate_hz;
+    p_down->bind_info.keepalive_interval = p_ctx->bind_info.keepalive_interval;
+    p_down->channel_index                = 0;
+    p_down->tx_pending                   = false;
+    p_down->state                        = RC_RADIO_STATE_BINDING;
+
+    m_event_deliver(p_down, RC_RADIO_EVENT_BINDING, NULL);
+}
+#else
+#define m_relay_bind(p_ctx)
+#endif
+
+
+static inline void m_bind_info_received(rc_radio_ctx_t * p_ctx)
 {
     uint32_t             interval_us;
     uint32_t             ticks;
@@ -278,26 +849,29 @@ static inline void m_bind_info_received(void)
 
     if ((RC_RADIO_TRANSMITTER_CHANNEL_COUNT <= p_info->transmitter_channel) ||
             (MIN_TX_RATE_HZ > p_info->transmit_rate_hz) ||
-            (MAX_TX_RATE_HZ < p_info->transmit_rate_hz))
+            (MAX_TX_RATE_HZ < p_info->transmit_rate_hz) ||
+            !m_keepalive_interval_valid(p_info->transmit_rate_hz,
+                                            p_info->keepalive_interval))
     {
         m_write_ack_pl();
         return;
     }
 
-    m_bind_info.transmitter_channel = p_info->transmitter_channel;
-    m_bind_info.transmit_rate_hz    = p_info->transmit_rate_hz;
-    m_channel_index                 = 0;
-    m_missed_packets                = 0;
+    p_ctx->bind_info.transmitter_channel = p_info->transmitter_channel;
+    p_ctx->bind_info.transmit_rate_hz    = p_info->transmit_rate_hz;
+    p_ctx->bind_info.keepalive_interval  = p_info->keepalive_interval;
+    p_ctx->channel_index                 = 0;
+    p_ctx->missed_packets                = 0;
 
     // CC0 fires when it's time to put the radio into receiver mode.
     // If a packet is received then the timer is cleared.
     //
     // If no packet is received, CC1 moves the receiver to the next channel.
 
-    interval_us = m_timer_interval_calc();
+    interval_us = m_timer_interval_calc(p_ctx);
     
     ticks = (interval_us + RX_SAFETY_US);
-    nrf_drv_timer_extended_compare(&m_timer,
+    nrf_drv_timer_extended_compare(&p_ctx->timer,
                                        NRF_TIMER_CC_CHANNEL1,
                                        ticks,
                                        NRF_TIMER_SHORT_COMPARE1_CLEAR_MASK,
@@ -307,16 +881,21 @@ static inline void m_bind_info_received(void)
                  OVERHEAD_US - 
                  PKT_LEN_US -
                  RX_WIDENING_US);
-    nrf_drv_timer_compare(&m_timer,
+    nrf_drv_timer_compare(&p_ctx->timer,
                               NRF_TIMER_CC_CHANNEL0,
                               ticks,
                               true);
 
     // Clear the events in case this is a re-binding event.
-    nrf_timer_event_clear(m_timer.p_reg, NRF_TIMER_EVENT_COMPARE0);
-    nrf_timer_event_clear(m_timer.p_reg, NRF_TIMER_EVENT_COMPARE1);
+    nrf_timer_event_clear(p_ctx->timer.p_reg, NRF_TIMER_EVENT_COMPARE0);
+    nrf_timer_event_clear(p_ctx->timer.p_reg, NRF_TIMER_EVENT_COMPARE1);
+
+    if (NULL != p_ctx->p_relay)
+    {
+        m_relay_bind(p_ctx);
+    }
 
-    nrf_drv_timer_enable(&m_timer);
+    nrf_drv_timer_enable(&p_ctx->timer);
 
     while (NRF_SUCCESS != nrf_esb_stop_rx())
     {
@@ -328,56 +907,103 @@ static inline void m_bind_info_received(void)
         //       another packet is received from the transmitter.
     }
 
-    addr = ADDRESSES[m_bind_info.transmitter_channel];
+    addr = ADDRESSES[p_ctx->bind_info.transmitter_channel];
 
     APP_ERROR_CHECK(nrf_esb_set_base_address_0(addr));
     APP_ERROR_CHECK(nrf_esb_set_prefixes(&addr[ADDR_LEN - 1], 1));
-    APP_ERROR_CHECK(nrf_esb_set_rf_channel(m_channel_lookup()));
+    APP_ERROR_CHECK(nrf_esb_set_rf_channel(m_channel_lookup(p_ctx)));
 
-    m_state = RC_RADIO_STATE_STARTED;
-    m_callback(RC_RADIO_EVENT_BOUND, (void*)&m_bind_info);
+    p_ctx->state = RC_RADIO_STATE_STARTED;
+    m_event_deliver(p_ctx, RC_RADIO_EVENT_BOUND, (void*)&p_ctx->bind_info);
 }
 
 
-static inline void m_data_received(void)
+static inline void m_data_received(rc_radio_ctx_t * p_ctx,
+                                       nrf_esb_payload_t * p_payload)
 {
-    if (sizeof(rc_radio_data_t) == m_rx_payload.length)
+    rc_radio_event_t event;
+
+    if (sizeof(rc_radio_data_t) == p_payload->length)
+    {
+        event = RC_RADIO_EVENT_DATA_RECEIVED;
+    }
+    else if (sizeof(rc_radio_aux_data_t) == p_payload->length)
     {
-        // Reset the timer to keep it in sync.
-        nrf_drv_timer_clear(&m_timer);
+        event = RC_RADIO_EVENT_AUX_RECEIVED;
+    }
+    else
+    {
+        m_rx_buffer_done(p_payload->data);
+        return;
+    }
 
-        m_channel_increment();
+    // Reset the timer to keep it in sync.
+    nrf_drv_timer_clear(&p_ctx->timer);
 
-        APP_ERROR_CHECK(nrf_esb_stop_rx());
-        APP_ERROR_CHECK(nrf_esb_set_rf_channel(m_channel_lookup()));
+    RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_RX_WINDOW_CLOSE, 1);
 
-        if (m_missed_packets)
-        {
-            uint32_t ticks;
+    m_channel_increment(p_ctx);
 
-            ticks = nrf_drv_timer_capture_get(&m_timer, NRF_TIMER_CC_CHANNEL0);
-            nrf_timer_cc_write(m_timer.p_reg,
-                                   NRF_TIMER_CC_CHANNEL0,
-                                   (ticks + RX_SAFETY_US));
+    APP_ERROR_CHECK(nrf_esb_stop_rx());
+    APP_ERROR_CHECK(nrf_esb_set_rf_channel(m_channel_lookup(p_ctx)));
+
+    if (p_ctx->missed_packets)
+    {
+        uint32_t ticks;
 
-            ticks = nrf_drv_timer_capture_get(&m_timer, NRF_TIMER_CC_CHANNEL1);
-            nrf_timer_cc_write(m_timer.p_reg,
-                                   NRF_TIMER_CC_CHANNEL1,
-                                   (ticks + RX_SAFETY_US));
+        ticks = nrf_drv_timer_capture_get(&p_ctx->timer, NRF_TIMER_CC_CHANNEL0);
+        nrf_timer_cc_write(p_ctx->timer.p_reg,
+                               NRF_TIMER_CC_CHANNEL0,
+                               (ticks + RX_SAFETY_US));
 
-            m_missed_packets = 0;
+        ticks = nrf_drv_timer_capture_get(&p_ctx->timer, NRF_TIMER_CC_CHANNEL1);
+        nrf_timer_cc_write(p_ctx->timer.p_reg,
+                               NRF_TIMER_CC_CHANNEL1,
+                               (ticks + RX_SAFETY_US));
+
+        if (NULL != p_ctx->p_relay)
+        {
+            m_relay_slot_move(p_ctx, RX_SAFETY_US);
         }
 
-        m_callback(RC_RADIO_EVENT_DATA_RECEIVED, m_rx_payload.data);
+        p_ctx->missed_packets = 0;
     }
+
+    if (NULL != p_ctx->p_relay)
+    {
+        // The payload is sent on as it is in this interval's slot. The slot
+        // is run by the timer handler, which has the same priority as the
+        // nrf_esb event handler (TIMER_ISR_PRIORITY) whether or not the
+        // events are deferred.
+        rc_radio_ctx_t * p_down = p_ctx->p_relay;
+
+        p_down->tx_data_pl[0].length = p_payload->length;
+        memcpy(p_down->tx_data_pl[0].data, p_payload->data, p_payload->length);
+        p_down->tx_pending = true;
+    }
+
+#if RC_RADIO_ZERO_COPY_RX
+    if (&m_rx_payload == p_payload)
+    {
+        // Every pool buffer is still in use so the packet could only be used
+        // to keep the timer in sync.
+        m_event_deliver(p_ctx, RC_RADIO_EVENT_PACKET_DROPPED, NULL);
+        return;
+    }
+#endif
+
+    m_event_deliver(p_ctx, event, p_payload->data);
 }
 
 
 static void m_nrf_esb_event_handler(nrf_esb_evt_t const * p_event)
 {
-#if ENABLE_GPIO_DBG
-    nrf_gpio_pin_set(GPIO_DBG_PIN_2);
-#endif
+    rc_radio_ctx_t *    p_ctx     = m_p_radio_ctx;
+    nrf_esb_payload_t * p_payload = &m_rx_payload;
+
+    STATS_START();
+
+    RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_ESB_ISR_ENTER, 0);
 
     switch (p_event->evt_id)
     {
@@ -385,19 +1011,16 @@ static void m_nrf_esb_event_handler(nrf_esb_evt_t const * p_event)
         // NOTE: The NRF_ESB_EVENT_TX_SUCCESS event will also be delivered for
         //       the receiver when it gets a packet after ACK'ing the bind
         //       packet.
-        if (NRF_ESB_MODE_PTX == m_mode)
+        if (NRF_ESB_MODE_PTX == p_ctx->mode)
         {
             // NOTE: The NRF_ESB_EVENT_TX_SUCCESS event is delivered before
             //       the NRF_ESB_EVENT_RX_RECEIVED event when binding.
-            if (RC_RADIO_STATE_STARTED == m_state)
+            if (RC_RADIO_STATE_STARTED == p_ctx->state)
             {
-                m_channel_increment();
-                nrf_esb_set_rf_channel(m_channel_lookup());
+                m_channel_increment(p_ctx);
+                nrf_esb_set_rf_channel(m_channel_lookup(p_ctx));
 
-                if (NULL != m_callback)
-                {
-                    m_callback(RC_RADIO_EVENT_DATA_SENT, NULL);
-                }
+                m_event_deliver(p_ctx, RC_RADIO_EVENT_DATA_SENT, NULL);
             }
         }
         break;
@@ -405,54 +1028,63 @@ static void m_nrf_esb_event_handler(nrf_esb_evt_t const * p_event)
         nrf_esb_flush_tx();
         break;
     case NRF_ESB_EVENT_RX_RECEIVED:
-        APP_ERROR_CHECK(nrf_esb_read_rx_payload(&m_rx_payload));
-        if (NRF_ESB_MODE_PRX == m_mode)
+#if RC_RADIO_ZERO_COPY_RX
+        if ((NRF_ESB_MODE_PRX == p_ctx->mode) &&
+                (RC_RADIO_STATE_STARTED == p_ctx->state))
+        {
+            p_payload = m_rx_buffer_alloc();
+        }
+#endif
+        APP_ERROR_CHECK(nrf_esb_read_rx_payload(p_payload));
+        if (NRF_ESB_MODE_PRX == p_ctx->mode)
         {
-            if (RC_RADIO_STATE_BINDING == m_state)
+            if (RC_RADIO_STATE_BINDING == p_ctx->state)
             {
-                m_bind_info_received();
+                m_bind_info_received(p_ctx);
             }
             else
             {
-                m_data_received();
+                m_data_received(p_ctx, p_payload);
             }
         }
         else if (m_reciver_ackd())
         {
             // A valid response to the bind packet was received so it's time
             // to move to the data address and channels.
-            const uint8_t * addr = ADDRESSES[m_bind_info.transmitter_channel];
+            const uint8_t * addr;
 
-            m_channel_index = 0;
+            addr = ADDRESSES[p_ctx->bind_info.transmitter_channel];
+
+            p_ctx->channel_index = 0;
+            p_ctx->tx_pending    = true;
 
             APP_ERROR_CHECK(nrf_esb_set_base_address_0(addr));
             APP_ERROR_CHECK(nrf_esb_set_prefixes(&addr[ADDR_LEN - 1], 1));
             APP_ERROR_CHECK(nrf_esb_set_tx_power(RC_RADIO_TX_POWER));
-            APP_ERROR_CHECK(nrf_esb_set_rf_channel(m_channel_lookup()));
+            APP_ERROR_CHECK(nrf_esb_set_rf_channel(m_channel_lookup(p_ctx)));
 
-            m_state = RC_RADIO_STATE_STARTED;
-            if (NULL != m_callback)
-            {
-                m_callback(RC_RADIO_EVENT_BOUND, (void*)&m_bind_info);
-            }
+            p_ctx->state = RC_RADIO_STATE_STARTED;
+            m_event_deliver(p_ctx,
+                                RC_RADIO_EVENT_BOUND,
+                                (void*)&p_ctx->bind_info);
         }
         break;
     }
 
-#if ENABLE_GPIO_DBG
-    nrf_gpio_pin_clear(GPIO_DBG_PIN_2);
-#endif
+    RC_RADIO_PROBE_HIT(RC_RADIO_PROBE_ESB_ISR_EXIT, 0);
+
+    STATS_STOP(RC_RADIO_ISR_ESB);
 }
 
 
-static uint32_t m_esb_init(void)
+static uint32_t m_esb_init(rc_radio_ctx_t * p_ctx)
 {
     uint32_t err_code;
  
     nrf_esb_config_t nrf_esb_config   = NRF_ESB_DEFAULT_CONFIG;
     nrf_esb_config.payload_length     = sizeof(rc_radio_data_t);
     nrf_esb_config.bitrate            = NRF_ESB_BITRATE_1MBPS;
-    nrf_esb_config.mode               = m_mode;
+    nrf_esb_config.mode               = p_ctx->mode;
     nrf_esb_config.event_handler      = m_nrf_esb_event_handler;
     nrf_esb_config.selective_auto_ack = true;
     nrf_esb_config.tx_output_power    = RC_RADIO_BINDING_TX_POWER;
@@ -519,15 +1151,15 @@ static void m_clocks_stop(void)
 }
 
 
-static uint32_t m_radio_start(void)
+static uint32_t m_radio_start(rc_radio_ctx_t * p_ctx)
 {
     uint32_t err_code;
 
-    m_state = RC_RADIO_STATE_BINDING;
+    p_ctx->state = RC_RADIO_STATE_BINDING;
 
-    if (NRF_ESB_MODE_PRX == m_mode)
+    if (NRF_ESB_MODE_PRX == p_ctx->mode)
     {
-        err_code = m_esb_init();
+        err_code = m_esb_init(p_ctx);
         if (NRF_SUCCESS != err_code)
         {
             return err_code;
@@ -547,51 +1179,53 @@ static uint32_t m_radio_start(void)
     }
     else
     {
-        uint32_t delay_us = m_timer_interval_calc();
+        uint32_t delay_us = m_timer_interval_calc(p_ctx);
 
-        err_code = m_esb_init();
+        err_code = m_esb_init(p_ctx);
         if (NRF_SUCCESS != err_code)
         {
             return err_code;
         }
 
-        err_code = m_write_bind_info_pl();
+        err_code = m_write_bind_info_pl(p_ctx);
         if (NRF_SUCCESS != err_code)
         {
             return err_code;
         }
 
-        nrf_drv_timer_extended_compare(&m_timer,
+        nrf_drv_timer_extended_compare(&p_ctx->timer,
                                            NRF_TIMER_CC_CHANNEL0,
                                            delay_us,
                                            NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK,
                                            true);
-        nrf_drv_timer_enable(&m_timer);
+        nrf_drv_timer_enable(&p_ctx->timer);
     }
 
-    if (NULL != m_callback)
-    {
-        m_callback(RC_RADIO_EVENT_BINDING, NULL);
-    }
+    m_event_deliver(p_ctx, RC_RADIO_EVENT_BINDING, NULL);
 
     return NRF_SUCCESS;
 }
 
 
-static uint32_t m_rc_radio_init(uint8_t timer_instance_index)
+static uint32_t m_rc_radio_init(rc_radio_ctx_t * p_ctx,
+                                    uint8_t timer_instance_index)
 {
     uint32_t               err_code;
     nrf_drv_timer_config_t timer_cfg;
+#if RC_RADIO_DEFERRED_EVENTS
+    uint32_t               i;
+#endif
 
     timer_cfg.mode               = TIMER_MODE_MODE_Timer;
     timer_cfg.frequency          = NRF_TIMER_FREQ_1MHz;
     timer_cfg.bit_width          = NRF_TIMER_BIT_WIDTH_32;
     timer_cfg.interrupt_priority = TIMER_ISR_PRIORITY;
+    timer_cfg.p_context          = p_ctx;
 
     // Only pipe 0 is used in this library.
     m_tx_payload.pipe = 0;
 
-    if (RC_RADIO_STATE_DISABLED != m_state)
+    if (RC_RADIO_STATE_DISABLED != p_ctx->state)
     {
         return NRF_ERROR_INVALID_STATE;
     }
@@ -599,42 +1233,63 @@ static uint32_t m_rc_radio_init(uint8_t timer_instance_index)
     switch (timer_instance_index)
     {
     case 0:
-        m_timer.p_reg            = NRF_TIMER0;
-        m_timer.instance_id      = TIMER0_INSTANCE_INDEX;
-        m_timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(0);
+        p_ctx->timer.p_reg            = NRF_TIMER0;
+        p_ctx->timer.instance_id      = TIMER0_INSTANCE_INDEX;
+        p_ctx->timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(0);
         break;
     case 1:
-        m_timer.p_reg            = NRF_TIMER1;
-        m_timer.instance_id      = TIMER1_INSTANCE_INDEX;
-        m_timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(1);
+        p_ctx->timer.p_reg            = NRF_TIMER1;
+        p_ctx->timer.instance_id      = TIMER1_INSTANCE_INDEX;
+        p_ctx->timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(1);
         break;
     case 2:
-        m_timer.p_reg            = NRF_TIMER2;
-        m_timer.instance_id      = TIMER2_INSTANCE_INDEX;
-        m_timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(2);
+        p_ctx->timer.p_reg            = NRF_TIMER2;
+        p_ctx->timer.instance_id      = TIMER2_INSTANCE_INDEX;
+        p_ctx->timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(2);
         break;
     case 3:
-        m_timer.p_reg            = NRF_TIMER3;
-        m_timer.instance_id      = TIMER3_INSTANCE_INDEX;
-        m_timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(3);
+        p_ctx->timer.p_reg            = NRF_TIMER3;
+        p_ctx->timer.instance_id      = TIMER3_INSTANCE_INDEX;
+        p_ctx->timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(3);
         break;
     case 4:
-        m_timer.p_reg            = NRF_TIMER4;
-        m_timer.instance_id      = TIMER4_INSTANCE_INDEX;
-        m_timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(4);
+        p_ctx->timer.p_reg            = NRF_TIMER4;
+        p_ctx->timer.instance_id      = TIMER4_INSTANCE_INDEX;
+        p_ctx->timer.cc_channel_count = NRF_TIMER_CC_CHANNEL_COUNT(4);
         break;
     default:
         return NRF_ERROR_INVALID_PARAM;
     }
 
-#if ENABLE_GPIO_DBG
-    nrf_gpio_cfg_output(GPIO_DBG_PIN_1);
-    nrf_gpio_cfg_output(GPIO_DBG_PIN_2);
-    nrf_gpio_pin_clear(GPIO_DBG_PIN_1);
-    nrf_gpio_pin_clear(GPIO_DBG_PIN_2);
+    RC_RADIO_PROBE_INIT();
+    RC_RADIO_STATS_CLOCK_INIT();
+
+    // The state shared by the instances is left alone while one is enabled.
+    if (NULL == m_p_radio_ctx)
+    {
+#if RC_RADIO_ZERO_COPY_RX
+        m_rx_pool_free     = ((RC_RADIO_RX_POOL_LEN < 32) ?
+                                  ((1UL << RC_RADIO_RX_POOL_LEN) - 1) :
+                                  0xFFFFFFFF);
+        m_rx_pool_retained = 0;
 #endif
 
-    err_code = nrf_drv_timer_init(&m_timer, &timer_cfg, m_timer_handler);
+#if RC_RADIO_DEFERRED_EVENTS
+        for (i = 0; i < RC_RADIO_EVENT_QUEUE_LEN; i++)
+        {
+            m_event_queue[i].seq = (i - RC_RADIO_EVENT_QUEUE_LEN);
+        }
+
+        m_event_head = 0;
+        m_event_tail = 0;
+
+        NVIC_ClearPendingIRQ(RC_RADIO_EVENT_IRQn);
+        NVIC_SetPriority(RC_RADIO_EVENT_IRQn, RC_RADIO_EVENT_IRQ_PRIORITY);
+        NVIC_EnableIRQ(RC_RADIO_EVENT_IRQn);
+#endif
+    }
+
+    err_code = nrf_drv_timer_init(&p_ctx->timer, &timer_cfg, m_timer_handler);
     if (NRF_SUCCESS != err_code)
     {
         return err_code;
@@ -644,61 +1299,103 @@ static uint32_t m_rc_radio_init(uint8_t timer_instance_index)
 }
 
 
-uint32_t rc_radio_transmitter_init(uint8_t timer_instance_index,
-                                       uint16_t transmit_rate_hz,
-                                       rc_radio_transmitter_channel_t channel,
-                                       rc_radio_event_handler_t callback)
+uint32_t rc_radio_ctx_transmitter_init(rc_radio_ctx_t * p_ctx,
+                                           uint8_t timer_instance_index,
+                                           uint16_t transmit_rate_hz,
+                                           rc_radio_transmitter_channel_t channel,
+                                           rc_radio_event_handler_t callback)
 {
+    uint32_t i;
+
     if ((MIN_TX_RATE_HZ>transmit_rate_hz) || (MAX_TX_RATE_HZ<transmit_rate_hz))
     {
         return NRF_ERROR_INVALID_PARAM;
     }
 
+    if (!m_keepalive_interval_valid(transmit_rate_hz,
+                                        RC_RADIO_KEEPALIVE_INTERVAL))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
     if (RC_RADIO_TRANSMITTER_CHANNEL_COUNT <= channel)
     {
         return NRF_ERROR_INVALID_PARAM;
     }
 
-    m_mode          = NRF_ESB_MODE_PTX;
-    m_callback      = callback;
-    m_tx_data_index = DATA_BUFF_COUNT;
+    p_ctx->mode           = NRF_ESB_MODE_PTX;
+    p_ctx->callback       = callback;
+    p_ctx->tx_data_index  = RC_RADIO_DATA_BUFF_COUNT;
+    p_ctx->tx_sent_index  = RC_RADIO_DATA_BUFF_COUNT;
+    p_ctx->aux_data_index = RC_RADIO_AUX_BUFF_COUNT;
+    p_ctx->aux_countdown  = RC_RADIO_AUX_INTERVAL;
 
-    m_bind_info.transmitter_channel = channel;
-    m_bind_info.transmit_rate_hz    = transmit_rate_hz;
+    // Only the data of the payloads changes after this.
+    for (i = 0; i < RC_RADIO_DATA_BUFF_COUNT; i++)
+    {
+        p_ctx->tx_data_pl[i].pipe   = 0;
+        p_ctx->tx_data_pl[i].noack  = true;
+        p_ctx->tx_data_pl[i].length = sizeof(rc_radio_data_t);
+    }
 
-    return m_rc_radio_init(timer_instance_index);
+    for (i = 0; i < RC_RADIO_AUX_BUFF_COUNT; i++)
+    {
+        p_ctx->aux_data_pl[i].pipe   = 0;
+        p_ctx->aux_data_pl[i].noack  = true;
+        p_ctx->aux_data_pl[i].length = sizeof(rc_radio_aux_data_t);
+    }
+
+    p_ctx->bind_info.transmitter_channel = channel;
+    p_ctx->bind_info.transmit_rate_hz    = transmit_rate_hz;
+    p_ctx->bind_info.keepalive_interval  = RC_RADIO_KEEPALIVE_INTERVAL;
+
+    return m_rc_radio_init(p_ctx, timer_instance_index);
 }
 
 
-uint32_t rc_radio_receiver_init(uint8_t timer_instance_index,
-                                    rc_radio_event_handler_t callback)
+uint32_t rc_radio_ctx_receiver_init(rc_radio_ctx_t * p_ctx,
+                                        uint8_t timer_instance_index,
+                                        rc_radio_event_handler_t callback)
 {
     if (NULL == callback)
     {
         return NRF_ERROR_INVALID_PARAM;
     }
  
-    m_mode     = NRF_ESB_MODE_PRX;
-    m_callback = callback;
+    p_ctx->mode     = NRF_ESB_MODE_PRX;
+    p_ctx->callback = callback;
 
-    return m_rc_radio_init(timer_instance_index);
+    return m_rc_radio_init(p_ctx, timer_instance_index);
 }
 
 
-uint32_t rc_radio_enable(void)
+uint32_t rc_radio_ctx_enable(rc_radio_ctx_t * p_ctx)
 {
     uint32_t err_code;
 
-    if (RC_RADIO_STATE_DISABLED != m_state)
+    if ((NULL != p_ctx->p_relay) && (NRF_ESB_MODE_PTX == p_ctx->mode))
+    {
+        // The upstream side of a relay runs both of them.
+        p_ctx = p_ctx->p_relay;
+    }
+
+    if (RC_RADIO_STATE_DISABLED != p_ctx->state)
     {
         return NRF_ERROR_INVALID_PARAM;
     }
 
+    if (NULL != m_p_radio_ctx)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    m_p_radio_ctx = p_ctx;
+
     m_clocks_start();
 
-    if (NRF_ESB_MODE_PRX == m_mode)
+    if (NRF_ESB_MODE_PRX == p_ctx->mode)
     {
-        err_code = m_radio_start();
+        err_code = m_radio_start(p_ctx);
         if (NRF_SUCCESS != err_code)
         {
             return err_code;
@@ -706,23 +1403,29 @@ uint32_t rc_radio_enable(void)
     }
     else
     {
-        m_state = RC_RADIO_STATE_ENABLED;
+        p_ctx->state = RC_RADIO_STATE_ENABLED;
     }
 
     return NRF_SUCCESS;
 }
 
 
-void rc_radio_disable(void)
+void rc_radio_ctx_disable(rc_radio_ctx_t * p_ctx)
 {
-    switch (m_state)
+    if ((NULL != p_ctx->p_relay) && (NRF_ESB_MODE_PTX == p_ctx->mode))
+    {
+        p_ctx = p_ctx->p_relay;
+    }
+
+    switch (p_ctx->state)
     {
     case RC_RADIO_STATE_DISABLED:
         return;
     case RC_RADIO_STATE_BINDING:
     case RC_RADIO_STATE_STARTED:
-        nrf_drv_timer_disable(&m_timer);
+        nrf_drv_timer_disable(&p_ctx->timer);
         (void)nrf_esb_disable();
+        // Fall through.
     case RC_RADIO_STATE_ENABLED:
         m_clocks_stop();
         break;
@@ -730,39 +1433,274 @@ void rc_radio_disable(void)
         break;
     }
 
-    m_state = RC_RADIO_STATE_DISABLED;
+    if (NULL != p_ctx->p_relay)
+    {
+        p_ctx->p_relay->state = RC_RADIO_STATE_DISABLED;
+    }
+
+    p_ctx->state  = RC_RADIO_STATE_DISABLED;
+    m_p_radio_ctx = NULL;
 }
 
 
-uint32_t rc_radio_data_set(const rc_radio_data_t * const p_data)
+uint32_t rc_radio_ctx_data_set(rc_radio_ctx_t * p_ctx,
+                                   const rc_radio_data_t * const p_data)
 {
-    // NOTE: m_tx_data_index is only updated after the memcpy has completed. This
-    //       is done to ensure that m_tx_data_index is always valid regardless of
+    // NOTE: tx_data_index is only updated after the memcpy has completed. This
+    //       is done to ensure that tx_data_index is always valid regardless of
     //       when this function is preempted by the timer interrupt handler.
     uint8_t index;
+    uint8_t sent_index;
+    bool    changed;
 
-    if (RC_RADIO_STATE_DISABLED == m_state)
+    if (RC_RADIO_STATE_DISABLED == p_ctx->state)
     {
         return NRF_ERROR_INVALID_STATE;
     }
 
-    if (NRF_ESB_MODE_PTX != m_mode)
+    // A relay only forwards what it receives.
+    if ((NRF_ESB_MODE_PTX != p_ctx->mode) || (NULL != p_ctx->p_relay))
     {
         return NRF_ERROR_INVALID_STATE;
     }
 
-    index = ((m_tx_data_index + 1) % DATA_BUFF_COUNT);
+    // The payload is written to the buffer that is neither staged nor the
+    // last one sent.
+    sent_index = p_ctx->tx_sent_index;
+    index      = ((p_ctx->tx_data_index + 1) % RC_RADIO_DATA_BUFF_COUNT);
+
+    if (index == sent_index)
+    {
+        index = ((index + 1) % RC_RADIO_DATA_BUFF_COUNT);
+    }
+
+    changed = ((RC_RADIO_DATA_BUFF_COUNT <= sent_index) ||
+               m_data_changed(p_data,
+                    (rc_radio_data_t*)p_ctx->tx_data_pl[sent_index].data));
 
-    memcpy((uint8_t*)&m_tx_data[index],
+    memcpy(p_ctx->tx_data_pl[index].data,
                (uint8_t*)p_data,
                sizeof(rc_radio_data_t));
 
-    m_tx_data_index = index;
+    p_ctx->tx_data_index = index;
+
+    // The flag is set after the index so the timer interrupt handler can't
+    // clear it while sending the previous data. If a payload was sent while
+    // comparing then the comparison might be stale so the data is sent
+    // regardless.
+    if (changed || (sent_index != p_ctx->tx_sent_index))
+    {
+        p_ctx->tx_pending = true;
+    }
+
+    if (RC_RADIO_STATE_ENABLED == p_ctx->state)
+    {
+        return m_radio_start(p_ctx);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t rc_radio_ctx_aux_data_set(rc_radio_ctx_t * p_ctx,
+                                       const rc_radio_aux_data_t * const p_aux_data)
+{
+    // NOTE: This is double-buffered like rc_radio_data_set.
+    uint8_t index;
+
+    if ((NRF_ESB_MODE_PTX != p_ctx->mode) || (NULL != p_ctx->p_relay))
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    index = ((p_ctx->aux_data_index + 1) % RC_RADIO_AUX_BUFF_COUNT);
 
-    if (RC_RADIO_STATE_ENABLED == m_state)
+    memcpy(p_ctx->aux_data_pl[index].data,
+               (uint8_t*)p_aux_data,
+               sizeof(rc_radio_aux_data_t));
+
+    p_ctx->aux_data_index = index;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t rc_radio_ctx_relay_init(rc_radio_ctx_t * p_upstream,
+                                     rc_radio_ctx_t * p_downstream,
+                                     uint8_t timer_instance_index,
+                                     rc_radio_transmitter_channel_t channel,
+                                     rc_radio_event_handler_t callback)
+{
+#if RC_RADIO_RELAY
+    uint32_t err_code;
+
+    if ((p_upstream == p_downstream) ||
+            (RC_RADIO_TRANSMITTER_CHANNEL_COUNT <= channel))
     {
-        return m_radio_start();
+        return NRF_ERROR_INVALID_PARAM;
     }
 
+    if (RC_RADIO_STATE_DISABLED != p_downstream->state)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    err_code = rc_radio_ctx_receiver_init(p_upstream,
+                                              timer_instance_index,
+                                              callback);
+    if (NRF_SUCCESS != err_code)
+    {
+        return err_code;
+    }
+
+    // The downstream side doesn't have a timer. Its rate is set when the
+    // upstream link binds and it only uses the first data payload.
+    p_downstream->mode                          = NRF_ESB_MODE_PTX;
+    p_downstream->callback                      = callback;
+    p_downstream->tx_data_pl[0].pipe            = 0;
+    p_downstream->tx_data_pl[0].noack           = true;
+    p_downstream->bind_info.transmitter_channel = channel;
+
+    p_upstream->p_relay   = p_downstream;
+    p_downstream->p_relay = p_upstream;
+
     return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+uint32_t rc_radio_transmitter_init(uint8_t timer_instance_index,
+                                       uint16_t transmit_rate_hz,
+                                       rc_radio_transmitter_channel_t channel,
+                                       rc_radio_event_handler_t callback)
+{
+    return rc_radio_ctx_transmitter_init(&m_ctx,
+                                             timer_instance_index,
+                                             transmit_rate_hz,
+                                             channel,
+                                             callback);
+}
+
+
+uint32_t rc_radio_receiver_init(uint8_t timer_instance_index,
+                                    rc_radio_event_handler_t callback)
+{
+    return rc_radio_ctx_receiver_init(&m_ctx, timer_instance_index, callback);
+}
+
+
+uint32_t rc_radio_enable(void)
+{
+    return rc_radio_ctx_enable(&m_ctx);
+}
+
+
+void rc_radio_disable(void)
+{
+    rc_radio_ctx_disable(&m_ctx);
+}
+
+
+uint32_t rc_radio_data_set(const rc_radio_data_t * const p_data)
+{
+    return rc_radio_ctx_data_set(&m_ctx, p_data);
+}
+
+
+uint32_t rc_radio_aux_data_set(const rc_radio_aux_data_t * const p_aux_data)
+{
+    return rc_radio_ctx_aux_data_set(&m_ctx, p_aux_data);
+}
+
+
+uint32_t rc_radio_isr_stats_get(rc_radio_isr_t isr,
+                                    rc_radio_isr_stats_t * p_stats)
+{
+#if RC_RADIO_ISR_STATS
+    if ((RC_RADIO_ISR_COUNT <= isr) || (NULL == p_stats))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    CRITICAL_REGION_ENTER();
+    memcpy(p_stats, &m_isr_stats[isr], sizeof(rc_radio_isr_stats_t));
+    CRITICAL_REGION_EXIT();
+
+    if (0 != p_stats->count)
+    {
+        p_stats->avg_ticks = (uint32_t)(p_stats->total_ticks / p_stats->count);
+    }
+
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+void rc_radio_isr_stats_reset(void)
+{
+#if RC_RADIO_ISR_STATS
+    CRITICAL_REGION_ENTER();
+    memset(m_isr_stats, 0, sizeof(m_isr_stats));
+    CRITICAL_REGION_EXIT();
+#endif
+}
+
+
+uint32_t rc_radio_callback_budget_set(uint32_t budget_ticks)
+{
+#if RC_RADIO_ISR_STATS
+    m_callback_budget = budget_ticks;
+
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+uint32_t rc_radio_rx_retain(const void * p_data)
+{
+#if RC_RADIO_ZERO_COPY_RX
+    uint32_t i = m_rx_buffer_index(p_data);
+
+    if (RC_RADIO_RX_POOL_LEN <= i)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    m_mask_update(&m_rx_pool_retained, (1UL << i), 0);
+
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+uint32_t rc_radio_rx_release(const void * p_data)
+{
+#if RC_RADIO_ZERO_COPY_RX
+    uint32_t i = m_rx_buffer_index(p_data);
+
+    if (RC_RADIO_RX_POOL_LEN <= i)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (0 == (m_rx_pool_retained & (1UL << i)))
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    m_mask_update(&m_rx_pool_retained, 0, (1UL << i));
+    m_mask_update(&m_rx_pool_free, (1UL << i), 0);
+
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
 }
@@ -2,6 +2,10 @@
 #define RC_RADIO_H
 
 #include "stdint.h"
+#include "stdbool.h"
+
+#include "nrf_esb.h"
+#include "nrf_drv_timer.h"
 
 
 // Any valid RADIO_TXPOWER_* values can be used.
@@ -14,10 +18,131 @@
 #endif
 #define RC_RADIO_BINDING_TX_POWER (RADIO_TXPOWER_TXPOWER_Neg12dBm)
 
-// This is the number of consecutive missed packets before the
-// receiver concludes that the transmitter has gone away.
+// This is the number of consecutive transmit intervals without a packet
+// before the receiver concludes that the transmitter has gone away.
 #define RC_RADIO_MISSED_PACKET_TOLERANCE (50UL)
 
+// Once rc_radio_aux_data_set has been called the transmitter sends the
+// auxiliary payload in place of every RC_RADIO_AUX_INTERVAL'th data payload.
+// Longer auxiliary payloads need NRF_ESB_MAX_PAYLOAD_LENGTH (up to 252) raised
+// to match on both ends.
+#define RC_RADIO_AUX_INTERVAL            (25UL)
+#ifndef RC_RADIO_AUX_DATA_LEN
+#define RC_RADIO_AUX_DATA_LEN            (19UL)
+#endif
+
+// When set to 1 (on both ends of the link) the channels of rc_radio_data_t
+// are 16 bits wide instead of 8 bits so that they can carry the full
+// resolution of the inputs.
+#ifndef RC_RADIO_HIGH_RES
+#define RC_RADIO_HIGH_RES                (0)
+#endif
+
+// When set to a non-zero number of transmit intervals the transmitter only
+// sends a data payload when rc_radio_data_set changes a channel by more than
+// RC_RADIO_CHANGE_THRESHOLD (or changes a switch). Otherwise it repeats the
+// last payload once every RC_RADIO_KEEPALIVE_INTERVAL intervals. It keeps
+// hopping every interval so the receiver follows it without any extra
+// signalling. The interval is sent to the receiver when binding so only the
+// transmitter needs to set it.
+//
+// A single lost keepalive leaves the receiver without a packet for two
+// keepalive intervals. The interval is therefore limited to half of
+// RC_RADIO_MISSED_PACKET_TOLERANCE so that the link stays up, and so that two
+// of them last at most 1.25 s: the receiver's timer runs freely in between and
+// the clocks mustn't drift out of the receive window (e.g. at most 6
+// intervals at 10 Hz and 12 at 20 Hz). rc_radio_transmitter_init returns
+// NRF_ERROR_INVALID_PARAM for a longer one. For the same reason two keepalive
+// intervals should be shorter than the receiver's failsafe timeout (e.g. at
+// most 12 intervals for 250 ms at 100 Hz).
+#ifndef RC_RADIO_KEEPALIVE_INTERVAL
+#define RC_RADIO_KEEPALIVE_INTERVAL      (0UL)
+#endif
+
+#ifndef RC_RADIO_CHANGE_THRESHOLD
+#if RC_RADIO_HIGH_RES
+#define RC_RADIO_CHANGE_THRESHOLD        (8UL)
+#else
+#define RC_RADIO_CHANGE_THRESHOLD        (0UL)
+#endif
+#endif
+
+// When set to 1 the execution time of the timer and nrf_esb event handlers
+// and of each callback is measured. See rc_radio_isr_stats_get.
+#ifndef RC_RADIO_ISR_STATS
+#define RC_RADIO_ISR_STATS               (0)
+#endif
+
+// When set to 1 the events are queued by the radio and timer interrupt
+// handlers and delivered to the callback from a software interrupt at
+// RC_RADIO_EVENT_IRQ_PRIORITY instead. The payloads are copied into the queue
+// so the pointers passed to the callback stay valid until it returns. Events
+// are lost if the callback falls RC_RADIO_EVENT_QUEUE_LEN events behind.
+//
+// Either way the callback is also invoked from rc_radio_enable and
+// rc_radio_data_set (RC_RADIO_EVENT_BINDING) so it doesn't always run at the
+// same priority. Anything that it shares with the other interrupts needs to
+// be protected.
+#ifndef RC_RADIO_DEFERRED_EVENTS
+#define RC_RADIO_DEFERRED_EVENTS         (0)
+#endif
+
+#define RC_RADIO_EVENT_QUEUE_LEN         (8UL) // Must be a power of two
+
+#ifndef RC_RADIO_EVENT_IRQn
+#define RC_RADIO_EVENT_IRQn              (SWI3_EGU3_IRQn)
+#define RC_RADIO_EVENT_IRQHandler        SWI3_EGU3_IRQHandler
+#endif
+
+#ifndef RC_RADIO_EVENT_IRQ_PRIORITY
+#define RC_RADIO_EVENT_IRQ_PRIORITY      (6UL)
+#endif
+
+// The priority of the timer and nrf_esb event interrupts.
+#define RC_RADIO_IRQ_PRIORITY            (1UL)
+
+// The priority that the callback runs at (apart from the calls made from
+// rc_radio_enable and rc_radio_data_set). An interrupt that shares the
+// callback's state can run at the same priority instead of protecting it.
+#if RC_RADIO_DEFERRED_EVENTS
+#define RC_RADIO_CALLBACK_IRQ_PRIORITY   (RC_RADIO_EVENT_IRQ_PRIORITY)
+#else
+#define RC_RADIO_CALLBACK_IRQ_PRIORITY   (RC_RADIO_IRQ_PRIORITY)
+#endif
+
+// When set to 1 the receiver reads each packet into one of
+// RC_RADIO_RX_POOL_LEN buffers and the payload pointer given to the callback
+// (or queued when RC_RADIO_DEFERRED_EVENTS is set) points into that buffer, so
+// the payload is never copied again. The buffer goes back to the pool when
+// the callback returns unless rc_radio_rx_retain is called. Packets that
+// arrive while every buffer is in use are reported as dropped.
+#ifndef RC_RADIO_ZERO_COPY_RX
+#define RC_RADIO_ZERO_COPY_RX            (0)
+#endif
+
+#ifndef RC_RADIO_RX_POOL_LEN
+#define RC_RADIO_RX_POOL_LEN             (4UL)
+#endif
+
+// When set to 1 rc_radio_ctx_relay_init is available. nrf_esb can't switch
+// between PTX and PRX without being initialized again so a relay disables and
+// re-initializes it twice per interval from the timer interrupt handler. That
+// hasn't been measured on target yet (see the NOTE on m_esb_init in
+// rc_radio.c): check the timer handler with RC_RADIO_ISR_STATS and the slot
+// with the RC_RADIO_PROBE_TX_START probes before relying on it.
+#ifndef RC_RADIO_RELAY
+#define RC_RADIO_RELAY                   (0)
+#endif
+
+// The transmitter stages its payloads in these buffers (see
+// rc_radio_data_set).
+#define RC_RADIO_DATA_BUFF_COUNT         (3UL)
+#define RC_RADIO_AUX_BUFF_COUNT          (2UL)
+
+// Histogram bin i counts the durations in [2^i, 2^(i + 1)) ticks. The last
+// bin also counts everything longer.
+#define RC_RADIO_ISR_HISTOGRAM_BINS      (16UL)
+
 
 /**
  * The following events are delivered to the application via the
@@ -28,6 +153,17 @@
  *
  * NOTE: The RC_RADIO_EVENT_DATA_RECEIVED event is delivered along with a
  *       pointer to a rc_radio_data_t struct.
+ *
+ * NOTE: The RC_RADIO_EVENT_AUX_RECEIVED event is delivered along with a
+ *       pointer to a rc_radio_aux_data_t struct.
+ *
+ * NOTE: The RC_RADIO_EVENT_CALLBACK_OVERRUN event is delivered along with a
+ *       pointer to a rc_radio_callback_overrun_t struct right after a
+ *       callback exceeds the budget set with rc_radio_callback_budget_set.
+ *
+ * NOTE: The RC_RADIO_EVENT_PACKET_DROPPED event is only delivered for the
+ *       intervals in which the transmitter was due to send something (i.e.
+ *       every interval unless RC_RADIO_KEEPALIVE_INTERVAL is used).
  */
 typedef enum
 {
@@ -36,6 +172,8 @@ typedef enum
     RC_RADIO_EVENT_DATA_SENT,      // Only delivered to transmitter
     RC_RADIO_EVENT_DATA_RECEIVED,  // p_context is set to *rc_radio_data_t
     RC_RADIO_EVENT_PACKET_DROPPED, // Only delivered to receiver
+    RC_RADIO_EVENT_AUX_RECEIVED,   // p_context is set to *rc_radio_aux_data_t
+    RC_RADIO_EVENT_CALLBACK_OVERRUN, // p_context is set to *..._overrun_t
     RC_RADIO_EVENT_COUNT
 } rc_radio_event_t;
 
@@ -60,26 +198,121 @@ typedef enum
  * This payload can be customized as long as sizeof(rc_radio_data_t) does not
  * exceed NRF_ESB_MAX_PAYLOAD_LENGTH.
  */
+#if RC_RADIO_HIGH_RES
+typedef struct
+{
+    uint16_t throttle;
+    uint16_t pitch;
+    uint16_t roll;
+    uint16_t yaw;
+    uint8_t  switches; // One bit per switch
+} rc_radio_data_t;
+#else
 typedef struct
 {
     uint8_t throttle;
     int8_t  pitch;
     int8_t  roll;
     int8_t  yaw;
+    uint8_t switches; // One bit per switch
 } rc_radio_data_t;
+#endif
+
+
+/**
+ * Auxiliary payloads carry data that changes infrequently (e.g. a failsafe
+ * profile). The type field is defined by the application. The size of this
+ * struct must not match sizeof(rc_radio_data_t) because the receiver uses the
+ * payload length to tell the two apart.
+ */
+typedef struct
+{
+    uint8_t type;
+    uint8_t data[RC_RADIO_AUX_DATA_LEN];
+} rc_radio_aux_data_t;
 
 
 typedef struct
 {
     rc_radio_transmitter_channel_t transmitter_channel;
     uint16_t                       transmit_rate_hz;
+    uint8_t                        keepalive_interval; // 0 if fixed rate
 } rc_radio_bind_info_t;
 
 
+typedef enum
+{
+    RC_RADIO_ISR_TIMER,    // m_timer_handler, including its callbacks
+    RC_RADIO_ISR_ESB,      // m_nrf_esb_event_handler, including its callbacks
+    RC_RADIO_ISR_CALLBACK, // Every invocation of the event handler
+    RC_RADIO_ISR_COUNT
+} rc_radio_isr_t;
+
+
+/**
+ * The durations are in ticks of the clock used for the measurements, which
+ * is the DWT cycle counter (i.e. CPU cycles) unless RC_RADIO_STATS_CLOCK is
+ * defined (e.g. as a monotonic clock for a host build).
+ */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min_ticks;
+    uint32_t avg_ticks;
+    uint32_t max_ticks;
+    uint64_t total_ticks;
+    uint32_t histogram[RC_RADIO_ISR_HISTOGRAM_BINS];
+} rc_radio_isr_stats_t;
+
+
+typedef struct
+{
+    rc_radio_event_t event; // The event whose callback overran
+    uint32_t         ticks;
+} rc_radio_callback_overrun_t;
+
+
 typedef void (*rc_radio_event_handler_t)(rc_radio_event_t event,
                                              const void * const p_context);
 
 
+typedef enum
+{
+    RC_RADIO_STATE_DISABLED,
+    RC_RADIO_STATE_ENABLED,
+    RC_RADIO_STATE_BINDING,
+    RC_RADIO_STATE_STARTED,
+    RC_RADIO_STATE_COUNT
+} rc_radio_state_t;
+
+
+/**
+ * The state of one rc_radio instance. The members are private to rc_radio.c.
+ * Structs of this type need to be zeroed before they are initialized and
+ * kept in the global portion (static) of RAM because they are used by the
+ * interrupt handlers.
+ */
+typedef struct rc_radio_ctx_s
+{
+    nrf_esb_mode_t                 mode;
+    rc_radio_event_handler_t       callback;
+    nrf_drv_timer_t                timer;
+    volatile rc_radio_state_t      state;
+    volatile rc_radio_bind_info_t  bind_info;
+    volatile uint32_t              missed_packets; // Intervals without one
+    volatile uint8_t               channel_index;
+    uint8_t                        tx_data_index;
+    volatile uint8_t               tx_sent_index;
+    nrf_esb_payload_t              tx_data_pl[RC_RADIO_DATA_BUFF_COUNT];
+    uint8_t                        aux_data_index;
+    uint8_t                        aux_countdown;
+    nrf_esb_payload_t              aux_data_pl[RC_RADIO_AUX_BUFF_COUNT];
+    uint8_t                        keepalive_countdown;
+    volatile bool                  tx_pending;
+    struct rc_radio_ctx_s *        p_relay; // The other side of a relay
+} rc_radio_ctx_t;
+
+
 /**
  * The callback can be NULL if the app doesn't care. The timer instance
  * is used to select a free timer peripheral (e.g. 0 is converted to TIMER0).
@@ -110,10 +343,105 @@ uint32_t rc_radio_enable(void);
  * This function must be called to set the data before the transmitter
  * will initiate the binding procedure. Returns NRF_ERROR_INVALID_PARAM if
  * rc_radio_receiver_init was used to init the module. Data will be copied
- * to an internal buffer.
+ * to an internal buffer. When RC_RADIO_KEEPALIVE_INTERVAL is used the
+ * new data is compared against the last payload that was sent here. The
+ * comparison in rc_radio.c needs to be updated if rc_radio_data_t is
+ * customized.
  */
 uint32_t rc_radio_data_set(const rc_radio_data_t * const p_data);
 
+/**
+ * Sets the auxiliary payload that the transmitter will interleave with the
+ * data payloads. Returns NRF_ERROR_INVALID_STATE if rc_radio_receiver_init was
+ * used to init the module. Data will be copied to an internal buffer.
+ */
+uint32_t rc_radio_aux_data_set(const rc_radio_aux_data_t * const p_aux_data);
+
+/**
+ * The same as the functions above but for the given instance instead of the
+ * one that they share. Every instance needs its own timer and callback.
+ * nrf_esb drives a single radio so only one instance can be enabled at a
+ * time; rc_radio_ctx_enable returns NRF_ERROR_BUSY while another one is.
+ */
+uint32_t rc_radio_ctx_transmitter_init(rc_radio_ctx_t * p_ctx,
+                                           uint8_t timer_instance_index,
+                                           uint16_t transmit_rate_hz,
+                                           rc_radio_transmitter_channel_t channel,
+                                           rc_radio_event_handler_t callback);
+
+uint32_t rc_radio_ctx_receiver_init(rc_radio_ctx_t * p_ctx,
+                                        uint8_t timer_instance_index,
+                                        rc_radio_event_handler_t callback);
+
+uint32_t rc_radio_ctx_enable(rc_radio_ctx_t * p_ctx);
+
+uint32_t rc_radio_ctx_data_set(rc_radio_ctx_t * p_ctx,
+                                   const rc_radio_data_t * const p_data);
+
+uint32_t rc_radio_ctx_aux_data_set(rc_radio_ctx_t * p_ctx,
+                                       const rc_radio_aux_data_t * const p_aux_data);
+
+void rc_radio_ctx_disable(rc_radio_ctx_t * p_ctx);
+
+/**
+ * Initializes a relay that receives from a transmitter with p_upstream and
+ * forwards every packet to another receiver with p_downstream on the given
+ * transmitter channel, at the rate that the upstream transmitter binds with.
+ * The radio is shared within each transmit interval: the downstream packet is
+ * sent in a slot that starts shortly after the upstream packet is received and
+ * ends before the next upstream window opens, so the downstream link stays
+ * locked to the upstream one and adds less than one interval of latency. No
+ * packet is sent downstream for an interval in which the upstream one was
+ * missed.
+ *
+ * Only p_upstream uses a timer. The callback gets the events of both links
+ * (the bind info of RC_RADIO_EVENT_BOUND tells them apart) and can't be NULL.
+ * The downstream link binds after the first packet has been received from
+ * upstream. Both structs are enabled and disabled together with
+ * rc_radio_ctx_enable and rc_radio_ctx_disable, and
+ * rc_radio_ctx_data_set returns NRF_ERROR_INVALID_STATE for either of them.
+ * Returns NRF_ERROR_NOT_SUPPORTED unless RC_RADIO_RELAY is set.
+ */
+uint32_t rc_radio_ctx_relay_init(rc_radio_ctx_t * p_upstream,
+                                     rc_radio_ctx_t * p_downstream,
+                                     uint8_t timer_instance_index,
+                                     rc_radio_transmitter_channel_t channel,
+                                     rc_radio_event_handler_t callback);
+
+/**
+ * Copies the statistics of the given handler. Returns NRF_ERROR_NOT_SUPPORTED
+ * unless RC_RADIO_ISR_STATS is set.
+ */
+uint32_t rc_radio_isr_stats_get(rc_radio_isr_t isr,
+                                    rc_radio_isr_stats_t * p_stats);
+
+/**
+ * Clears the statistics of every handler.
+ */
+void rc_radio_isr_stats_reset(void);
+
+/**
+ * Sets the number of ticks that a callback may take before
+ * RC_RADIO_EVENT_CALLBACK_OVERRUN is delivered. Zero (the default) disables
+ * the check. Returns NRF_ERROR_NOT_SUPPORTED unless RC_RADIO_ISR_STATS is set.
+ */
+uint32_t rc_radio_callback_budget_set(uint32_t budget_ticks);
+
+/**
+ * Keeps the buffer of a RC_RADIO_EVENT_DATA_RECEIVED or
+ * RC_RADIO_EVENT_AUX_RECEIVED payload out of the pool after the callback
+ * returns. Must be called from the callback with the p_context that it was
+ * given. Returns NRF_ERROR_INVALID_PARAM if p_data is not a pooled buffer and
+ * NRF_ERROR_NOT_SUPPORTED unless RC_RADIO_ZERO_COPY_RX is set.
+ */
+uint32_t rc_radio_rx_retain(const void * p_data);
+
+/**
+ * Returns a buffer that was kept with rc_radio_rx_retain to the pool. Returns
+ * NRF_ERROR_INVALID_STATE if it wasn't retained.
+ */
+uint32_t rc_radio_rx_release(const void * p_data);
+
 /**
  * Shuts down the radio immediately.
  */
@@ -0,0 +1,187 @@
+/**
+ * Probe points in rc_radio.c's interrupt handlers for measuring the radio
+ * timing. RC_RADIO_PROBE selects where the probes go at compile time:
+ *
+ *   RC_RADIO_PROBE_NONE  - The probes compile to nothing (default).
+ *   RC_RADIO_PROBE_GPIO  - RC_RADIO_PROBE_GPIO_PIN_1 is high while the timer
+ *                          handler runs and RC_RADIO_PROBE_GPIO_PIN_2 is high
+ *                          while the nrf_esb event handler runs. The other
+ *                          probes pulse RC_RADIO_PROBE_GPIO_PIN_1.
+ *   RC_RADIO_PROBE_DWT   - Each probe is stored in rc_radio_probe_log along
+ *                          with the DWT cycle counter. The log can be read
+ *                          from RAM with a debugger.
+ *   RC_RADIO_PROBE_TRACE - Each probe calls rc_radio_probe_hook like
+ *                          RC_RADIO_PROBE_HOOK. The example applications'
+ *                          trace.c provides one that writes the probe to
+ *                          their binary trace as a RADIO_PROBE event.
+ *   RC_RADIO_PROBE_HOOK  - Each probe calls rc_radio_probe_hook, which is
+ *                          provided by the application (or a host harness).
+ *
+ * Every probe has an argument: the RF channel for RC_RADIO_PROBE_HOP and
+ * RC_RADIO_PROBE_TX_START, 1 if a packet was received for
+ * RC_RADIO_PROBE_RX_WINDOW_CLOSE, the rc_radio_event_t for the
+ * RC_RADIO_PROBE_CALLBACK_* probes and 0 otherwise.
+ *
+ * tools/probe_timeline.py converts the probes from the DWT log, the binary
+ * trace or a CSV file into a timeline for a trace viewer.
+ */
+#ifndef RC_RADIO_PROBE_H
+#define RC_RADIO_PROBE_H
+
+#include "stdint.h"
+
+
+#define RC_RADIO_PROBE_NONE  (0)
+#define RC_RADIO_PROBE_GPIO  (1)
+#define RC_RADIO_PROBE_DWT   (2)
+#define RC_RADIO_PROBE_TRACE (3)
+#define RC_RADIO_PROBE_HOOK  (4)
+
+#ifndef RC_RADIO_PROBE
+#define RC_RADIO_PROBE                (RC_RADIO_PROBE_NONE)
+#endif
+
+#ifndef RC_RADIO_PROBE_GPIO_PIN_1
+#define RC_RADIO_PROBE_GPIO_PIN_1     (26UL)
+#endif
+
+#ifndef RC_RADIO_PROBE_GPIO_PIN_2
+#define RC_RADIO_PROBE_GPIO_PIN_2     (27UL)
+#endif
+
+#define RC_RADIO_PROBE_LOG_LEN        (256UL) // Must be a power of two
+
+
+typedef enum
+{
+    RC_RADIO_PROBE_TIMER_ISR_ENTER,
+    RC_RADIO_PROBE_TIMER_ISR_EXIT,
+    RC_RADIO_PROBE_ESB_ISR_ENTER,
+    RC_RADIO_PROBE_ESB_ISR_EXIT,
+    RC_RADIO_PROBE_TX_START,
+    RC_RADIO_PROBE_RX_WINDOW_OPEN,
+    RC_RADIO_PROBE_RX_WINDOW_CLOSE,
+    RC_RADIO_PROBE_HOP,
+    RC_RADIO_PROBE_CALLBACK_ENTER,
+    RC_RADIO_PROBE_CALLBACK_EXIT,
+    RC_RADIO_PROBE_COUNT
+} rc_radio_probe_t;
+
+
+typedef struct
+{
+    uint32_t cycles; // DWT->CYCCNT
+    uint16_t probe;  // rc_radio_probe_t
+    uint16_t arg;
+} rc_radio_probe_record_t;
+
+
+/**
+ * The log used by RC_RADIO_PROBE_DWT. index is the number of records that
+ * have been reserved; the oldest ones are overwritten. A record whose probe
+ * preempted another one can be in the log before the preempted record is.
+ */
+typedef struct
+{
+    volatile uint32_t       index;
+    rc_radio_probe_record_t records[RC_RADIO_PROBE_LOG_LEN];
+} rc_radio_probe_log_t;
+
+
+/**
+ * Must be provided by the application when RC_RADIO_PROBE_HOOK or
+ * RC_RADIO_PROBE_TRACE is used. It's called from the rc_radio interrupt
+ * handlers.
+ */
+void rc_radio_probe_hook(rc_radio_probe_t probe, uint16_t arg);
+
+
+#if (RC_RADIO_PROBE_GPIO == RC_RADIO_PROBE)
+
+#include "nrf_gpio.h"
+
+#define RC_RADIO_PROBE_INIT()                              \
+    do                                                     \
+    {                                                      \
+        nrf_gpio_cfg_output(RC_RADIO_PROBE_GPIO_PIN_1);    \
+        nrf_gpio_cfg_output(RC_RADIO_PROBE_GPIO_PIN_2);    \
+        nrf_gpio_pin_clear(RC_RADIO_PROBE_GPIO_PIN_1);     \
+        nrf_gpio_pin_clear(RC_RADIO_PROBE_GPIO_PIN_2);     \
+    } while (0)
+
+static inline void rc_radio_probe_gpio(rc_radio_probe_t probe)
+{
+    switch (probe)
+    {
+    case RC_RADIO_PROBE_TIMER_ISR_ENTER:
+        nrf_gpio_pin_set(RC_RADIO_PROBE_GPIO_PIN_1);
+        break;
+    case RC_RADIO_PROBE_TIMER_ISR_EXIT:
+        nrf_gpio_pin_clear(RC_RADIO_PROBE_GPIO_PIN_1);
+        break;
+    case RC_RADIO_PROBE_ESB_ISR_ENTER:
+        nrf_gpio_pin_set(RC_RADIO_PROBE_GPIO_PIN_2);
+        break;
+    case RC_RADIO_PROBE_ESB_ISR_EXIT:
+        nrf_gpio_pin_clear(RC_RADIO_PROBE_GPIO_PIN_2);
+        break;
+    default:
+        nrf_gpio_pin_toggle(RC_RADIO_PROBE_GPIO_PIN_1);
+        nrf_gpio_pin_toggle(RC_RADIO_PROBE_GPIO_PIN_1);
+        break;
+    }
+}
+
+#define RC_RADIO_PROBE_HIT(probe, arg) rc_radio_probe_gpio(probe)
+
+#elif (RC_RADIO_PROBE_DWT == RC_RADIO_PROBE)
+
+#include "nrf.h"
+
+extern rc_radio_probe_log_t rc_radio_probe_log;
+
+#define RC_RADIO_PROBE_INIT()                                  \
+    do                                                         \
+    {                                                          \
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;        \
+        DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;            \
+    } while (0)
+
+// NOTE: The probes are not only hit from the timer and nrf_esb event
+//       handlers. The callback probes are also hit from rc_radio_data_set
+//       and, with RC_RADIO_DEFERRED_EVENTS, from the event SWI, which the
+//       handlers can preempt. The slot is therefore reserved like the
+//       binary trace does before the record is written.
+static inline void rc_radio_probe_dwt(rc_radio_probe_t probe, uint16_t arg)
+{
+    rc_radio_probe_record_t * p_record;
+    uint32_t                  index;
+
+    do
+    {
+        index = __LDREXW(&rc_radio_probe_log.index);
+    } while (0 != __STREXW((index + 1), &rc_radio_probe_log.index));
+
+    p_record = &rc_radio_probe_log.records[index & (RC_RADIO_PROBE_LOG_LEN - 1)];
+
+    p_record->cycles = DWT->CYCCNT;
+    p_record->probe  = (uint16_t)probe;
+    p_record->arg    = arg;
+}
+
+#define RC_RADIO_PROBE_HIT(probe, arg) rc_radio_probe_dwt((probe), (arg))
+
+#elif (RC_RADIO_PROBE_TRACE == RC_RADIO_PROBE) || \
+      (RC_RADIO_PROBE_HOOK == RC_RADIO_PROBE)
+
+#define RC_RADIO_PROBE_INIT()
+#define RC_RADIO_PROBE_HIT(probe, arg) rc_radio_probe_hook((probe), (arg))
+
+#else
+
+#define RC_RADIO_PROBE_INIT()
+#define RC_RADIO_PROBE_HIT(probe, arg)
+
+#endif
+
+#endif
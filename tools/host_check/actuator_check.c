@@ -0,0 +1,718 @@
+/**
+ * Models the PWM playback of src/examples/common/actuator.c on the host and
+ * checks that the groups of a set never output a mixed frame.
+ *
+ * The groups are started with actuator_groups_start and the model plays
+ * their sequences the way the PWM peripheral does: the sequence buffers
+ * alternate, EasyDMA reads a buffer when its sequence starts and the END
+ * event of the first group runs the PWM handler after a random latency (less
+ * than ACTUATOR_SEQ_MIN_US). Commits arrive at random times with values that
+ * identify the commit on every channel. At every sequence boundary it checks
+ * that
+ *
+ * - every channel of every group of the set comes from the same commit,
+ * - the commits are output in order,
+ * - no buffer is written while it is being played,
+ * - a commit is output at the next boundary unless it comes within
+ *   ACTUATOR_SEQ_MIN_US (and the RTC's resolution) of it,
+ *
+ * and it prints how long after a commit the set switched to it. A set whose
+ * PWM periods don't divide each other has to be rejected. The PWM handler
+ * and the commits are atomic in the model, as they are on the target where
+ * the handler takes its snapshot in a critical region.
+ *
+ * With --bench it also times the receiver's update of a frame (three servo
+ * channels and the throttle) against the four separate servo_value_set and
+ * esc_throttle_value_set calls of the drivers that the actuator layer
+ * replaced, which are reproduced here, together with the rendering that the
+ * PWM interrupts do for it.
+ */
+#include "string.h"
+#include "stdlib.h"
+
+#include "host_check.h"
+#include "actuator.c"
+#include "servo.h"
+#include "electronic_speed_controller.h"
+
+
+#define TICKS_PER_US       (16ULL)
+#define SEQUENCES          (20000UL)
+#define MAX_GROUPS         (3UL)
+#define HISTORY            (64UL)   // Commits that can be told apart
+#define TASK_BASE          (0x4001C000UL)
+#define RTC_TICK           ((TICKS_PER_US * 1000000ULL) / APP_TIMER_CLOCK_FREQ)
+#define BENCH_ITERATIONS   (10000000UL)
+
+// The replaced drivers' ranges.
+#define REF_SERVO_MIN      (600UL)
+#define REF_SERVO_MAX      (2500UL)
+#define REF_MAP(x)         ((x) * (REF_SERVO_MAX - REF_SERVO_MIN)/100 + REF_SERVO_MIN)
+
+
+typedef struct
+{
+    nrf_drv_pwm_handler_t handler;
+    nrf_drv_pwm_config_t  config;
+    nrf_pwm_sequence_t    seq[2];
+    uint32_t              flags;
+    bool                  started;
+} pwm_t;
+
+// The replaced servo driver's group.
+typedef struct
+{
+    nrf_pwm_values_individual_t pwm_values[ACTUATOR_SEQ_BUFF_COUNT];
+    nrf_pwm_values_individual_t staged_values;
+    volatile uint32_t           staged_gen;
+    uint32_t                    seq_gen[ACTUATOR_SEQ_BUFF_COUNT];
+} ref_servo_group_t;
+
+// The replaced ESC driver's group.
+typedef struct
+{
+    const profile_t             *p_profile;
+    uint16_t                    min_value;
+    uint16_t                    max_value;
+    uint8_t                     enabled_mask;
+    uint16_t                    staged_values[ACTUATOR_CHANNEL_COUNT];
+    volatile uint32_t           staged_gen;
+    uint32_t                    seq_gen[ACTUATOR_SEQ_BUFF_COUNT];
+    nrf_pwm_values_individual_t seq_values[ACTUATOR_SEQ_BUFF_COUNT]
+                                          [ACTUATOR_SEQ_MAX_STEPS];
+} ref_esc_group_t;
+
+typedef struct
+{
+    const char         *p_name;
+    uint32_t           group_count;
+    actuator_profile_t profiles[MAX_GROUPS];
+    bool               valid;
+} scenario_t;
+
+
+NRF_PWM_Type host_pwm[4];
+NRF_EGU_Type host_egu;
+
+HOST_CHECK_DEFINE();
+
+static pwm_t            m_pwms[PWM_INSTANCE_COUNT];
+static actuator_group_t m_groups_under_check[MAX_GROUPS];
+static uint16_t         m_history[HISTORY][MAX_GROUPS][ACTUATOR_CHANNEL_COUNT];
+static uint32_t         m_rand_state;
+static uint64_t         m_now;   // In 16 MHz ticks
+
+
+uint32_t nrf_drv_pwm_init(nrf_drv_pwm_t const * const p_instance,
+                          nrf_drv_pwm_config_t const * p_config,
+                          nrf_drv_pwm_handler_t handler)
+{
+    pwm_t *p_pwm = &m_pwms[p_instance->drv_inst_idx];
+
+    memset(p_pwm, 0, sizeof(*p_pwm));
+    p_pwm->config  = *p_config;
+    p_pwm->handler = handler;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_drv_pwm_complex_playback(nrf_drv_pwm_t const * const p_instance,
+                                      nrf_pwm_sequence_t const * p_sequence_0,
+                                      nrf_pwm_sequence_t const * p_sequence_1,
+                                      uint16_t playback_count,
+                                      uint32_t flags)
+{
+    pwm_t *p_pwm = &m_pwms[p_instance->drv_inst_idx];
+
+    p_pwm->seq[0] = *p_sequence_0;
+    p_pwm->seq[1] = *p_sequence_1;
+    p_pwm->flags  = flags;
+
+    if (0 == (flags & NRF_DRV_PWM_FLAG_START_VIA_TASK))
+    {
+        p_pwm->started = true;
+        return 0;
+    }
+
+    return (TASK_BASE + p_instance->drv_inst_idx);
+}
+
+
+// Called for the tasks of the PPI channels when the EGU event is triggered.
+uint32_t app_timer_cnt_get(void)
+{
+    return (uint32_t)(((m_now * APP_TIMER_CLOCK_FREQ) / (TICKS_PER_US * 1000000ULL)) &
+                          0x00FFFFFFUL);
+}
+
+
+void host_task_trigger(uint32_t task)
+{
+    CHECK((TASK_BASE <= task) && (task < (TASK_BASE + PWM_INSTANCE_COUNT)),
+          "unknown task 0x%08X", task);
+    m_pwms[task - TASK_BASE].started = true;
+}
+
+
+static uint32_t m_rand(void)
+{
+    // xorshift32
+    m_rand_state ^= (m_rand_state << 13);
+    m_rand_state ^= (m_rand_state >> 17);
+    m_rand_state ^= (m_rand_state << 5);
+
+    return m_rand_state;
+}
+
+
+// The length of a recorded sequence in 16 MHz ticks.
+static uint64_t m_seq_ticks_get(const pwm_t * p_pwm)
+{
+    uint64_t period = p_pwm->config.top_value;
+    uint64_t steps  = (p_pwm->seq[0].length / ACTUATOR_CHANNEL_COUNT);
+
+    if (NRF_PWM_CLK_1MHz == p_pwm->config.base_clock)
+    {
+        period *= TICKS_PER_US;
+    }
+
+    return (((steps * (p_pwm->seq[0].repeats + 1)) + p_pwm->seq[0].end_delay) * period);
+}
+
+
+// Every channel of a commit gets its own value and consecutive commits are
+// far apart so that the ticks can be traced back to the commit even for the
+// narrow ranges.
+static uint16_t m_commit_value(uint32_t commit, uint32_t ch)
+{
+    return ((((commit & 1) ? 2048 : 0) + ((commit % (HISTORY / 2)) * 32) + (ch * 4)));
+}
+
+
+static void m_commit(uint32_t commit, uint32_t group_count)
+{
+    actuator_group_t *p_groups[MAX_GROUPS];
+    uint16_t         values[ACTUATOR_CHANNEL_COUNT];
+    uint32_t         g;
+    uint32_t         ch;
+
+    for (g = 0; g < group_count; g++)
+    {
+        for (ch = 0; ch < ACTUATOR_CHANNEL_COUNT; ch++)
+        {
+            values[ch] = m_commit_value(commit, ch);
+        }
+        (void)actuator_values_hr_stage(&m_groups_under_check[g], values);
+        memcpy(m_history[commit % HISTORY][g],
+                   m_groups_under_check[g].pending_values,
+                   sizeof(m_history[0][0]));
+        p_groups[g] = &m_groups_under_check[g];
+    }
+
+    actuator_commit(p_groups, group_count);
+}
+
+
+// Returns the newest commit (not newer than last_commit) whose ticks match
+// the given frame or -1.
+static int32_t m_commit_find(const nrf_pwm_values_individual_t * p_frame,
+                                 uint32_t g,
+                                 uint32_t ch,
+                                 int32_t last_commit)
+{
+    const uint16_t *p_values = (const uint16_t *)p_frame;
+    uint16_t       ticks     = (p_values[ch] & ~CH_ENABLED_MASK);
+    int32_t        commit;
+
+    for (commit = last_commit; (commit >= 0) && (commit > (last_commit - (int32_t)HISTORY)); commit--)
+    {
+        if (m_history[commit % HISTORY][g][ch] == ticks)
+        {
+            return commit;
+        }
+    }
+
+    return -1;
+}
+
+
+static void m_scenario_run(const scenario_t * p_scenario)
+{
+    actuator_group_t *p_groups[MAX_GROUPS];
+    nrf_pwm_values_individual_t played[MAX_GROUPS];
+    uint64_t         seq_ticks;
+    uint64_t         next_boundary;
+    uint64_t         next_commit;
+    uint64_t         handler_at     = UINT64_MAX;
+    uint64_t         commit_at[HISTORY];
+    uint64_t         latency_sum    = 0;
+    uint64_t         latency_max    = 0;
+    uint32_t         handler_seq    = 0;
+    uint32_t         boundary       = 0;
+    uint32_t         commits        = 0;
+    uint32_t         switched       = 0;
+    uint32_t         mixed          = 0;
+    uint32_t         torn           = 0;
+    uint32_t         late           = 0;
+    int32_t          shown          = -1;
+    uint32_t         err_code;
+    uint32_t         g;
+    uint32_t         ch;
+
+    m_rand_state = 0x1234567UL;
+    m_now        = 0;
+    memset(m_pwms, 0, sizeof(m_pwms));
+    memset(m_history, 0, sizeof(m_history));
+
+    for (g = 0; g < p_scenario->group_count; g++)
+    {
+        err_code = actuator_group_init(&m_groups_under_check[g],
+                                           g,
+                                           p_scenario->profiles[g],
+                                           1, 2, 3, 4);
+        CHECK(NRF_SUCCESS == err_code, "%s: init returned %u", p_scenario->p_name, err_code);
+        p_groups[g] = &m_groups_under_check[g];
+    }
+
+    err_code = actuator_groups_start(p_groups, p_scenario->group_count);
+
+    if (!p_scenario->valid)
+    {
+        CHECK(NRF_ERROR_INVALID_PARAM == err_code,
+              "%s: start returned %u", p_scenario->p_name, err_code);
+        for (g = 0; g < p_scenario->group_count; g++)
+        {
+            CHECK(!m_pwms[g].started && !m_groups_under_check[g].started,
+                  "%s: group %u was started", p_scenario->p_name, g);
+        }
+        printf("  %-32s rejected\n", p_scenario->p_name);
+        return;
+    }
+
+    CHECK(NRF_SUCCESS == err_code, "%s: start returned %u", p_scenario->p_name, err_code);
+
+    // Started by the same trigger, with sequences of the same length and only
+    // the first group signalling its END events.
+    seq_ticks = m_seq_ticks_get(&m_pwms[0]);
+    for (g = 0; g < p_scenario->group_count; g++)
+    {
+        CHECK(m_pwms[g].started, "%s: group %u not started", p_scenario->p_name, g);
+        CHECK(seq_ticks == m_seq_ticks_get(&m_pwms[g]),
+              "%s: group %u sequence is %llu ticks, group 0 is %llu",
+              p_scenario->p_name, g,
+              (unsigned long long)m_seq_ticks_get(&m_pwms[g]),
+              (unsigned long long)seq_ticks);
+        CHECK(((0 == g) == (0 != (m_pwms[g].flags & NRF_DRV_PWM_FLAG_SIGNAL_END_SEQ0))),
+              "%s: group %u flags 0x%02X", p_scenario->p_name, g, m_pwms[g].flags);
+    }
+    for (ch = 0; ch < HOST_PPI_CHANNEL_COUNT; ch++)
+    {
+        CHECK(!host_ppi[ch].allocated, "%s: PPI channel %u left allocated",
+              p_scenario->p_name, ch);
+    }
+
+    // The first commit is the initial values.
+    for (g = 0; g < p_scenario->group_count; g++)
+    {
+        memcpy(m_history[0][g], m_groups_under_check[g].staged_values,
+                   sizeof(m_history[0][0]));
+    }
+    commit_at[0] = 0;
+
+    next_boundary = 0;
+    next_commit   = (m_rand() % seq_ticks);
+
+    while (boundary < SEQUENCES)
+    {
+        if ((next_boundary <= handler_at) && (next_boundary <= next_commit))
+        {
+            uint32_t seq_index = (boundary % ACTUATOR_SEQ_BUFF_COUNT);
+            int32_t  frame_commit = -2;
+
+            m_now = next_boundary;
+
+            for (g = 0; g < p_scenario->group_count; g++)
+            {
+                // The buffer that has just been played wasn't touched.
+                if ((0 < boundary) &&
+                        (0 != memcmp(&played[g],
+                                         m_groups_under_check[g].seq_values[seq_index ^ 1],
+                                         sizeof(played[g]))))
+                {
+                    torn++;
+                }
+
+                memcpy(&played[g], m_groups_under_check[g].seq_values[seq_index],
+                           sizeof(played[g]));
+
+                for (ch = 0; ch < ACTUATOR_CHANNEL_COUNT; ch++)
+                {
+                    int32_t commit = m_commit_find(&played[g], g, ch, (int32_t)commits);
+
+                    if (-2 == frame_commit)
+                    {
+                        frame_commit = commit;
+                    }
+                    else if (commit != frame_commit)
+                    {
+                        frame_commit = -1;
+                    }
+                }
+            }
+
+            if (0 > frame_commit)
+            {
+                mixed++;
+            }
+            else
+            {
+                CHECK(frame_commit >= shown, "%s: commit %d output after %d",
+                      p_scenario->p_name, frame_commit, shown);
+
+                // Every commit that this frame supersedes has been switched to.
+                while ((int32_t)switched <= frame_commit)
+                {
+                    uint64_t at      = commit_at[switched % HISTORY];
+                    uint64_t latency = (m_now - at);
+                    uint64_t to_next = ((((at / seq_ticks) + 1) * seq_ticks) - at);
+
+                    if (0 < switched)
+                    {
+                        // Missed a boundary that it came early enough for.
+                        if ((latency > to_next) &&
+                                (to_next > ((ACTUATOR_SEQ_MIN_US * TICKS_PER_US) +
+                                            ((AHEAD_MARGIN_TICKS + 1) * RTC_TICK))))
+                        {
+                            late++;
+                        }
+                        latency_sum += latency;
+                        if (latency > latency_max)
+                        {
+                            latency_max = latency;
+                        }
+                    }
+                    switched++;
+                }
+                shown = frame_commit;
+            }
+
+            if (0 < boundary)
+            {
+                handler_at  = (m_now + (m_rand() % (ACTUATOR_SEQ_MIN_US * TICKS_PER_US)));
+                handler_seq = (seq_index ^ 1);
+            }
+            next_boundary += seq_ticks;
+            boundary++;
+        }
+        else if (handler_at <= next_commit)
+        {
+            m_now      = handler_at;
+            handler_at = UINT64_MAX;
+            m_pwms[0].handler((0 == handler_seq) ? NRF_DRV_PWM_EVT_END_SEQ0 :
+                                                   NRF_DRV_PWM_EVT_END_SEQ1);
+        }
+        else
+        {
+            m_now = next_commit;
+
+            // Commits can't get further ahead of the output than the values
+            // can tell apart.
+            if ((commits + 1 - switched) < (HISTORY / 2))
+            {
+                commits++;
+                commit_at[commits % HISTORY] = m_now;
+                m_commit(commits, p_scenario->group_count);
+            }
+            next_commit += (m_rand() % seq_ticks);
+        }
+    }
+
+    CHECK(0 == mixed, "%s: %u mixed frames", p_scenario->p_name, mixed);
+    CHECK(0 == torn, "%s: %u buffers written while played", p_scenario->p_name, torn);
+    CHECK(0 == late, "%s: %u commits missed the next boundary", p_scenario->p_name, late);
+    CHECK(1 < switched, "%s: no commit was output", p_scenario->p_name);
+
+    printf("  %-32s %8u %8u %6u %8.2f %8.2f\n",
+           p_scenario->p_name,
+           commits,
+           boundary,
+           mixed,
+           ((double)latency_sum / ((switched - 1) * seq_ticks)),
+           ((double)latency_max / seq_ticks));
+}
+
+
+static uint16_t * m_ref_servo_value_get(ref_servo_group_t * p_group, uint8_t ch_index)
+{
+    switch (ch_index)
+    {
+    case 0:
+        return &p_group->staged_values.channel_0;
+    case 1:
+        return &p_group->staged_values.channel_1;
+    case 2:
+        return &p_group->staged_values.channel_2;
+    case 3:
+        return &p_group->staged_values.channel_3;
+    default:
+        return NULL;
+    }
+}
+
+
+// servo_value_set before the actuator layer.
+static uint32_t m_ref_servo_value_set(ref_servo_group_t * p_group,
+                                          uint8_t ch_index,
+                                          uint8_t value)
+{
+    uint16_t *p_channel_value;
+
+    if (ACTUATOR_MAX_VALUE < value)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    p_channel_value = m_ref_servo_value_get(p_group, ch_index);
+    if ((NULL == p_channel_value) || (0 == (*p_channel_value & CH_ENABLED_MASK)))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    *p_channel_value = (REF_MAP(value) | CH_ENABLED_MASK);
+    p_group->staged_gen++;
+
+    return NRF_SUCCESS;
+}
+
+
+// esc_throttle_value_set before the actuator layer.
+static uint32_t m_ref_esc_value_set(ref_esc_group_t * p_group,
+                                        uint8_t ch_index,
+                                        uint8_t value)
+{
+    if (ACTUATOR_MAX_VALUE < value)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if ((ACTUATOR_CHANNEL_COUNT <= ch_index) ||
+            (0 == (p_group->enabled_mask & (1 << ch_index))))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (p_group->p_profile->is_dshot && (0 == value))
+    {
+        p_group->staged_values[ch_index] = 0;
+    }
+    else
+    {
+        p_group->staged_values[ch_index] = map(value,
+                                                   p_group->min_value,
+                                                   p_group->max_value);
+    }
+    p_group->staged_gen++;
+
+    return NRF_SUCCESS;
+}
+
+
+// The servo driver's PWM handler copied the staged values.
+static void m_ref_servo_seq_update(ref_servo_group_t * p_group, uint32_t seq_index)
+{
+    uint32_t gen = p_group->staged_gen;
+
+    if (gen != p_group->seq_gen[seq_index])
+    {
+        p_group->pwm_values[seq_index] = p_group->staged_values;
+        p_group->seq_gen[seq_index]    = gen;
+    }
+}
+
+
+// The ESC driver's PWM handler rendered them.
+static void m_ref_esc_seq_update(ref_esc_group_t * p_group, uint32_t seq_index)
+{
+    nrf_pwm_values_individual_t *p_steps = p_group->seq_values[seq_index];
+    uint16_t                    frames[ACTUATOR_CHANNEL_COUNT];
+    uint32_t                    gen      = p_group->staged_gen;
+    uint32_t                    i;
+
+    if (gen == p_group->seq_gen[seq_index])
+    {
+        return;
+    }
+
+    if (!p_group->p_profile->is_dshot)
+    {
+        p_steps[0].channel_0 = (CH_ENABLED_MASK | p_group->staged_values[0]);
+        p_steps[0].channel_1 = (CH_ENABLED_MASK | p_group->staged_values[1]);
+        p_steps[0].channel_2 = (CH_ENABLED_MASK | p_group->staged_values[2]);
+        p_steps[0].channel_3 = (CH_ENABLED_MASK | p_group->staged_values[3]);
+    }
+    else
+    {
+        for (i = 0; i < ACTUATOR_CHANNEL_COUNT; i++)
+        {
+            frames[i] = actuator_dshot_frame_encode(p_group->staged_values[i], false);
+        }
+
+        for (i = 0; i < ACTUATOR_SEQ_MAX_STEPS; i++)
+        {
+            p_steps[i].channel_0 = m_step_value_get(p_group->p_profile, frames[0], i);
+            p_steps[i].channel_1 = m_step_value_get(p_group->p_profile, frames[1], i);
+            p_steps[i].channel_2 = m_step_value_get(p_group->p_profile, frames[2], i);
+            p_steps[i].channel_3 = m_step_value_get(p_group->p_profile, frames[3], i);
+        }
+    }
+
+    p_group->seq_gen[seq_index] = gen;
+}
+
+
+// Times one protocol. The update is what m_controls_apply does for a frame
+// and the render is what the PWM interrupts then do for it.
+static void m_bench_protocol(esc_protocol_t protocol, const char * p_name)
+{
+    static servo_group_t        servo_group;
+    static esc_throttle_group_t esc_group;
+    static ref_servo_group_t    ref_servo_group;
+    static ref_esc_group_t      ref_esc_group;
+    actuator_group_t            *p_groups[] = {&servo_group, &esc_group};
+    const profile_t             *p_profile  = &PROFILES[protocol];
+    uint8_t                     values[SERVO_CHANNEL_COUNT] = {0};
+    uint64_t                    start;
+    double                      update_ns;
+    double                      ref_update_ns;
+    double                      render_ns;
+    double                      ref_render_ns;
+    uint32_t                    err_code;
+    uint32_t                    i;
+
+    m_now = 0;
+    memset(m_pwms, 0, sizeof(m_pwms));
+
+    err_code  = servo_group_init(&servo_group, 0, 1, 2, 3, SERVO_PIN_NOT_USED);
+    err_code |= esc_throttle_group_init(&esc_group, 1, protocol, 4,
+                                            ESC_THROTTLE_PIN_NOT_USED,
+                                            ESC_THROTTLE_PIN_NOT_USED,
+                                            ESC_THROTTLE_PIN_NOT_USED);
+    CHECK(NRF_SUCCESS == err_code, "%s: init returned %u", p_name, err_code);
+
+    // As rx/main.c does.
+    err_code = actuator_groups_start(p_groups, 2);
+    if (NRF_ERROR_INVALID_PARAM == err_code)
+    {
+        err_code  = actuator_groups_start(&p_groups[0], 1);
+        err_code |= actuator_groups_start(&p_groups[1], 1);
+    }
+    CHECK(NRF_SUCCESS == err_code, "%s: start returned %u", p_name, err_code);
+
+    memset(&ref_servo_group, 0, sizeof(ref_servo_group));
+    memset(&ref_esc_group, 0, sizeof(ref_esc_group));
+    ref_servo_group.staged_values.channel_0 = CH_ENABLED_MASK;
+    ref_servo_group.staged_values.channel_1 = CH_ENABLED_MASK;
+    ref_servo_group.staged_values.channel_2 = CH_ENABLED_MASK;
+    ref_esc_group.p_profile    = p_profile;
+    ref_esc_group.min_value    = (p_profile->is_dshot ? ACTUATOR_DSHOT_THROTTLE_MIN :
+                                                        p_profile->scale.min);
+    ref_esc_group.max_value    = (p_profile->is_dshot ? ACTUATOR_DSHOT_THROTTLE_MAX :
+                                                        (p_profile->scale.min +
+                                                         p_profile->scale.range));
+    ref_esc_group.enabled_mask = 1;
+
+    start = host_check_ns();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        values[0] = (i % 101);
+        values[1] = ((i + 33) % 101);
+        values[2] = ((i + 66) % 101);
+        (void)servo_values_stage(&servo_group, values);
+        (void)esc_throttle_value_stage(&esc_group, 0, (uint8_t)((i + 50) % 101));
+        actuator_commit(p_groups, 2);
+    }
+    update_ns = ((double)(host_check_ns() - start) / BENCH_ITERATIONS);
+
+    start = host_check_ns();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        (void)m_ref_servo_value_set(&ref_servo_group, 0, (uint8_t)(i % 101));
+        (void)m_ref_servo_value_set(&ref_servo_group, 1, (uint8_t)((i + 33) % 101));
+        (void)m_ref_servo_value_set(&ref_servo_group, 2, (uint8_t)((i + 66) % 101));
+        (void)m_ref_esc_value_set(&ref_esc_group, 0, (uint8_t)((i + 50) % 101));
+    }
+    ref_update_ns = ((double)(host_check_ns() - start) / BENCH_ITERATIONS);
+
+    // A new generation for every group and then their interrupts.
+    start = host_check_ns();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        servo_group.staged_gen++;
+        esc_group.staged_gen++;
+        m_pwms[0].handler((i & 1) ? NRF_DRV_PWM_EVT_END_SEQ1 : NRF_DRV_PWM_EVT_END_SEQ0);
+        if (NULL == servo_group.p_next)
+        {
+            m_pwms[1].handler((i & 1) ? NRF_DRV_PWM_EVT_END_SEQ1 : NRF_DRV_PWM_EVT_END_SEQ0);
+        }
+    }
+    render_ns = ((double)(host_check_ns() - start) / BENCH_ITERATIONS);
+
+    start = host_check_ns();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        ref_servo_group.staged_gen++;
+        ref_esc_group.staged_gen++;
+        m_ref_servo_seq_update(&ref_servo_group, (i & 1));
+        m_ref_esc_seq_update(&ref_esc_group, (i & 1));
+    }
+    ref_render_ns = ((double)(host_check_ns() - start) / BENCH_ITERATIONS);
+
+    printf("  %-36s %8.1f %8.1f\n", "separate calls", ref_update_ns, ref_render_ns);
+    printf("  %-36s %8.1f %8.1f\n", p_name, update_ns, render_ns);
+}
+
+
+static void m_bench(void)
+{
+    printf("actuator_check: receiver frame update, host ns per frame\n");
+    printf("  %-36s %8s %8s\n", "", "update", "render");
+    m_bench_protocol(ESC_PROTOCOL_PWM, "stage and commit, ESC PWM");
+    m_bench_protocol(ESC_PROTOCOL_DSHOT600, "stage and commit, DShot600");
+}
+
+
+int main(int argc, char * argv[])
+{
+    static const scenario_t scenarios[] = {
+        {"servo, ESC PWM", 2,
+             {ACTUATOR_PROFILE_RSMS_SERVO, ACTUATOR_PROFILE_ESC_PWM}, true},
+        {"servo, OneShot125, motor", 3,
+             {ACTUATOR_PROFILE_RSMS_SERVO, ACTUATOR_PROFILE_ESC_ONESHOT125,
+              ACTUATOR_PROFILE_BDCM}, true},
+        {"OneShot125, Multishot", 2,
+             {ACTUATOR_PROFILE_ESC_ONESHOT125, ACTUATOR_PROFILE_ESC_MULTISHOT}, true},
+        {"servo alone", 1,
+             {ACTUATOR_PROFILE_RSMS_SERVO}, true},
+        {"servo, DShot600", 2,
+             {ACTUATOR_PROFILE_RSMS_SERVO, ACTUATOR_PROFILE_ESC_DSHOT600}, false},
+    };
+    uint32_t i;
+
+    printf("actuator_check: random commits against the PWM playback "
+           "(latency in sequences)\n");
+    printf("  %-32s %8s %8s %6s %8s %8s\n",
+           "", "commits", "frames", "mixed", "mean", "max");
+
+    for (i = 0; i < (sizeof(scenarios) / sizeof(scenarios[0])); i++)
+    {
+        m_scenario_run(&scenarios[i]);
+    }
+
+    if ((1 < argc) && (0 == strcmp(argv[1], "--bench")))
+    {
+        m_bench();
+    }
+
+    return HOST_CHECK_DONE("actuator_check");
+}
@@ -0,0 +1,368 @@
+/**
+ * Simulates src/examples/common/diversity.c with two receivers on the host.
+ *
+ * Each transmit interval the frame is lost or received by each receiver
+ * according to its own loss model (independent, or bursty with a two state
+ * Gilbert-Elliott model). The local receiver's events are put at the times
+ * that rc_radio delivers them (the packet shortly after the start of the
+ * interval, the drop from CC1 at the end of the receive window). The partner's
+ * events arrive over the link after its own clock offset plus the UART's
+ * transfer time and jitter, and some of them are lost on the link.
+ *
+ * The application's handler checks that:
+ * - Every interval is delivered exactly once, as a frame or as a drop, and in
+ *   order. A duplicate or a drop followed by the same interval's frame breaks
+ *   the sequence.
+ * - A drop is only delivered if the local receiver missed the frame and the
+ *   partner's copy didn't arrive.
+ *
+ * It prints the loss of each receiver against the combined loss and the
+ * latency that the combiner adds.
+ */
+#include "string.h"
+
+#include "host_check.h"
+#include "diversity.c"
+
+
+#define TICKS_START       (0x00FFFF00UL) // The RTC wraps early in each run
+#define PERIODS           (20000UL)
+#define PRE_BOUND_PERIODS (200UL)
+#define RX_LATENCY_US     (30L)   // Start of the interval to the callback
+#define RX_WINDOW_US      (130L)  // Start of the interval to CC1
+#define LINK_US           (70L)   // 7 bytes at 1 Mbaud
+#define LINK_JITTER_US    (30UL)
+#define CLOCK_OFFSET_US   (100UL) // Partner's timer against the local one
+
+
+HOST_CHECK_DEFINE();
+
+
+typedef struct
+{
+    float p_loss_good;
+    float p_loss_bad;
+    float p_good_to_bad; // 0 for independent loss
+    float p_bad_to_good;
+    bool  is_bad;
+} loss_model_t;
+
+
+typedef struct
+{
+    const char * p_name;
+    uint16_t     rate_hz;
+    loss_model_t local;
+    loss_model_t remote;
+    float        p_link_loss;
+    bool         link_dies;   // The partner goes quiet half way through
+} scenario_t;
+
+
+typedef struct
+{
+    int64_t          time_us;
+    bool             is_remote;
+    rc_radio_event_t event;
+} sim_event_t;
+
+
+typedef struct
+{
+    uint32_t lost[DIVERSITY_SOURCE_COUNT];
+    uint32_t both_lost;
+    uint32_t data;
+    uint32_t dropped;
+    int64_t  data_latency_max_us;
+    int64_t  drop_latency_max_us;
+    int64_t  drop_latency_total_us;
+} result_t;
+
+
+static int64_t  m_now_us;
+static uint32_t m_rand_state;
+static uint32_t m_interval_us;
+static uint32_t m_expected_period;
+
+// Set when the local receiver missed the frame and the partner's copy didn't
+// arrive, i.e. when a drop is the right thing to deliver.
+static bool     m_both_lost[PERIODS + 1];
+static result_t m_result;
+
+
+uint32_t app_timer_cnt_get(void)
+{
+    return (uint32_t)((TICKS_START +
+                          (((uint64_t)m_now_us * APP_TIMER_CLOCK_FREQ) / 1000000UL)) &
+                              0x00FFFFFFUL);
+}
+
+
+static uint32_t m_rand(void)
+{
+    m_rand_state ^= (m_rand_state << 13);
+    m_rand_state ^= (m_rand_state >> 17);
+    m_rand_state ^= (m_rand_state << 5);
+
+    return m_rand_state;
+}
+
+
+static bool m_chance(float p)
+{
+    return ((float)(m_rand() & 0xFFFFFF) < (p * (float)0x1000000));
+}
+
+
+static bool m_frame_lost(loss_model_t * p_model)
+{
+    if (p_model->is_bad)
+    {
+        p_model->is_bad = !m_chance(p_model->p_bad_to_good);
+    }
+    else
+    {
+        p_model->is_bad = m_chance(p_model->p_good_to_bad);
+    }
+
+    return m_chance(p_model->is_bad ? p_model->p_loss_bad : p_model->p_loss_good);
+}
+
+
+// The interval's number is carried in the payload.
+static uint32_t m_period_get(const rc_radio_data_t * p_data)
+{
+    return (p_data->throttle | ((uint32_t)p_data->switches << 8) |
+                ((uint32_t)(uint8_t)p_data->pitch << 16));
+}
+
+
+static void m_period_set(rc_radio_data_t * p_data, uint32_t period)
+{
+    memset(p_data, 0, sizeof(rc_radio_data_t));
+    p_data->throttle = (uint8_t)period;
+    p_data->switches = (uint8_t)(period >> 8);
+    p_data->pitch    = (int8_t)(uint8_t)(period >> 16);
+}
+
+
+static int64_t m_period_start_us(uint32_t period)
+{
+    return ((int64_t)period * m_interval_us);
+}
+
+
+static void m_app_handler(rc_radio_event_t event, const void * const p_context)
+{
+    int64_t latency_us;
+
+    switch (event)
+    {
+    case RC_RADIO_EVENT_DATA_RECEIVED:
+    {
+        uint32_t period = m_period_get((const rc_radio_data_t*)p_context);
+
+        CHECK(period == m_expected_period,
+              "frame %u delivered, expected %u", period, m_expected_period);
+
+        latency_us = (m_now_us - m_period_start_us(period));
+        if (latency_us > m_result.data_latency_max_us)
+        {
+            m_result.data_latency_max_us = latency_us;
+        }
+
+        m_result.data++;
+        m_expected_period = (period + 1);
+    }
+        break;
+    case RC_RADIO_EVENT_PACKET_DROPPED:
+        CHECK(m_both_lost[m_expected_period],
+              "drop delivered for %u but a copy arrived", m_expected_period);
+
+        // Measured from the local receiver's CC1.
+        latency_us = (m_now_us -
+                          (m_period_start_us(m_expected_period) + RX_WINDOW_US));
+        if (latency_us > m_result.drop_latency_max_us)
+        {
+            m_result.drop_latency_max_us = latency_us;
+        }
+        m_result.drop_latency_total_us += latency_us;
+
+        m_result.dropped++;
+        m_expected_period++;
+        break;
+    default:
+        break;
+    }
+}
+
+
+static void m_event_put(const sim_event_t * p_event, uint32_t period)
+{
+    rc_radio_data_t data;
+
+    m_period_set(&data, period);
+    m_now_us = p_event->time_us;
+
+    if (p_event->is_remote)
+    {
+        diversity_remote_event_put(p_event->event, &data);
+    }
+    else
+    {
+        diversity_rc_radio_handler(p_event->event,
+                                       ((RC_RADIO_EVENT_DATA_RECEIVED == p_event->event) ?
+                                            &data : NULL));
+    }
+}
+
+
+static void m_scenario_run(scenario_t * p_scenario)
+{
+    rc_radio_bind_info_t bind_info = {RC_RADIO_TRANSMITTER_CHANNEL_A,
+                                      p_scenario->rate_hz,
+                                      0};
+    diversity_stats_t    stats;
+    sim_event_t          events[2];
+    uint32_t             event_count;
+    uint32_t             period;
+    uint32_t             i;
+
+    memset(&m_result, 0, sizeof(m_result));
+    memset(m_both_lost, 0, sizeof(m_both_lost));
+    m_rand_state      = 0x2545F491UL;
+    m_interval_us     = (1000000UL / p_scenario->rate_hz);
+    m_expected_period = 0;
+    m_now_us          = 0;
+
+    CHECK(NRF_SUCCESS == diversity_init(m_app_handler, NULL), "init failed");
+
+    for (period = 0; period < PERIODS; period++)
+    {
+        int64_t start_us      = m_period_start_us(period);
+        bool    local_lost    = m_frame_lost(&p_scenario->local);
+        bool    remote_lost   = m_frame_lost(&p_scenario->remote);
+        bool    link_up       = !(p_scenario->link_dies && (period >= (PERIODS / 2)));
+        bool    remote_sent   = (link_up && !m_chance(p_scenario->p_link_loss));
+        int64_t offset_us     = ((int64_t)(m_rand() % ((2 * CLOCK_OFFSET_US) + 1)) -
+                                     (int64_t)CLOCK_OFFSET_US);
+
+        // Until then both receivers deliver frames with the default window.
+        if (PRE_BOUND_PERIODS == period)
+        {
+            m_now_us = start_us;
+            diversity_rc_radio_handler(RC_RADIO_EVENT_BOUND, &bind_info);
+        }
+
+        m_result.lost[DIVERSITY_SOURCE_LOCAL]  += local_lost;
+        m_result.lost[DIVERSITY_SOURCE_REMOTE] += remote_lost;
+        m_both_lost[period] = (local_lost && (remote_lost || !remote_sent));
+        m_result.both_lost += m_both_lost[period];
+
+        events[0].time_us   = (start_us + (local_lost ? RX_WINDOW_US : RX_LATENCY_US));
+        events[0].is_remote = false;
+        events[0].event     = (local_lost ? RC_RADIO_EVENT_PACKET_DROPPED :
+                                            RC_RADIO_EVENT_DATA_RECEIVED);
+        event_count = 1;
+
+        if (remote_sent)
+        {
+            events[1].time_us   = (start_us + offset_us +
+                                      (remote_lost ? RX_WINDOW_US : RX_LATENCY_US) +
+                                      LINK_US + (m_rand() % LINK_JITTER_US));
+            events[1].is_remote = true;
+            events[1].event     = (remote_lost ? RC_RADIO_EVENT_PACKET_DROPPED :
+                                                 RC_RADIO_EVENT_DATA_RECEIVED);
+            event_count = 2;
+
+            if (events[1].time_us < events[0].time_us)
+            {
+                sim_event_t event = events[0];
+
+                events[0] = events[1];
+                events[1] = event;
+            }
+        }
+
+        for (i = 0; i < event_count; i++)
+        {
+            m_event_put(&events[i], period);
+        }
+    }
+
+    // One more frame so that a drop that is still held gets delivered.
+    events[0].time_us   = (m_period_start_us(PERIODS) + RX_LATENCY_US);
+    events[0].is_remote = false;
+    events[0].event     = RC_RADIO_EVENT_DATA_RECEIVED;
+    m_event_put(&events[0], PERIODS);
+
+    diversity_stats_get(&stats);
+
+    CHECK((PERIODS + 1) == m_expected_period,
+          "%s: %u of %u intervals delivered", p_scenario->p_name,
+          m_expected_period, (uint32_t)(PERIODS + 1));
+    CHECK(m_result.both_lost == m_result.dropped,
+          "%s: %u drops delivered for %u lost by both", p_scenario->p_name,
+          m_result.dropped, m_result.both_lost);
+    CHECK(stats.frames_dropped_combined == m_result.dropped,
+          "%s: stats count %u drops", p_scenario->p_name,
+          stats.frames_dropped_combined);
+
+    // A drop is only held past the window when the partner's message was lost,
+    // and then only until the next local event.
+    CHECK(m_result.drop_latency_max_us <= (int64_t)m_interval_us,
+          "%s: drop delivered %lld us after CC1", p_scenario->p_name,
+          (long long)m_result.drop_latency_max_us);
+    CHECK(((0 == stats.link_timeouts) ==
+               ((0.0f == p_scenario->p_link_loss) && !p_scenario->link_dies)),
+          "%s: %u link timeouts", p_scenario->p_name, stats.link_timeouts);
+
+    printf("  %-24s %4u %6.2f %6.2f %8.2f %6u %8u %6lld %6.1f %6lld\n",
+           p_scenario->p_name,
+           p_scenario->rate_hz,
+           (100.0 * m_result.lost[DIVERSITY_SOURCE_LOCAL]) / PERIODS,
+           (100.0 * m_result.lost[DIVERSITY_SOURCE_REMOTE]) / PERIODS,
+           (100.0 * m_result.dropped) / (PERIODS + 1),
+           stats.frames_duplicate,
+           stats.link_timeouts,
+           (long long)m_result.data_latency_max_us,
+           (m_result.dropped ?
+               ((double)m_result.drop_latency_total_us / m_result.dropped) : 0.0),
+           (long long)m_result.drop_latency_max_us);
+}
+
+
+int main(int argc, char * argv[])
+{
+    // Loss in the good state, in the bad state, and the transitions.
+    static scenario_t scenarios[] = {
+        {"independent 10%",        100, {0.10f, 0.0f,  0.0f,   0.0f,  false},
+                                        {0.10f, 0.0f,  0.0f,   0.0f,  false},  0.0f,  false},
+        {"independent 10%",        500, {0.10f, 0.0f,  0.0f,   0.0f,  false},
+                                        {0.10f, 0.0f,  0.0f,   0.0f,  false},  0.0f,  false},
+        {"bursty",                 100, {0.01f, 0.70f, 0.02f,  0.15f, false},
+                                        {0.01f, 0.70f, 0.02f,  0.15f, false}, 0.0f,  false},
+        {"bursty, link loss 1%",   500, {0.01f, 0.70f, 0.02f,  0.15f, false},
+                                        {0.01f, 0.70f, 0.02f,  0.15f, false}, 0.01f, false},
+        {"local shadowed",         100, {0.05f, 0.95f, 0.05f,  0.05f, false},
+                                        {0.02f, 0.0f,  0.0f,   0.0f,  false},  0.0f,  false},
+        {"partner lost",           100, {0.10f, 0.0f,  0.0f,   0.0f,  false},
+                                        {0.10f, 0.0f,  0.0f,   0.0f,  false},  0.0f,  true},
+    };
+    uint32_t i;
+
+    printf("diversity_check: %u intervals each (loss in %%, times in us)\n",
+           (uint32_t)PERIODS);
+    printf("  %-24s %4s %6s %6s %8s %6s %8s %6s %6s %6s\n",
+           "", "Hz", "local", "remote", "combined", "dups", "timeouts",
+           "data", "drop", "drop");
+    printf("  %-24s %4s %6s %6s %8s %6s %8s %6s %6s %6s\n",
+           "", "", "", "", "", "", "", "max", "avg", "max");
+
+    for (i = 0; i < (sizeof(scenarios) / sizeof(scenarios[0])); i++)
+    {
+        m_scenario_run(&scenarios[i]);
+    }
+
+    return HOST_CHECK_DONE("diversity_check");
+}
@@ -0,0 +1,243 @@
+/**
+ * Checks the DShot output of src/examples/common/actuator.c on the host.
+ *
+ * - actuator_dshot_frame_encode is compared with a bit by bit reference for
+ *   every throttle value and telemetry bit.
+ * - For every DShot profile the PWM configuration and the rendered sequence
+ *   are checked against the DShot bit timing.
+ *
+ * actuator.c is included so that its profile table and PWM handlers can be
+ * reached. The nrf_drv_pwm functions are implemented here and only record
+ * what would have been played.
+ */
+#include "math.h"
+
+#include "host_check.h"
+#include "actuator.c"
+
+
+#define PWM_TICKS_PER_US   (16.0)
+
+// Nominal DShot timing. The high times are fractions of the bit period.
+#define T1H_RATIO          (0.75)
+#define T0H_RATIO          (0.375)
+#define RATIO_TOLERANCE    (0.02)
+#define PERIOD_TOLERANCE   (0.02)
+
+
+NRF_PWM_Type host_pwm[4];
+NRF_EGU_Type host_egu;
+
+static nrf_drv_pwm_handler_t m_handler;
+static nrf_drv_pwm_config_t  m_config;
+static nrf_pwm_sequence_t    m_seq[2];
+
+HOST_CHECK_DEFINE();
+
+
+uint32_t nrf_drv_pwm_init(nrf_drv_pwm_t const * const p_instance,
+                          nrf_drv_pwm_config_t const * p_config,
+                          nrf_drv_pwm_handler_t handler)
+{
+    m_config  = *p_config;
+    m_handler = handler;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_drv_pwm_complex_playback(nrf_drv_pwm_t const * const p_instance,
+                                      nrf_pwm_sequence_t const * p_sequence_0,
+                                      nrf_pwm_sequence_t const * p_sequence_1,
+                                      uint16_t playback_count,
+                                      uint32_t flags)
+{
+    m_seq[0] = *p_sequence_0;
+    m_seq[1] = *p_sequence_1;
+
+    return NRF_SUCCESS;
+}
+
+
+// A single group is started without PPI.
+void host_task_trigger(uint32_t task)
+{
+}
+
+
+// A DShot sequence is ACTUATOR_SEQ_MIN_US long so commits are never rendered
+// ahead and the clock isn't needed.
+uint32_t app_timer_cnt_get(void)
+{
+    return 0;
+}
+
+
+// The frame is the 11-bit throttle, the telemetry bit and a 4-bit CRC that
+// is the XOR of the three nibbles before it.
+static uint16_t m_reference_encode(uint16_t throttle, bool telemetry)
+{
+    uint16_t frame = 0;
+    uint16_t crc   = 0;
+    int      bit;
+
+    for (bit = 10; bit >= 0; bit--)
+    {
+        frame = ((frame << 1) | ((throttle >> bit) & 1));
+    }
+    frame = ((frame << 1) | (telemetry ? 1 : 0));
+
+    for (bit = 0; bit < 12; bit += 4)
+    {
+        crc ^= ((frame >> bit) & 0x0F);
+    }
+
+    return ((frame << 4) | crc);
+}
+
+
+static void m_frame_encode_check(void)
+{
+    uint32_t throttle;
+    uint32_t telemetry;
+
+    // The example frame from the DShot description.
+    CHECK(0x82C6 == actuator_dshot_frame_encode(1046, false),
+          "1046 encoded as 0x%04X", actuator_dshot_frame_encode(1046, false));
+
+    for (throttle = 0; throttle <= ACTUATOR_DSHOT_THROTTLE_MAX; throttle++)
+    {
+        for (telemetry = 0; telemetry < 2; telemetry++)
+        {
+            uint16_t frame    = actuator_dshot_frame_encode(throttle, telemetry);
+            uint16_t expected = m_reference_encode(throttle, telemetry);
+
+            CHECK(expected == frame,
+                  "throttle %u telemetry %u: 0x%04X, expected 0x%04X",
+                  throttle, telemetry, frame, expected);
+
+            // A receiver checks that the four nibbles XOR to zero.
+            CHECK(0 == ((frame ^ (frame >> 4) ^ (frame >> 8) ^ (frame >> 12)) & 0x0F),
+                  "throttle %u telemetry %u: bad CRC in 0x%04X",
+                  throttle, telemetry, frame);
+        }
+    }
+}
+
+
+static void m_steps_check(const profile_t * p_profile,
+                              const nrf_pwm_values_individual_t * p_steps,
+                              uint16_t frame,
+                              const char * p_name)
+{
+    uint32_t i;
+
+    for (i = 0; i < ACTUATOR_SEQ_MAX_STEPS; i++)
+    {
+        uint16_t expected;
+
+        if (ACTUATOR_DSHOT_FRAME_BITS <= i)
+        {
+            expected = CH_ENABLED_MASK;
+        }
+        else if (frame & (0x8000 >> i))
+        {
+            expected = (CH_ENABLED_MASK | p_profile->t1h);
+        }
+        else
+        {
+            expected = (CH_ENABLED_MASK | p_profile->t0h);
+        }
+
+        CHECK((expected == p_steps[i].channel_0) &&
+              (expected == p_steps[i].channel_1) &&
+              (expected == p_steps[i].channel_2) &&
+              (expected == p_steps[i].channel_3),
+              "%s: step %u of frame 0x%04X is 0x%04X, expected 0x%04X",
+              p_name, i, frame, p_steps[i].channel_0, expected);
+    }
+}
+
+
+static void m_profile_check(actuator_profile_t profile,
+                                double bit_period_us,
+                                const char * p_name)
+{
+    static actuator_group_t group;
+    actuator_group_t *const p_groups[] = {&group};
+    const profile_t         *p_profile = &PROFILES[profile];
+    const uint8_t           values[ACTUATOR_CHANNEL_COUNT] = {50, 50, 50, 50};
+    double                  period_us;
+    double                  frame_us;
+    uint32_t                err_code;
+    uint16_t                throttle;
+
+    err_code = actuator_group_init(&group, 0, profile, 1, 2, 3, 4);
+    CHECK(NRF_SUCCESS == err_code, "%s: init returned %u", p_name, err_code);
+    if (NRF_SUCCESS != err_code)
+    {
+        return;
+    }
+
+    err_code = actuator_groups_start(p_groups, 1);
+    CHECK(NRF_SUCCESS == err_code, "%s: start returned %u", p_name, err_code);
+
+    period_us = (m_config.top_value / PWM_TICKS_PER_US);
+    CHECK(NRF_PWM_CLK_16MHz == m_config.base_clock, "%s: not 16 MHz", p_name);
+    CHECK(fabs(period_us - bit_period_us) <= (bit_period_us * PERIOD_TOLERANCE),
+          "%s: bit period %.3f us, expected %.3f us",
+          p_name, period_us, bit_period_us);
+    CHECK(fabs(((double)p_profile->t1h / m_config.top_value) - T1H_RATIO) <=
+              RATIO_TOLERANCE,
+          "%s: T1H is %u of %u ticks", p_name, p_profile->t1h, m_config.top_value);
+    CHECK(fabs(((double)p_profile->t0h / m_config.top_value) - T0H_RATIO) <=
+              RATIO_TOLERANCE,
+          "%s: T0H is %u of %u ticks", p_name, p_profile->t0h, m_config.top_value);
+
+    // Each sequence is one frame followed by the end delay, and the two
+    // together should last one frame period.
+    frame_us = ((((double)m_seq[0].length / ACTUATOR_CHANNEL_COUNT) +
+                     m_seq[0].end_delay) * period_us);
+    CHECK((ACTUATOR_SEQ_MAX_STEPS * ACTUATOR_CHANNEL_COUNT) == m_seq[0].length,
+          "%s: sequence length %u", p_name, m_seq[0].length);
+    CHECK((0 == m_seq[0].repeats) && (0 == m_seq[1].repeats),
+          "%s: repeats %u", p_name, m_seq[0].repeats);
+    CHECK(fabs(frame_us - ESC_DSHOT_FRAME_PERIOD_US) <= period_us,
+          "%s: frame period %.1f us, expected %lu us",
+          p_name, frame_us, ESC_DSHOT_FRAME_PERIOD_US);
+    CHECK(frame_us >= ACTUATOR_SEQ_MIN_US,
+          "%s: sequence %.1f us is shorter than ACTUATOR_SEQ_MIN_US",
+          p_name, frame_us);
+
+    // Both buffers start with the disarm command.
+    m_steps_check(p_profile, group.seq_values[0], 0x0000, p_name);
+    m_steps_check(p_profile, group.seq_values[1], 0x0000, p_name);
+
+    // A committed value is rendered into the buffer whose END event fired.
+    (void)actuator_values_set(&group, values);
+    m_handler(NRF_DRV_PWM_EVT_END_SEQ0);
+    throttle = scale_map(&p_profile->scale, values[0]);
+    m_steps_check(p_profile,
+                  group.seq_values[0],
+                  actuator_dshot_frame_encode(throttle, false),
+                  p_name);
+    m_steps_check(p_profile, group.seq_values[1], 0x0000, p_name);
+
+    m_handler(NRF_DRV_PWM_EVT_END_SEQ1);
+    m_steps_check(p_profile,
+                  group.seq_values[1],
+                  actuator_dshot_frame_encode(throttle, false),
+                  p_name);
+}
+
+
+int main(void)
+{
+    m_frame_encode_check();
+
+    m_profile_check(ACTUATOR_PROFILE_ESC_DSHOT150, (1000.0 / 150), "DShot150");
+    m_profile_check(ACTUATOR_PROFILE_ESC_DSHOT300, (1000.0 / 300), "DShot300");
+    m_profile_check(ACTUATOR_PROFILE_ESC_DSHOT600, (1000.0 / 600), "DShot600");
+
+    return HOST_CHECK_DONE("dshot_check");
+}
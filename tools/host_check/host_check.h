@@ -0,0 +1,59 @@
+/**
+ * Shared by the host checks: a CHECK macro that counts and reports failures
+ * and a monotonic clock for the timings.
+ *
+ * The timings are taken on the host, so they compare two implementations
+ * with each other and don't give the cycle counts on the target.
+ */
+#ifndef HOST_CHECK_H
+#define HOST_CHECK_H
+
+#include "stdint.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "time.h"
+
+
+extern uint32_t host_check_failures;
+extern uint32_t host_check_count;
+
+
+#define CHECK(cond, ...)                                        \
+do                                                              \
+{                                                               \
+    host_check_count++;                                         \
+    if (!(cond))                                                \
+    {                                                           \
+        host_check_failures++;                                  \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__);             \
+        printf(__VA_ARGS__);                                    \
+        printf("\n");                                           \
+    }                                                           \
+} while (0)
+
+// Defines the counters. Used once per check.
+#define HOST_CHECK_DEFINE()                                     \
+    uint32_t host_check_failures;                               \
+    uint32_t host_check_count
+
+// Prints the summary line and gives the exit status.
+#define HOST_CHECK_DONE(p_name)                                 \
+    (printf("%s: %u of %u checks failed\n",                     \
+            (p_name), host_check_failures, host_check_count),   \
+     ((0 == host_check_failures) ? EXIT_SUCCESS : EXIT_FAILURE))
+
+
+static inline uint64_t host_check_ns(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec);
+}
+
+
+// Keeps the compiler from optimizing away a result that is only timed.
+#define HOST_CHECK_KEEP(x) __asm__ volatile("" : : "g"(x) : "memory")
+
+#endif
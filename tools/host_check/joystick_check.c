@@ -0,0 +1,671 @@
+/**
+ * Checks the sample filters and the stored calibration of
+ * src/examples/common/sainsmart_joystick.c on the host, and evaluates the
+ * filters on noisy ADC traces.
+ *
+ * The samples go through the SAADC callback as they do on the target, and
+ * the filtered readings are taken from the extents that the callback records
+ * for the calibration. It checks that
+ *
+ * - the first sample and a held reading are passed on exactly,
+ * - negative samples read as zero,
+ * - a step settles without overshooting,
+ * - with JOYSTICK_MEDIAN_FILTER, a single spike doesn't reach the output,
+ * - readings within the deadband are reported as the center and the ends of
+ *   the default calibration reach the ends of the range.
+ *
+ * It then checks m_calibrations_load and m_calibrations_save against the
+ * flash page, which the nrf_nvmc stand-ins keep in RAM with flash's
+ * semantics (an erase sets the bits, a write can only clear them). A save is
+ * loaded back and can be saved over. An erased or zeroed page, a record with
+ * another magic number, any single bit flipped in the record and a write cut
+ * short all fall back to the defaults. An invalid channel in a valid record
+ * only falls back for that channel, and raw channels always use the default.
+ *
+ * The evaluation generates a stick held at random positions with Gaussian
+ * noise (what is left of the SAADC's and the pot's noise after the hardware
+ * oversampling), the same with single sample spikes, and a full scale step,
+ * sampled at the transmitter's JOYSTICK_UPDATE_RATE_HZ. It prints the noise
+ * left in the filtered readings, how often the value sent to the receiver
+ * changes while the stick is held, and how long the step takes to reach 50%
+ * and 90%. The Makefile's bench target builds it for each combination of
+ * JOYSTICK_IIR_SHIFT and JOYSTICK_MEDIAN_FILTER so the noise reduction can
+ * be weighed against the latency.
+ */
+#include "math.h"
+#include "string.h"
+
+#include "host_check.h"
+
+// Where the last page of an nRF52832's flash would be. The page is mapped at
+// that address on the host so the driver can read it through a pointer.
+#define JOYSTICK_CALIBRATION_PAGE_ADDR (0x7F000UL)
+
+#include "sainsmart_joystick.c"
+
+#include "sys/mman.h"
+
+
+#define FLASH_PAGE_SIZE    (4096UL)
+#define SAMPLE_RATE_HZ     (50UL)     // The transmitter's JOYSTICK_UPDATE_RATE_HZ
+#define NOISE_RMS          (3.0)      // SAADC counts
+#define SPIKE_PER_MILLE    (10UL)
+#define SPIKE_COUNTS       (300L)
+#define HOLD_SAMPLES       (10UL * SAMPLE_RATE_HZ)
+#define TRACE_SAMPLES      (600UL * SAMPLE_RATE_HZ)
+
+#if JOYSTICK_IIR_SHIFT
+#define SHIFT_SAMPLES      ((IIR_FRAC_BITS + 12UL) << JOYSTICK_IIR_SHIFT)
+// The IIR stops short of a step from below by less than 2^JOYSTICK_IIR_SHIFT
+// fractional counts.
+#define STEP_ERROR         ((((1UL << JOYSTICK_IIR_SHIFT) - 1) + \
+                             (1UL << (IIR_FRAC_BITS - 1))) >> IIR_FRAC_BITS)
+#else
+#define SHIFT_SAMPLES      (1UL)
+#define STEP_ERROR         (0UL)
+#endif
+
+// Samples that a step takes to settle.
+#define SETTLE_SAMPLES     (SHIFT_SAMPLES + JOYSTICK_MEDIAN_FILTER)
+
+
+HOST_CHECK_DEFINE();
+
+
+typedef struct
+{
+    double   input_sq;  // Of the samples
+    double   output_sq; // Of the filtered readings
+    uint32_t peak;      // Largest error of a filtered reading
+    uint32_t samples;
+    uint32_t changes;   // Of the value given to the handler
+} noise_t;
+
+
+NRF_TIMER_Type                       host_timer;
+
+static nrf_drv_saadc_event_handler_t m_saadc_handler;
+static joystick_value_t              m_output;
+static uint32_t                      m_rand_state;
+
+
+void app_error_handler_bare(uint32_t error_code)
+{
+    CHECK(false, "app_error_handler_bare(%u)", error_code);
+}
+
+
+ret_code_t nrf_drv_saadc_init(nrf_drv_saadc_config_t const * p_config,
+                              nrf_drv_saadc_event_handler_t event_handler)
+{
+    m_saadc_handler = event_handler;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t nrf_drv_saadc_channel_init(uint8_t channel,
+                                      nrf_saadc_channel_config_t const * const p_config)
+{
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t nrf_drv_saadc_buffer_convert(nrf_saadc_value_t * buffer, uint16_t size)
+{
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_drv_saadc_sample_task_get(void)
+{
+    return 0;
+}
+
+
+uint32_t nrf_drv_timer_init(nrf_drv_timer_t const * const p_instance,
+                                nrf_drv_timer_config_t const * p_config,
+                                nrf_timer_event_handler_t timer_event_handler)
+{
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_drv_timer_ms_to_ticks(nrf_drv_timer_t const * const p_instance,
+                                       uint32_t time_ms)
+{
+    return (time_ms * 1000UL);
+}
+
+
+void nrf_drv_timer_extended_compare(nrf_drv_timer_t const * const p_instance,
+                                        nrf_timer_cc_channel_t cc_channel,
+                                        uint32_t cc_value,
+                                        nrf_timer_short_mask_t timer_short_mask,
+                                        bool enable_int)
+{
+}
+
+
+void nrf_drv_timer_enable(nrf_drv_timer_t const * const p_instance)
+{
+}
+
+
+uint32_t nrf_drv_timer_compare_event_address_get(nrf_drv_timer_t const * const p_instance,
+                                                     uint32_t channel)
+{
+    return 0;
+}
+
+
+// Flash can only clear bits, so a write ANDs the words into the page.
+void nrf_nvmc_page_erase(uint32_t address)
+{
+    CHECK(JOYSTICK_CALIBRATION_PAGE_ADDR == address, "erase of 0x%08X", address);
+    memset((void *)(uintptr_t)address, 0xFF, FLASH_PAGE_SIZE);
+}
+
+
+void nrf_nvmc_write_words(uint32_t address, const uint32_t * src, uint32_t num_words)
+{
+    uint32_t * p_words = (uint32_t *)(uintptr_t)address;
+    uint32_t   i;
+
+    CHECK((JOYSTICK_CALIBRATION_PAGE_ADDR <= address) &&
+          (0 == (address % sizeof(uint32_t))) &&
+          ((address + (num_words * sizeof(uint32_t))) <=
+              (JOYSTICK_CALIBRATION_PAGE_ADDR + FLASH_PAGE_SIZE)),
+          "write of %u words to 0x%08X", num_words, address);
+
+    for (i = 0; i < num_words; i++)
+    {
+        p_words[i] &= src[i];
+    }
+}
+
+
+static void m_values_handler(const joystick_value_t * p_values, uint32_t count)
+{
+    m_output = p_values[0];
+}
+
+
+static uint32_t m_rand(void)
+{
+    m_rand_state ^= (m_rand_state << 13);
+    m_rand_state ^= (m_rand_state >> 17);
+    m_rand_state ^= (m_rand_state << 5);
+
+    return m_rand_state;
+}
+
+
+static double m_gaussian(void)
+{
+    double u1 = (((double)(m_rand() & 0xFFFFFF) + 1.0) / (double)0x1000001);
+    double u2 = ((double)(m_rand() & 0xFFFFFF) / (double)0x1000000);
+
+    return (sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2));
+}
+
+
+// Maps the flash page and inits one stick channel. The page is erased so the
+// default calibration is used.
+static bool m_init(void)
+{
+    const joystick_channel_config_t channel = {JOYSTICK_PIN_0,
+                                               JOYSTICK_CHANNEL_TYPE_STICK,
+                                               false};
+    void *                          p_page;
+
+    p_page = mmap((void *)JOYSTICK_CALIBRATION_PAGE_ADDR,
+                  FLASH_PAGE_SIZE,
+                  (PROT_READ | PROT_WRITE),
+                  (MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE),
+                  -1,
+                  0);
+    if ((void *)JOYSTICK_CALIBRATION_PAGE_ADDR != p_page)
+    {
+        printf("joystick_check: can't map the calibration page at 0x%08lX\n",
+               JOYSTICK_CALIBRATION_PAGE_ADDR);
+        return false;
+    }
+
+    memset(p_page, 0xFF, FLASH_PAGE_SIZE);
+
+    CHECK(NRF_SUCCESS == joystick_channels_init(0,
+                                                    SAMPLE_RATE_HZ,
+                                                    m_values_handler,
+                                                    &channel,
+                                                    1),
+          "joystick_channels_init");
+
+    return true;
+}
+
+
+// Passes a sample through the SAADC callback and gives the filtered reading.
+static uint32_t m_sample(int32_t sample)
+{
+    nrf_saadc_value_t   buffer[1];
+    nrf_drv_saadc_evt_t event;
+
+    buffer[0]                = (nrf_saadc_value_t)sample;
+    event.type               = NRF_DRV_SAADC_EVT_DONE;
+    event.data.done.p_buffer = buffer;
+    event.data.done.size     = 1;
+
+    m_saadc_handler(&event);
+
+    return m_extents[0].last;
+}
+
+
+static void m_settle(int32_t sample)
+{
+    uint32_t i;
+
+    memset(m_filters, 0, sizeof(m_filters));
+
+    for (i = 0; i < SETTLE_SAMPLES; i++)
+    {
+        (void)m_sample(sample);
+    }
+}
+
+
+static void m_filter_check(void)
+{
+    static const int32_t steps[][2] = {
+        {0, SAADC_MAX_VALUE},
+        {SAADC_MAX_VALUE, 0},
+        {SAINSMART_NEUTRAL_VALUE, (SAINSMART_NEUTRAL_VALUE + 1)},
+        {SAINSMART_NEUTRAL_VALUE, (SAINSMART_NEUTRAL_VALUE - 1)},
+        {SAINSMART_MIN_VALUE, SAINSMART_MAX_VALUE},
+        {SAINSMART_MAX_VALUE, SAINSMART_NEUTRAL_VALUE},
+    };
+    uint32_t             value;
+    uint32_t             lo;
+    uint32_t             hi;
+    uint32_t             i;
+    uint32_t             j;
+
+    for (i = 0; i <= SAADC_MAX_VALUE; i++)
+    {
+        memset(m_filters, 0, sizeof(m_filters));
+
+        value = m_sample(i);
+        CHECK(i == value, "first sample %u read as %u", i, value);
+
+        for (j = 0; j < SETTLE_SAMPLES; j++)
+        {
+            value = m_sample(i);
+        }
+        CHECK(i == value, "held %u read as %u", i, value);
+    }
+
+    memset(m_filters, 0, sizeof(m_filters));
+    value = m_sample(-8);
+    CHECK(0 == value, "negative sample read as %u", value);
+
+    for (i = 0; i < (sizeof(steps) / sizeof(steps[0])); i++)
+    {
+        lo = ((steps[i][0] < steps[i][1]) ? steps[i][0] : steps[i][1]);
+        hi = ((steps[i][0] < steps[i][1]) ? steps[i][1] : steps[i][0]);
+
+        m_settle(steps[i][0]);
+
+        for (j = 0; j < SETTLE_SAMPLES; j++)
+        {
+            value = m_sample(steps[i][1]);
+            CHECK((lo <= value) && (value <= hi),
+                  "step from %d to %d read as %u", steps[i][0], steps[i][1], value);
+        }
+
+        CHECK((uint32_t)abs((int32_t)value - steps[i][1]) <= STEP_ERROR,
+              "step from %d to %d settled at %u", steps[i][0], steps[i][1], value);
+    }
+
+#if JOYSTICK_MEDIAN_FILTER
+    m_settle(SAINSMART_NEUTRAL_VALUE);
+    value = m_sample(SAADC_MAX_VALUE);
+
+    for (j = 0; j < SETTLE_SAMPLES; j++)
+    {
+        CHECK(SAINSMART_NEUTRAL_VALUE == value, "spike read as %u", value);
+        value = m_sample(SAINSMART_NEUTRAL_VALUE);
+    }
+#endif
+
+    m_settle(SAINSMART_NEUTRAL_VALUE - JOYSTICK_DEADBAND);
+    CHECK(OUTPUT_CENTER_VALUE == m_output, "low edge of the deadband gave %u", m_output);
+
+    m_settle(SAINSMART_NEUTRAL_VALUE + JOYSTICK_DEADBAND);
+    CHECK(OUTPUT_CENTER_VALUE == m_output, "high edge of the deadband gave %u", m_output);
+
+    m_settle(SAINSMART_MIN_VALUE);
+    CHECK(JOYSTICK_MIN_VALUE == m_output, "minimum gave %u", m_output);
+
+    m_settle(SAINSMART_MAX_VALUE);
+    CHECK(JOYSTICK_MAX_VALUE == m_output, "maximum gave %u", m_output);
+}
+
+
+static void m_calibrations_expect(const char * p_case,
+                                      const joystick_axis_calibration_t expected[JOYSTICK_MAX_CHANNELS])
+{
+    joystick_axis_calibration_t calibrations[JOYSTICK_MAX_CHANNELS];
+    uint32_t                    i;
+
+    joystick_calibration_get(calibrations);
+
+    for (i = 0; i < JOYSTICK_MAX_CHANNELS; i++)
+    {
+        CHECK(0 == memcmp(&calibrations[i], &expected[i], sizeof(calibrations[i])),
+              "%s: channel %u is %u/%u/%u instead of %u/%u/%u",
+              p_case, i,
+              calibrations[i].min, calibrations[i].center, calibrations[i].max,
+              expected[i].min, expected[i].center, expected[i].max);
+    }
+}
+
+
+// Writes a record with a valid checksum.
+static void m_record_write(uint32_t magic,
+                               const joystick_axis_calibration_t channels[JOYSTICK_MAX_CHANNELS])
+{
+    calibration_record_t * p_page = (calibration_record_t *)JOYSTICK_CALIBRATION_PAGE_ADDR;
+
+    memset(p_page, 0xFF, FLASH_PAGE_SIZE);
+    memset(p_page, 0, sizeof(calibration_record_t));
+
+    p_page->magic = magic;
+    memcpy(p_page->channels, channels, sizeof(p_page->channels));
+    p_page->checksum = m_record_checksum(p_page);
+}
+
+
+static void m_calibration_check(void)
+{
+    static const joystick_channel_type_t types[JOYSTICK_MAX_CHANNELS] = {
+        JOYSTICK_CHANNEL_TYPE_STICK,
+        JOYSTICK_CHANNEL_TYPE_LINEAR,
+        JOYSTICK_CHANNEL_TYPE_RAW,
+        JOYSTICK_CHANNEL_TYPE_STICK,
+        // The rest are unused, which init treats as raw.
+        JOYSTICK_CHANNEL_TYPE_RAW,
+        JOYSTICK_CHANNEL_TYPE_RAW,
+        JOYSTICK_CHANNEL_TYPE_RAW,
+        JOYSTICK_CHANNEL_TYPE_RAW,
+    };
+    static const struct
+    {
+        uint32_t                    channel;
+        joystick_axis_calibration_t calibration;
+    } invalid[] = {
+        {0, {200, 1700, (SAADC_MAX_VALUE + 1)}},
+        {0, {1700, 1700, 3300}},
+        {0, {200, 3300, 3300}},
+        {0, {3300, 1700, 200}},
+        {0, {(1700 - JOYSTICK_DEADBAND - CALIBRATION_MIN_SPAN + 1), 1700, 3300}},
+        {0, {200, 1700, (1700 + JOYSTICK_DEADBAND + CALIBRATION_MIN_SPAN - 1)}},
+        {1, {1000, (1000 + CALIBRATION_MIN_SPAN - 1), 3900}},
+        {3, {0xFFFF, 0xFFFF, 0xFFFF}},
+    };
+    const calibration_record_t * p_page   = (const calibration_record_t *)JOYSTICK_CALIBRATION_PAGE_ADDR;
+    joystick_channel_type_t      saved_types[JOYSTICK_MAX_CHANNELS];
+    joystick_axis_calibration_t  defaults[JOYSTICK_MAX_CHANNELS];
+    joystick_axis_calibration_t  custom[JOYSTICK_MAX_CHANNELS];
+    joystick_axis_calibration_t  other[JOYSTICK_MAX_CHANNELS];
+    joystick_axis_calibration_t  expected[JOYSTICK_MAX_CHANNELS];
+    calibration_record_t         record;
+    uint8_t *                    p_bytes;
+    uint32_t                     i;
+
+    memcpy(saved_types, m_channel_types, sizeof(saved_types));
+    memcpy(m_channel_types, types, sizeof(m_channel_types));
+
+    for (i = 0; i < JOYSTICK_MAX_CHANNELS; i++)
+    {
+        m_default_calibration(types[i], &defaults[i]);
+
+        custom[i].min    = (200 + i);
+        custom[i].center = (1700 + i);
+        custom[i].max    = (3300 + i);
+
+        other[i].min    = (400 + i);
+        other[i].center = (2000 + i);
+        other[i].max    = (3600 + i);
+    }
+
+    // Raw channels are never calibrated, whatever the record holds.
+    memcpy(expected, custom, sizeof(expected));
+    for (i = 0; i < JOYSTICK_MAX_CHANNELS; i++)
+    {
+        if (JOYSTICK_CHANNEL_TYPE_RAW == types[i])
+        {
+            expected[i] = defaults[i];
+        }
+    }
+
+    memset((void *)p_page, 0xFF, FLASH_PAGE_SIZE);
+    m_calibrations_load();
+    m_calibrations_expect("erased page", defaults);
+
+    memset((void *)p_page, 0x00, FLASH_PAGE_SIZE);
+    m_calibrations_load();
+    m_calibrations_expect("zeroed page", defaults);
+
+    // A save and a load give back the calibration in use.
+    m_calibrations_apply(custom);
+    CHECK(NRF_SUCCESS == joystick_calibration_save(), "joystick_calibration_save");
+    CHECK(CALIBRATION_MAGIC == p_page->magic, "saved magic 0x%08X", p_page->magic);
+    CHECK(m_record_checksum(p_page) == p_page->checksum,
+          "saved checksum 0x%08X", p_page->checksum);
+    m_calibrations_apply(defaults);
+    m_calibrations_load();
+    m_calibrations_expect("saved record", expected);
+
+    // A save over a record erases it first, since flash can only clear bits.
+    m_calibrations_apply(other);
+    m_calibrations_save();
+    m_calibrations_load();
+    for (i = 0; i < JOYSTICK_MAX_CHANNELS; i++)
+    {
+        expected[i] = ((JOYSTICK_CHANNEL_TYPE_RAW == types[i]) ? defaults[i] : other[i]);
+    }
+    m_calibrations_expect("record saved over", expected);
+
+    CHECK(NRF_SUCCESS == joystick_calibration_start(), "joystick_calibration_start");
+    CHECK(NRF_ERROR_INVALID_STATE == joystick_calibration_save(),
+          "joystick_calibration_save while calibrating");
+    m_calibrating = false;
+
+    // Any single bit flipped in the record discards all of it.
+    m_calibrations_apply(custom);
+    m_calibrations_save();
+    memcpy(&record, p_page, sizeof(record));
+    p_bytes = (uint8_t *)p_page;
+
+    for (i = 0; i < (8 * sizeof(record)); i++)
+    {
+        p_bytes[i / 8] ^= (1U << (i % 8));
+        m_calibrations_load();
+        m_calibrations_expect("bit flipped", defaults);
+        p_bytes[i / 8] ^= (1U << (i % 8));
+    }
+
+    // So does a record whose write was cut short, e.g. by a reset.
+    for (i = 0; i < (sizeof(record) / sizeof(uint32_t)); i++)
+    {
+        nrf_nvmc_page_erase(JOYSTICK_CALIBRATION_PAGE_ADDR);
+        nrf_nvmc_write_words(JOYSTICK_CALIBRATION_PAGE_ADDR, (const uint32_t *)&record, i);
+        m_calibrations_load();
+        m_calibrations_expect("partial write", defaults);
+    }
+
+    // And one that was written with another magic number, e.g. by an older
+    // firmware with a different layout.
+    m_record_write((CALIBRATION_MAGIC - 1), custom);
+    m_calibrations_load();
+    m_calibrations_expect("old magic", defaults);
+
+    // An invalid channel in a valid record only falls back for that channel.
+    for (i = 0; i < (sizeof(invalid) / sizeof(invalid[0])); i++)
+    {
+        uint32_t channel = invalid[i].channel;
+
+        memcpy(other, custom, sizeof(other));
+        other[channel] = invalid[i].calibration;
+        m_record_write(CALIBRATION_MAGIC, other);
+
+        memcpy(expected, custom, sizeof(expected));
+        for (uint32_t j = 0; j < JOYSTICK_MAX_CHANNELS; j++)
+        {
+            if ((JOYSTICK_CHANNEL_TYPE_RAW == types[j]) || (channel == j))
+            {
+                expected[j] = defaults[j];
+            }
+        }
+
+        m_calibrations_load();
+        m_calibrations_expect("invalid channel", expected);
+    }
+
+    memcpy(m_channel_types, saved_types, sizeof(m_channel_types));
+    memset((void *)p_page, 0xFF, FLASH_PAGE_SIZE);
+    m_calibrations_load();
+}
+
+
+// Holds the stick at random positions within the default calibration, each
+// for HOLD_SAMPLES, and measures the filtered readings once they have
+// settled after a move.
+static void m_held_run(uint32_t spike_per_mille, noise_t * p_noise)
+{
+    joystick_value_t last_output = 0;
+    int32_t          position    = 0;
+    int32_t          sample;
+    int32_t          error;
+    uint32_t         value;
+    uint32_t         i;
+
+    memset(p_noise, 0, sizeof(noise_t));
+    memset(m_filters, 0, sizeof(m_filters));
+
+    m_rand_state = 0x5EED1234UL;
+
+    for (i = 0; i < TRACE_SAMPLES; i++)
+    {
+        if (0 == (i % HOLD_SAMPLES))
+        {
+            position = (SAINSMART_MIN_VALUE +
+                        (m_rand() % (SAINSMART_MAX_VALUE - SAINSMART_MIN_VALUE)));
+        }
+
+        sample = (position + lround(NOISE_RMS * m_gaussian()));
+
+        if ((m_rand() % 1000) < spike_per_mille)
+        {
+            sample += ((m_rand() & 1) ? SPIKE_COUNTS : -SPIKE_COUNTS);
+        }
+
+        // The SAADC saturates at the top. Negative readings are passed on.
+        if ((int32_t)SAADC_MAX_VALUE < sample)
+        {
+            sample = SAADC_MAX_VALUE;
+        }
+
+        value = m_sample(sample);
+
+        if (SETTLE_SAMPLES <= (i % HOLD_SAMPLES))
+        {
+            error = ((int32_t)value - position);
+
+            p_noise->input_sq  += ((double)(sample - position) * (sample - position));
+            p_noise->output_sq += ((double)error * error);
+            p_noise->peak       = ((p_noise->peak < (uint32_t)abs(error)) ?
+                                       (uint32_t)abs(error) : p_noise->peak);
+            p_noise->changes   += (last_output != m_output);
+            p_noise->samples++;
+        }
+
+        last_output = m_output;
+    }
+}
+
+
+// Gives the number of samples after a full scale step until the filtered
+// reading gets to percent of the step.
+static uint32_t m_step_samples(uint32_t percent)
+{
+    uint32_t target = (SAINSMART_MIN_VALUE +
+                       (((SAINSMART_MAX_VALUE - SAINSMART_MIN_VALUE) * percent) / 100));
+    uint32_t i;
+
+    m_settle(SAINSMART_MIN_VALUE);
+
+    for (i = 0; i < SETTLE_SAMPLES; i++)
+    {
+        if (target <= m_sample(SAINSMART_MAX_VALUE))
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+
+static void m_evaluate(bool header)
+{
+    noise_t noise;
+    noise_t spikes;
+
+    m_held_run(0, &noise);
+    m_held_run(SPIKE_PER_MILLE, &spikes);
+
+    if (header)
+    {
+        printf("joystick_check: %u Hz samples, noise %.1f counts rms, %u%% spikes of "
+               "%ld counts (errors in SAADC counts)\n",
+               (uint32_t)SAMPLE_RATE_HZ, NOISE_RMS, (uint32_t)(SPIKE_PER_MILLE / 10),
+               SPIKE_COUNTS);
+        printf("  %4s %6s %7s %6s %7s %6s %10s %7s %7s\n",
+               "iir", "median", "noise", "dB", "spikes", "peak", "changes/s",
+               "50% ms", "90% ms");
+    }
+
+    printf("  %4u %6u %7.2f %6.1f %7.2f %6u %10.2f %7u %7u\n",
+           (uint32_t)JOYSTICK_IIR_SHIFT,
+           (uint32_t)JOYSTICK_MEDIAN_FILTER,
+           sqrt(noise.output_sq / noise.samples),
+           (10.0 * log10(noise.input_sq / noise.output_sq)),
+           sqrt(spikes.output_sq / spikes.samples),
+           spikes.peak,
+           ((noise.changes * (double)SAMPLE_RATE_HZ) / noise.samples),
+           (uint32_t)((m_step_samples(50) * 1000UL) / SAMPLE_RATE_HZ),
+           (uint32_t)((m_step_samples(90) * 1000UL) / SAMPLE_RATE_HZ));
+}
+
+
+int main(int argc, char * argv[])
+{
+    bool eval = ((1 < argc) && (0 == strcmp(argv[1], "--eval")));
+
+    if (!m_init())
+    {
+        return EXIT_FAILURE;
+    }
+
+    m_filter_check();
+    m_calibration_check();
+    m_evaluate(!eval);
+
+    if (eval)
+    {
+        return ((0 == host_check_failures) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    return HOST_CHECK_DONE("joystick_check");
+}
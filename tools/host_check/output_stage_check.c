@@ -0,0 +1,595 @@
+/**
+ * Checks src/examples/common/output_stage.c on the host and evaluates it
+ * against a stick trace under simulated loss.
+ *
+ * - Frames that arrive on time are applied as they are.
+ * - A late frame is extrapolated from the time it was due for at most one
+ *   interval and the outputs are then held.
+ * - With a keepalive a late frame is held instead.
+ * - The outputs slew back after a gap.
+ *
+ * The evaluation replays a stick trace through a 100 Hz link that loses
+ * frames (independently or in bursts) into the output stage updating at
+ * 50 Hz, and compares the outputs with the stick at each update. It does the
+ * same for a receiver that just holds the last frame, and reports the largest
+ * step between consecutive updates next to the errors. By default the trace is
+ * generated (moves between random positions with some tremor); a capture can
+ * be used instead:
+ *
+ *     ./trace_decode.py --csv trace.bin > sticks.csv
+ *     ./output_stage_check --trace sticks.csv
+ *
+ * which replays the TX_JOYSTICK_RAW records. With --bench it also times
+ * output_stage_frame_put and the update handler.
+ */
+#include "math.h"
+#include "string.h"
+
+#include "host_check.h"
+#include "output_stage.c"
+
+
+#define CHANNELS          (4UL)
+#define TX_RATE_HZ        (100UL)
+#define TX_INTERVAL_US    (1000000UL / TX_RATE_HZ)
+#define RX_LATENCY_US     (600UL)   // Start of the interval to frame_put
+#define UPDATE_MS         (20UL)
+#define UPDATE_OFFSET_US  (3100UL)  // The update timer isn't aligned with the link
+#define TRACE_SECONDS     (120UL)
+#define TRACE_MAX_SAMPLES (200000UL)
+#define BENCH_ITERATIONS  (10000000UL)
+
+
+HOST_CHECK_DEFINE();
+
+
+typedef struct
+{
+    const char * p_name;
+    float        p_loss_good;
+    float        p_loss_bad;
+    float        p_good_to_bad; // 0 for independent loss
+    float        p_bad_to_good;
+} loss_model_t;
+
+
+static uint64_t                    m_now_us;
+static uint32_t                    m_rand_state;
+static app_timer_timeout_handler_t m_update;
+static uint32_t                    m_update_ticks;
+static rc_radio_data_t             m_applied;
+static uint32_t                    m_applied_count;
+
+// The stick trace: sample times and values in [0, JOYSTICK_MAX_VALUE].
+static double   m_trace_s[TRACE_MAX_SAMPLES];
+static float    m_trace[TRACE_MAX_SAMPLES][CHANNELS];
+static uint32_t m_trace_len;
+
+
+uint32_t app_timer_cnt_get(void)
+{
+    return (uint32_t)(((m_now_us * APP_TIMER_CLOCK_FREQ) / 1000000UL) & 0x00FFFFFFUL);
+}
+
+
+uint32_t app_timer_create(app_timer_id_t const * p_timer_id,
+                          app_timer_mode_t mode,
+                          app_timer_timeout_handler_t timeout_handler)
+{
+    m_update = timeout_handler;
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_timer_start(app_timer_id_t timer_id,
+                         uint32_t timeout_ticks,
+                         void * p_context)
+{
+    m_update_ticks = timeout_ticks;
+    return NRF_SUCCESS;
+}
+
+
+static void m_controls_apply(const rc_radio_data_t * p_data)
+{
+    m_applied = *p_data;
+    m_applied_count++;
+}
+
+
+static uint32_t m_rand(void)
+{
+    m_rand_state ^= (m_rand_state << 13);
+    m_rand_state ^= (m_rand_state >> 17);
+    m_rand_state ^= (m_rand_state << 5);
+
+    return m_rand_state;
+}
+
+
+static double m_uniform(void)
+{
+    return ((double)(m_rand() & 0xFFFFFF) / (double)0x1000000);
+}
+
+
+static void m_frame_set(rc_radio_data_t * p_data, const float values[CHANNELS])
+{
+    memset(p_data, 0, sizeof(rc_radio_data_t));
+    p_data->throttle = (uint8_t)lroundf(values[0]);
+    p_data->pitch    = (int8_t)lroundf(values[1]);
+    p_data->roll     = (int8_t)lroundf(values[2]);
+    p_data->yaw      = (int8_t)lroundf(values[3]);
+}
+
+
+static void m_frame_get(const rc_radio_data_t * p_data, float values[CHANNELS])
+{
+    values[0] = p_data->throttle;
+    values[1] = p_data->pitch;
+    values[2] = p_data->roll;
+    values[3] = p_data->yaw;
+}
+
+
+static void m_init(uint16_t keepalive_interval)
+{
+    rc_radio_bind_info_t bind_info = {RC_RADIO_TRANSMITTER_CHANNEL_A,
+                                      TX_RATE_HZ,
+                                      keepalive_interval};
+
+    m_now_us        = 0;
+    m_applied_count = 0;
+
+    CHECK(NRF_SUCCESS == output_stage_init(UPDATE_MS, m_controls_apply), "init failed");
+    CHECK(APP_TIMER_TICKS(UPDATE_MS) == m_update_ticks, "%u ticks", m_update_ticks);
+    output_stage_bind_info_set(&bind_info);
+}
+
+
+static void m_put(uint64_t at_us, uint8_t value)
+{
+    rc_radio_data_t data;
+
+    memset(&data, 0, sizeof(data));
+    data.throttle = value;
+
+    m_now_us = at_us;
+    output_stage_frame_put(&data);
+}
+
+
+static uint8_t m_update_at(uint64_t at_us)
+{
+    m_now_us = at_us;
+    m_update(NULL);
+
+    return m_applied.throttle;
+}
+
+
+static void m_on_time_check(void)
+{
+    uint32_t k;
+
+    m_init(0);
+
+    // A ramp of 2 per frame. Every update in between applies the newest frame.
+    for (k = 0; k < 20; k++)
+    {
+        m_put((k * TX_INTERVAL_US), (uint8_t)(2 * k));
+        CHECK((2 * k) == m_update_at((k * TX_INTERVAL_US) + (TX_INTERVAL_US / 2)),
+              "frame %u: applied %u", k, m_applied.throttle);
+        CHECK((2 * k) == m_update_at(((k + 1) * TX_INTERVAL_US) - 100),
+              "frame %u: applied %u just before the next one", k, m_applied.throttle);
+    }
+}
+
+
+static void m_late_check(void)
+{
+    uint64_t last_us;
+    uint32_t k;
+
+    m_init(0);
+
+    for (k = 0; k < 10; k++)
+    {
+        m_put((k * TX_INTERVAL_US), (uint8_t)(40 + (2 * k)));
+    }
+    last_us = ((k - 1) * TX_INTERVAL_US);
+
+    // The next frame is due at last_us + TX_INTERVAL_US. Half an interval
+    // after that the ramp has carried on by one, a full interval after it by
+    // two and it stays there.
+    CHECK(58 == m_update_at(last_us + TX_INTERVAL_US - 100), "applied %u", m_applied.throttle);
+    CHECK(59 == m_update_at(last_us + (3 * TX_INTERVAL_US / 2)), "applied %u", m_applied.throttle);
+    CHECK(60 == m_update_at(last_us + (2 * TX_INTERVAL_US)), "applied %u", m_applied.throttle);
+    CHECK(60 == m_update_at(last_us + (10 * TX_INTERVAL_US)), "applied %u", m_applied.throttle);
+
+    // The frame after the gap is reached by slewing at most
+    // OUTPUT_STAGE_RECOVERY_SLEW per update.
+    m_put(last_us + (11 * TX_INTERVAL_US), 80);
+    CHECK((60 + OUTPUT_STAGE_RECOVERY_SLEW) == m_update_at(last_us + (11 * TX_INTERVAL_US) + 100),
+          "applied %u", m_applied.throttle);
+}
+
+
+static void m_keepalive_check(void)
+{
+    uint64_t last_us;
+    uint32_t k;
+
+    m_init(10);
+
+    for (k = 0; k < 10; k++)
+    {
+        m_put((k * TX_INTERVAL_US), (uint8_t)(40 + (2 * k)));
+    }
+    last_us = ((k - 1) * TX_INTERVAL_US);
+
+    // Nothing new was sent so the outputs stay at the last frame's values.
+    CHECK(58 == m_update_at(last_us + (3 * TX_INTERVAL_US / 2)), "applied %u", m_applied.throttle);
+    CHECK(58 == m_update_at(last_us + (5 * TX_INTERVAL_US)), "applied %u", m_applied.throttle);
+
+    // The keepalive doesn't slew.
+    m_put(last_us + (10 * TX_INTERVAL_US), 58);
+    CHECK(58 == m_update_at(last_us + (10 * TX_INTERVAL_US) + 100), "applied %u", m_applied.throttle);
+}
+
+
+// Moves between random positions, taking 100 to 400 ms for each move and
+// resting for up to a second, with a little tremor on top.
+static void m_trace_generate(void)
+{
+    double   from[CHANNELS];
+    double   to[CHANNELS];
+    double   move_start_s[CHANNELS];
+    double   move_len_s[CHANNELS];
+    double   t;
+    uint32_t i;
+    uint32_t ch;
+
+    m_rand_state = 0x9E3779B9UL;
+    m_trace_len  = 0;
+
+    for (ch = 0; ch < CHANNELS; ch++)
+    {
+        from[ch]         = 50.0;
+        to[ch]           = 50.0;
+        move_start_s[ch] = 0.0;
+        move_len_s[ch]   = 0.1;
+    }
+
+    for (i = 0; i < (TRACE_SECONDS * 1000UL); i++)
+    {
+        t = (i / 1000.0);
+        m_trace_s[i] = t;
+
+        for (ch = 0; ch < CHANNELS; ch++)
+        {
+            double phase = ((t - move_start_s[ch]) / move_len_s[ch]);
+            double value;
+
+            if (phase >= 1.0)
+            {
+                // Rest, then start the next move.
+                if (m_uniform() < 0.002)
+                {
+                    from[ch]         = to[ch];
+                    to[ch]           = (JOYSTICK_MAX_VALUE * m_uniform());
+                    move_start_s[ch] = t;
+                    move_len_s[ch]   = (0.1 + (0.3 * m_uniform()));
+                    phase            = 0.0;
+                }
+                else
+                {
+                    phase = 1.0;
+                }
+            }
+
+            value  = (from[ch] + ((to[ch] - from[ch]) * (0.5 - (0.5 * cos(M_PI * phase)))));
+            value += (0.5 * sin((2 * M_PI * 8.0 * t) + ch));
+
+            if (value < 0.0)
+            {
+                value = 0.0;
+            }
+            else if (value > JOYSTICK_MAX_VALUE)
+            {
+                value = JOYSTICK_MAX_VALUE;
+            }
+            m_trace[i][ch] = (float)value;
+        }
+    }
+    m_trace_len = i;
+}
+
+
+// Reads the TX_JOYSTICK_RAW records of trace_decode.py --csv and scales the
+// raw SAADC readings to the output range.
+static bool m_trace_load(const char * p_path)
+{
+    FILE *   p_file = fopen(p_path, "r");
+    char     line[256];
+    char     event[64];
+    double   t;
+    int      raw[CHANNELS];
+    uint32_t ch;
+
+    if (NULL == p_file)
+    {
+        return false;
+    }
+
+    m_trace_len = 0;
+
+    while ((NULL != fgets(line, sizeof(line), p_file)) &&
+           (TRACE_MAX_SAMPLES > m_trace_len))
+    {
+        if ((6 != sscanf(line, "%lf,%63[^,],%d,%d,%d,%d",
+                         &t, event, &raw[0], &raw[1], &raw[2], &raw[3])) ||
+            (0 != strcmp(event, "TX_JOYSTICK_RAW")))
+        {
+            continue;
+        }
+
+        m_trace_s[m_trace_len] = t;
+        for (ch = 0; ch < CHANNELS; ch++)
+        {
+            m_trace[m_trace_len][ch] = ((float)raw[ch] * JOYSTICK_MAX_VALUE) / 4095.0f;
+        }
+        m_trace_len++;
+    }
+
+    fclose(p_file);
+
+    return (1 < m_trace_len);
+}
+
+
+// The trace linearly interpolated at the given time.
+static void m_trace_at(double t, float values[CHANNELS], uint32_t * p_index)
+{
+    uint32_t i = *p_index;
+    double   f;
+    uint32_t ch;
+
+    while (((i + 2) < m_trace_len) && (m_trace_s[i + 1] <= t))
+    {
+        i++;
+    }
+    *p_index = i;
+
+    f = ((t - m_trace_s[i]) / (m_trace_s[i + 1] - m_trace_s[i]));
+    if (f < 0.0)
+    {
+        f = 0.0;
+    }
+    else if (f > 1.0)
+    {
+        f = 1.0;
+    }
+
+    for (ch = 0; ch < CHANNELS; ch++)
+    {
+        values[ch] = (float)(m_trace[i][ch] + ((m_trace[i + 1][ch] - m_trace[i][ch]) * f));
+    }
+}
+
+
+static void m_evaluate(const loss_model_t * p_loss)
+{
+    float           truth[CHANNELS];
+    float           values[CHANNELS];
+    float           held[CHANNELS];
+    float           last[2][CHANNELS];
+    rc_radio_data_t frame;
+    double          err_sq[2]   = {0.0, 0.0};
+    double          err_max[2]  = {0.0, 0.0};
+    double          step_max[2] = {0.0, 0.0};
+    double          duration_s;
+    uint64_t        next_frame_us;
+    uint64_t        next_update_us;
+    uint64_t        end_us;
+    uint32_t        frame_index  = 0;
+    uint32_t        update_index = 0;
+    uint32_t        updates      = 0;
+    uint32_t        frames       = 0;
+    uint32_t        lost         = 0;
+    uint32_t        ch;
+    bool            bad          = false;
+    bool            have_frame   = false;
+
+    m_init(0);
+    m_rand_state = 0x2545F491UL;
+
+    duration_s     = (m_trace_s[m_trace_len - 1] - m_trace_s[0]);
+    end_us         = (uint64_t)(duration_s * 1e6);
+    next_frame_us  = 0;
+    next_update_us = UPDATE_OFFSET_US;
+
+    while (next_update_us < end_us)
+    {
+        if ((next_frame_us + RX_LATENCY_US) <= next_update_us)
+        {
+            // The transmitter samples the sticks at the start of the interval.
+            bool is_lost;
+
+            if (bad)
+            {
+                bad = (m_uniform() >= p_loss->p_bad_to_good);
+            }
+            else
+            {
+                bad = (m_uniform() < p_loss->p_good_to_bad);
+            }
+            is_lost = (m_uniform() < (bad ? p_loss->p_loss_bad : p_loss->p_loss_good));
+
+            frames++;
+            if (!is_lost)
+            {
+                m_trace_at((m_trace_s[0] + (next_frame_us / 1e6)), values, &frame_index);
+                m_frame_set(&frame, values);
+
+                m_now_us = (next_frame_us + RX_LATENCY_US);
+                output_stage_frame_put(&frame);
+
+                m_frame_get(&frame, held);
+                have_frame = true;
+            }
+            else
+            {
+                lost++;
+            }
+
+            next_frame_us += TX_INTERVAL_US;
+            continue;
+        }
+
+        m_now_us = next_update_us;
+        m_update(NULL);
+
+        if (have_frame)
+        {
+            m_trace_at((m_trace_s[0] + (next_update_us / 1e6)), truth, &update_index);
+            m_frame_get(&m_applied, values);
+
+            for (ch = 0; ch < CHANNELS; ch++)
+            {
+                double err[2] = {fabs(values[ch] - truth[ch]), fabs(held[ch] - truth[ch])};
+                float  out[2] = {values[ch], held[ch]};
+                uint32_t j;
+
+                for (j = 0; j < 2; j++)
+                {
+                    err_sq[j] += (err[j] * err[j]);
+                    if (err[j] > err_max[j])
+                    {
+                        err_max[j] = err[j];
+                    }
+
+                    // The largest jump that the servos see between updates.
+                    if ((0 < updates) && (fabs(out[j] - last[j][ch]) > step_max[j]))
+                    {
+                        step_max[j] = fabs(out[j] - last[j][ch]);
+                    }
+                    last[j][ch] = out[j];
+                }
+            }
+            updates++;
+        }
+
+        next_update_us += (UPDATE_MS * 1000UL);
+    }
+
+    CHECK(0 < updates, "%s: no updates", p_loss->p_name);
+
+    // Results as a percentage of the range.
+    printf("  %-20s %6.2f %7.2f %7.2f %7.2f %7.2f %7.2f %7.2f\n",
+           p_loss->p_name,
+           ((100.0 * lost) / frames),
+           ((100.0 * sqrt(err_sq[0] / (updates * CHANNELS))) / JOYSTICK_MAX_VALUE),
+           ((100.0 * err_max[0]) / JOYSTICK_MAX_VALUE),
+           ((100.0 * step_max[0]) / JOYSTICK_MAX_VALUE),
+           ((100.0 * sqrt(err_sq[1] / (updates * CHANNELS))) / JOYSTICK_MAX_VALUE),
+           ((100.0 * err_max[1]) / JOYSTICK_MAX_VALUE),
+           ((100.0 * step_max[1]) / JOYSTICK_MAX_VALUE));
+}
+
+
+static void m_bench(void)
+{
+    rc_radio_data_t frames[2] = {{50, 10, -10, 20, 0}, {52, 12, -8, 22, 0}};
+    uint64_t        start;
+    double          put_ns;
+    double          update_ns;
+    uint32_t        i;
+
+    m_init(0);
+
+    start = host_check_ns();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        m_now_us += TX_INTERVAL_US;
+        output_stage_frame_put(&frames[i & 1]);
+    }
+    put_ns = ((double)(host_check_ns() - start) / BENCH_ITERATIONS);
+
+    // Every other update extrapolates a late frame.
+    start = host_check_ns();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        m_now_us += ((i & 1) ? (TX_INTERVAL_US / 2) : (TX_INTERVAL_US + (TX_INTERVAL_US / 2)));
+        m_update(NULL);
+        HOST_CHECK_KEEP(m_applied.throttle);
+        m_now_us -= ((i & 1) ? (TX_INTERVAL_US / 2) : (TX_INTERVAL_US + (TX_INTERVAL_US / 2)));
+    }
+    update_ns = ((double)(host_check_ns() - start) / BENCH_ITERATIONS);
+
+    printf("output_stage_check: host ns per call\n");
+    printf("  %-22s %8.1f\n", "output_stage_frame_put", put_ns);
+    printf("  %-22s %8.1f\n", "update handler", update_ns);
+}
+
+
+int main(int argc, char * argv[])
+{
+    static const loss_model_t losses[] = {
+        {"no loss",            0.0f,  0.0f, 0.0f,  0.0f},
+        {"independent 5%",     0.05f, 0.0f, 0.0f,  0.0f},
+        {"independent 20%",    0.20f, 0.0f, 0.0f,  0.0f},
+        {"bursty",             0.01f, 0.8f, 0.02f, 0.2f},
+    };
+    const char * p_trace = NULL;
+    bool         bench   = false;
+    int          i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (0 == strcmp(argv[i], "--bench"))
+        {
+            bench = true;
+        }
+        else if ((0 == strcmp(argv[i], "--trace")) && ((i + 1) < argc))
+        {
+            p_trace = argv[++i];
+        }
+    }
+
+    m_on_time_check();
+    m_late_check();
+    m_keepalive_check();
+
+    if (NULL != p_trace)
+    {
+        CHECK(m_trace_load(p_trace), "no TX_JOYSTICK_RAW records in %s", p_trace);
+    }
+    else
+    {
+        m_trace_generate();
+    }
+
+    if (1 < m_trace_len)
+    {
+        printf("output_stage_check: %s, %u Hz link, %u ms updates "
+               "(errors in %% of the range)\n",
+               ((NULL != p_trace) ? p_trace : "generated trace"),
+               (uint32_t)TX_RATE_HZ, (uint32_t)UPDATE_MS);
+        printf("  %-20s %6s %23s %23s\n", "", "lost", "output_stage", "hold");
+        printf("  %-20s %6s %7s %7s %7s %7s %7s %7s\n",
+               "", "", "rms", "max", "step", "rms", "max", "step");
+
+        for (i = 0; i < (int)(sizeof(losses) / sizeof(losses[0])); i++)
+        {
+            m_evaluate(&losses[i]);
+        }
+    }
+
+    if (bench)
+    {
+        m_bench();
+    }
+
+    return HOST_CHECK_DONE("output_stage_check");
+}
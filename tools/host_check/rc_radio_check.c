@@ -0,0 +1,1431 @@
+/**
+ * Runs src/rc_radio.c on the host against stand-ins for nrf_esb and the timer
+ * driver and checks the receiver's delivery of the payloads: binding, data
+ * and auxiliary payloads arriving intact and, with RC_RADIO_ZERO_COPY_RX, the
+ * pool buffers being handed out, retained, released and reported as dropped
+ * once they are all in use.
+ *
+ * On the transmitter's side it checks that the CC0 branch of the timer
+ * handler hands nrf_esb_write_payload the buffer that rc_radio_data_set
+ * staged, and that the last one sent isn't written while the next one is
+ * staged.
+ *
+ * It then runs SIM_LINKS transmitter and receiver pairs of rc_radio_ctx_t
+ * for SIM_DURATION_MS of simulated time, with random rates, transmitter
+ * channels, start times and crystal errors, and a medium that drops
+ * SIM_LOSS_PER_MILLE of the packets. Each node has its own radio and timer
+ * models, which m_node_enter switches the stand-ins (and m_p_radio_ctx, the
+ * owner of nrf_esb) to before the node's events are handled. It checks that
+ * every link binds, that no packet is sent outside the receiver's window and
+ * that every packet is delivered to the link's own callback, in order, or
+ * reported as dropped.
+ *
+ * With --bench it times that CC0 branch against the one that copied the data
+ * into m_sent_data and m_tx_payload before sending it, which is reproduced
+ * here. nrf_esb_write_payload copies the payload into a FIFO for both, as the
+ * SDK does. With --rx-bench it times the delivery of an auxiliary payload
+ * from the nrf_esb event to the end of a callback that reads the whole
+ * payload, and to the end of one that only reads its type. The Makefile's
+ * bench target builds it for payloads of 32 to 252 bytes
+ * (RC_RADIO_AUX_DATA_LEN) with deferred events, with and without
+ * RC_RADIO_ZERO_COPY_RX, so the copy into the event queue can be compared
+ * with handing the pool buffer on. --bench also prints how the simulation's
+ * host time grows with the number of links.
+ */
+#include "string.h"
+#include "math.h"
+
+#include "host_check.h"
+#include "rc_radio.c"
+
+
+#define BENCH_ITERATIONS   (10000000UL)
+#define AUX_TYPE           (0xA5)
+#define SIM_LINKS          (200U)
+#define SIM_DURATION_MS    (2000U)
+#define SIM_BENCH_MS       (1000U)
+#define SIM_LOSS_PER_MILLE (50U)
+
+#if RC_RADIO_ZERO_COPY_RX
+#define CHECK_NAME         "rc_radio_check (zero copy)"
+#else
+#define CHECK_NAME         "rc_radio_check"
+#endif
+
+
+typedef struct
+{
+    nrf_esb_event_handler_t handler;
+    nrf_esb_mode_t          mode;
+    bool                    rx_on;
+    uint64_t                rx_on_ns;  // When the receiver was started
+    uint32_t                channel;
+    uint8_t                 addr[ADDR_LEN];
+    nrf_esb_payload_t       rx;        // The packet that read_rx_payload gives
+    bool                    rx_valid;
+    nrf_esb_payload_t       tx;        // The FIFO that write_payload fills
+    const void *            p_written;
+    uint32_t                written;
+    uint64_t                tx_start_ns;
+    uint64_t                tx_end_ns;
+    uint32_t                tx_channel;
+    uint8_t                 tx_addr[ADDR_LEN];
+    nrf_esb_payload_t       ack;       // The receiver's ACK payload
+    bool                    ack_valid;
+} esb_t;
+
+typedef struct
+{
+    nrf_timer_event_handler_t handler;
+    void *                    p_context;
+    bool                      enabled;
+    uint64_t                  base_ns;   // When the counter was 0, if enabled
+    uint32_t                  count;     // The counter, if disabled
+    uint32_t                  cc[4];
+    uint32_t                  int_mask;
+    uint32_t                  short_mask;
+    uint32_t                  due_mask;  // The channels that match next
+    uint32_t                  version;   // Of the scheduled match
+} timer_model_t;
+
+struct link_s;
+
+// A chip with its own radio and timer. The stand-ins act on m_p_node.
+typedef struct
+{
+    rc_radio_ctx_t  ctx;
+    esb_t           esb;
+    timer_model_t   timer;
+    double          rate;      // Of its crystal against the simulation's time
+    bool            simulated;
+    struct link_s * p_link;
+} node_t;
+
+typedef struct
+{
+    uint32_t     events[RC_RADIO_EVENT_CALLBACK_OVERRUN + 1];
+    const void * p_last;
+    uint32_t     sum;
+    bool         retain;
+    bool         type_only; // The callback only reads the type
+} rx_log_t;
+
+
+HOST_CHECK_DEFINE();
+
+NRF_TIMER_Type host_timer;
+NRF_CLOCK_Type host_clock;
+
+// The stand-ins copy through libc as nrf_esb does through its memcpy. Copies
+// that the compiler inlines for a known length would only happen on one side
+// of the CC0 comparison.
+static void * (* volatile m_memcpy)(void *, const void *, size_t) = memcpy;
+
+static node_t         m_node;
+static node_t *       m_p_node = &m_node;
+static uint64_t       m_now_ns;
+static bool           m_irq_pending;
+static rc_radio_ctx_t m_rx_ctx;
+static rx_log_t       m_rx_log;
+static rc_radio_ctx_t m_tx_ctx;
+
+// The CC0 branch before the payloads were staged.
+static rc_radio_data_t   m_ref_tx_data[RC_RADIO_DATA_BUFF_COUNT];
+static uint8_t           m_ref_tx_data_index;
+static rc_radio_data_t   m_ref_sent_data;
+static nrf_esb_payload_t m_ref_tx_payload;
+
+
+static void m_timer_schedule(node_t * p_node);
+static void m_radio_schedule(node_t * p_node);
+
+
+void app_error_handler_bare(uint32_t error_code)
+{
+    CHECK(false, "APP_ERROR_CHECK(0x%x)", error_code);
+}
+
+
+void NVIC_SetPendingIRQ(IRQn_Type irqn)
+{
+    m_irq_pending = true;
+}
+
+
+void NVIC_ClearPendingIRQ(IRQn_Type irqn)
+{
+    m_irq_pending = false;
+}
+
+
+void NVIC_SetPriority(IRQn_Type irqn, uint32_t priority)
+{
+}
+
+
+void NVIC_EnableIRQ(IRQn_Type irqn)
+{
+}
+
+
+uint32_t nrf_esb_init(nrf_esb_config_t const * p_config)
+{
+    esb_t * p_esb = &m_p_node->esb;
+
+    memset(p_esb, 0, sizeof(*p_esb));
+
+    p_esb->handler = p_config->event_handler;
+    p_esb->mode    = p_config->mode;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_esb_disable(void)
+{
+    m_p_node->esb.rx_on = false;
+
+    return NRF_SUCCESS;
+}
+
+
+// A receiver's payload goes out with the next ACK. A transmitter's goes out
+// right away.
+uint32_t nrf_esb_write_payload(nrf_esb_payload_t const * p_payload)
+{
+    esb_t *             p_esb  = &m_p_node->esb;
+    nrf_esb_payload_t * p_fifo = &p_esb->tx;
+
+    if (NRF_ESB_MODE_PRX == p_esb->mode)
+    {
+        p_fifo         = &p_esb->ack;
+        p_esb->ack_valid = true;
+    }
+    else if (m_p_node->simulated && (m_now_ns < p_esb->tx_end_ns))
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    // nrf_esb copies the payload into its FIFO.
+    p_fifo->length = p_payload->length;
+    p_fifo->pipe   = p_payload->pipe;
+    p_fifo->noack  = p_payload->noack;
+    m_memcpy(p_fifo->data, p_payload->data, p_payload->length);
+
+    p_esb->p_written = p_payload;
+    p_esb->written++;
+
+    if (NRF_ESB_MODE_PTX == p_esb->mode)
+    {
+        p_esb->tx_start_ns = m_now_ns;
+        p_esb->tx_end_ns   = (m_now_ns + (AIR_US(p_payload->length) * 1000ULL));
+        p_esb->tx_channel  = p_esb->channel;
+        memcpy(p_esb->tx_addr, p_esb->addr, ADDR_LEN);
+
+        m_radio_schedule(m_p_node);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_esb_read_rx_payload(nrf_esb_payload_t * p_payload)
+{
+    esb_t * p_esb = &m_p_node->esb;
+
+    if (!p_esb->rx_valid)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    // nrf_esb copies the packet out of its FIFO the same way.
+    p_payload->length = p_esb->rx.length;
+    p_payload->pipe   = p_esb->rx.pipe;
+    p_payload->rssi   = p_esb->rx.rssi;
+    m_memcpy(p_payload->data, p_esb->rx.data, p_esb->rx.length);
+
+    p_esb->rx_valid = false;
+
+    return NRF_SUCCESS;
+}
+
+
+// nrf_esb returns an error if the receiver is already started, or stopped,
+// and rc_radio.c checks for it.
+uint32_t nrf_esb_start_rx(void)
+{
+    esb_t * p_esb = &m_p_node->esb;
+
+    if (p_esb->rx_on)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    p_esb->rx_on    = true;
+    p_esb->rx_on_ns = m_now_ns;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_esb_stop_rx(void)
+{
+    esb_t * p_esb = &m_p_node->esb;
+
+    if (!p_esb->rx_on)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    p_esb->rx_on = false;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_esb_flush_tx(void)
+{
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_esb_set_rf_channel(uint32_t channel)
+{
+    m_p_node->esb.channel = channel;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_esb_set_base_address_0(uint8_t const * p_addr)
+{
+    memcpy(m_p_node->esb.addr, p_addr, (ADDR_LEN - 1));
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_esb_set_prefixes(uint8_t const * p_prefixes, uint8_t num_pipes)
+{
+    m_p_node->esb.addr[ADDR_LEN - 1] = p_prefixes[0];
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_esb_set_tx_power(uint8_t tx_output_power)
+{
+    return NRF_SUCCESS;
+}
+
+
+static uint32_t m_timer_count(const node_t * p_node)
+{
+    const timer_model_t * p_timer = &p_node->timer;
+
+    if (!p_timer->enabled)
+    {
+        return p_timer->count;
+    }
+
+    return (uint32_t)(((double)(m_now_ns - p_timer->base_ns) * p_node->rate) /
+                      1000.0);
+}
+
+
+uint32_t nrf_drv_timer_init(nrf_drv_timer_t const * const p_instance,
+                                nrf_drv_timer_config_t const * p_config,
+                                nrf_timer_event_handler_t timer_event_handler)
+{
+    timer_model_t * p_timer = &m_p_node->timer;
+
+    memset(p_timer, 0, sizeof(*p_timer));
+
+    p_timer->handler   = timer_event_handler;
+    p_timer->p_context = p_config->p_context;
+
+    return NRF_SUCCESS;
+}
+
+
+void nrf_drv_timer_enable(nrf_drv_timer_t const * const p_instance)
+{
+    timer_model_t * p_timer = &m_p_node->timer;
+
+    if (!p_timer->enabled)
+    {
+        p_timer->base_ns = (m_now_ns -
+                            (uint64_t)((p_timer->count * 1000.0) / m_p_node->rate));
+        p_timer->enabled = true;
+    }
+
+    m_timer_schedule(m_p_node);
+}
+
+
+void nrf_drv_timer_disable(nrf_drv_timer_t const * const p_instance)
+{
+    timer_model_t * p_timer = &m_p_node->timer;
+
+    p_timer->count   = m_timer_count(m_p_node);
+    p_timer->enabled = false;
+
+    m_timer_schedule(m_p_node);
+}
+
+
+void nrf_drv_timer_clear(nrf_drv_timer_t const * const p_instance)
+{
+    timer_model_t * p_timer = &m_p_node->timer;
+
+    p_timer->base_ns = m_now_ns;
+    p_timer->count   = 0;
+
+    m_timer_schedule(m_p_node);
+}
+
+
+void nrf_drv_timer_compare(nrf_drv_timer_t const * const p_instance,
+                               nrf_timer_cc_channel_t cc_channel,
+                               uint32_t cc_value,
+                               bool enable_int)
+{
+    timer_model_t * p_timer = &m_p_node->timer;
+
+    p_timer->cc[cc_channel] = cc_value;
+    p_timer->int_mask       = (enable_int ?
+                               (p_timer->int_mask | (1UL << cc_channel)) :
+                               (p_timer->int_mask & ~(1UL << cc_channel)));
+
+    m_timer_schedule(m_p_node);
+}
+
+
+void nrf_drv_timer_extended_compare(nrf_drv_timer_t const * const p_instance,
+                                        nrf_timer_cc_channel_t cc_channel,
+                                        uint32_t cc_value,
+                                        nrf_timer_short_mask_t timer_short_mask,
+                                        bool enable_int)
+{
+    m_p_node->timer.short_mask |= timer_short_mask;
+
+    nrf_drv_timer_compare(p_instance, cc_channel, cc_value, enable_int);
+}
+
+
+uint32_t nrf_drv_timer_capture_get(nrf_drv_timer_t const * const p_instance,
+                                       nrf_timer_cc_channel_t cc_channel)
+{
+    return m_p_node->timer.cc[cc_channel];
+}
+
+
+void nrf_timer_cc_write(NRF_TIMER_Type * p_reg,
+                            nrf_timer_cc_channel_t cc_channel,
+                            uint32_t cc_value)
+{
+    m_p_node->timer.cc[cc_channel] = cc_value;
+
+    m_timer_schedule(m_p_node);
+}
+
+
+void nrf_timer_event_clear(NRF_TIMER_Type * p_reg, nrf_timer_event_t event)
+{
+}
+
+
+// Runs the deferred events the way the interrupt would.
+static void m_irq_run(void)
+{
+#if RC_RADIO_DEFERRED_EVENTS
+    while (m_irq_pending)
+    {
+        m_irq_pending = false;
+        RC_RADIO_EVENT_IRQHandler();
+    }
+#endif
+}
+
+
+// Gives rc_radio.c a packet as if it had just been received.
+static void m_packet_receive(const void * p_data, uint8_t length)
+{
+    nrf_esb_evt_t event = {.evt_id = NRF_ESB_EVENT_RX_RECEIVED};
+
+    // Packets only arrive while the radio listens.
+    m_node.esb.rx_on     = true;
+    m_node.esb.rx.length = length;
+    memcpy(m_node.esb.rx.data, p_data, length);
+    m_node.esb.rx_valid  = true;
+
+    m_node.esb.handler(&event);
+
+    m_irq_run();
+}
+
+
+static void m_rx_callback(rc_radio_event_t event, const void * p_context)
+{
+    const rc_radio_aux_data_t * p_aux = p_context;
+    uint32_t                    sum   = 0;
+    uint32_t                    i;
+
+    m_rx_log.events[event]++;
+    m_rx_log.p_last = p_context;
+
+    if ((RC_RADIO_EVENT_AUX_RECEIVED == event) && m_rx_log.type_only)
+    {
+        m_rx_log.sum = p_aux->type;
+    }
+    else if (RC_RADIO_EVENT_AUX_RECEIVED == event)
+    {
+        // Reads all of it as an application that uses the payload would.
+        for (i = 0; i < RC_RADIO_AUX_DATA_LEN; i++)
+        {
+            sum += p_aux->data[i];
+        }
+
+        m_rx_log.sum = sum;
+
+        if (m_rx_log.retain)
+        {
+            CHECK(NRF_SUCCESS == rc_radio_rx_retain(p_context), "retain");
+        }
+    }
+}
+
+
+static void m_aux_fill(rc_radio_aux_data_t * p_aux, uint32_t seed)
+{
+    uint32_t i;
+
+    p_aux->type = AUX_TYPE;
+
+    for (i = 0; i < RC_RADIO_AUX_DATA_LEN; i++)
+    {
+        p_aux->data[i] = (uint8_t)(seed + i);
+    }
+}
+
+
+static uint32_t m_aux_sum(const rc_radio_aux_data_t * p_aux)
+{
+    uint32_t sum = 0;
+    uint32_t i;
+
+    for (i = 0; i < RC_RADIO_AUX_DATA_LEN; i++)
+    {
+        sum += p_aux->data[i];
+    }
+
+    return sum;
+}
+
+
+// Initializes, enables and binds the receiver.
+static void m_receiver_bind(void)
+{
+    rc_radio_bind_info_t bind_info;
+
+    memset(&m_rx_ctx, 0, sizeof(m_rx_ctx));
+    memset(&m_rx_log, 0, sizeof(m_rx_log));
+    m_p_radio_ctx = NULL;
+
+    CHECK(NRF_SUCCESS == rc_radio_ctx_receiver_init(&m_rx_ctx, 1, m_rx_callback),
+          "receiver_init");
+    CHECK(NRF_SUCCESS == rc_radio_ctx_enable(&m_rx_ctx), "enable");
+    m_irq_run();
+    CHECK(1 == m_rx_log.events[RC_RADIO_EVENT_BINDING], "BINDING");
+    CHECK(m_node.esb.rx_on && (BIND_CHANNEL == m_node.esb.channel),
+          "listening to bind");
+
+    memset(&bind_info, 0, sizeof(bind_info));
+    bind_info.transmitter_channel = RC_RADIO_TRANSMITTER_CHANNEL_C;
+    bind_info.transmit_rate_hz    = 250;
+    bind_info.keepalive_interval  = RC_RADIO_KEEPALIVE_INTERVAL;
+
+    m_packet_receive(&bind_info, sizeof(bind_info));
+
+    CHECK(1 == m_rx_log.events[RC_RADIO_EVENT_BOUND], "BOUND");
+    CHECK(RC_RADIO_STATE_STARTED == m_rx_ctx.state, "started");
+    CHECK(RC_RADIO_TRANSMITTER_CHANNEL_C == m_rx_ctx.bind_info.transmitter_channel,
+          "bound to the transmitter's channel");
+}
+
+
+static void m_receive_check(void)
+{
+    rc_radio_data_t     data;
+    rc_radio_aux_data_t aux;
+    uint8_t             garbage[3] = {1, 2, 3};
+    uint32_t            i;
+
+    m_receiver_bind();
+
+    memset(&data, 0, sizeof(data));
+    data.throttle = 200;
+    data.switches = 0x05;
+    m_packet_receive(&data, sizeof(data));
+
+    CHECK(1 == m_rx_log.events[RC_RADIO_EVENT_DATA_RECEIVED], "DATA_RECEIVED");
+    CHECK(0 == memcmp(m_rx_log.p_last, &data, sizeof(data)), "data intact");
+
+    for (i = 0; i < 100; i++)
+    {
+        m_aux_fill(&aux, i);
+        m_packet_receive(&aux, sizeof(aux));
+
+        CHECK(m_aux_sum(&aux) == m_rx_log.sum, "aux %u intact", i);
+        CHECK(AUX_TYPE == ((const rc_radio_aux_data_t*)m_rx_log.p_last)->type,
+              "aux %u type", i);
+    }
+
+    CHECK(100 == m_rx_log.events[RC_RADIO_EVENT_AUX_RECEIVED], "AUX_RECEIVED");
+
+    // A payload that is neither is ignored.
+    m_packet_receive(garbage, sizeof(garbage));
+    CHECK(101 == (m_rx_log.events[RC_RADIO_EVENT_DATA_RECEIVED] +
+                  m_rx_log.events[RC_RADIO_EVENT_AUX_RECEIVED]),
+          "unknown length ignored");
+
+#if RC_RADIO_ZERO_COPY_RX
+    CHECK(((1UL << RC_RADIO_RX_POOL_LEN) - 1) == m_rx_pool_free,
+          "every buffer back in the pool");
+#endif
+}
+
+
+#if RC_RADIO_ZERO_COPY_RX
+static void m_pool_check(void)
+{
+    rc_radio_aux_data_t aux;
+    const void *        retained[RC_RADIO_RX_POOL_LEN];
+    uint32_t            i;
+
+    m_receiver_bind();
+
+    // Every buffer that the callback retains stays out of the pool.
+    m_rx_log.retain = true;
+
+    for (i = 0; i < RC_RADIO_RX_POOL_LEN; i++)
+    {
+        m_aux_fill(&aux, i);
+        m_packet_receive(&aux, sizeof(aux));
+
+        retained[i] = m_rx_log.p_last;
+        CHECK(RC_RADIO_RX_POOL_LEN > m_rx_buffer_index(retained[i]),
+              "buffer %u pooled", i);
+    }
+
+    CHECK(0 == m_rx_pool_free, "pool empty");
+
+    // The next packet only keeps the timer in sync.
+    m_aux_fill(&aux, 99);
+    m_packet_receive(&aux, sizeof(aux));
+    CHECK(RC_RADIO_RX_POOL_LEN == m_rx_log.events[RC_RADIO_EVENT_AUX_RECEIVED],
+          "no aux while the pool is empty");
+    CHECK(1 == m_rx_log.events[RC_RADIO_EVENT_PACKET_DROPPED], "reported dropped");
+
+    // The retained payloads weren't overwritten.
+    for (i = 0; i < RC_RADIO_RX_POOL_LEN; i++)
+    {
+        m_aux_fill(&aux, i);
+        CHECK(0 == memcmp(retained[i], &aux, sizeof(aux)), "buffer %u kept", i);
+    }
+
+    CHECK(NRF_ERROR_INVALID_PARAM == rc_radio_rx_release(&aux), "not pooled");
+
+    m_rx_log.retain = false;
+
+    for (i = 0; i < RC_RADIO_RX_POOL_LEN; i++)
+    {
+        CHECK(NRF_SUCCESS == rc_radio_rx_release(retained[i]), "release %u", i);
+    }
+
+    CHECK(NRF_ERROR_INVALID_STATE == rc_radio_rx_release(retained[0]),
+          "released twice");
+
+    m_aux_fill(&aux, 7);
+    m_packet_receive(&aux, sizeof(aux));
+    CHECK((RC_RADIO_RX_POOL_LEN + 1) == m_rx_log.events[RC_RADIO_EVENT_AUX_RECEIVED],
+          "delivered after the release");
+    CHECK(m_aux_sum(&aux) == m_rx_log.sum, "intact after the release");
+}
+#endif
+
+
+// Initializes the transmitter and binds it with its first data.
+static void m_transmitter_bind(const rc_radio_data_t * p_data)
+{
+    memset(&m_tx_ctx, 0, sizeof(m_tx_ctx));
+    m_p_radio_ctx = NULL;
+
+    CHECK(NRF_SUCCESS == rc_radio_ctx_transmitter_init(&m_tx_ctx, 2, 250,
+                                                           RC_RADIO_TRANSMITTER_CHANNEL_C,
+                                                           NULL),
+          "transmitter_init");
+    CHECK(NRF_SUCCESS == rc_radio_ctx_enable(&m_tx_ctx), "enable");
+    CHECK(NRF_SUCCESS == rc_radio_ctx_data_set(&m_tx_ctx, p_data), "data_set");
+    CHECK(RC_RADIO_STATE_BINDING == m_tx_ctx.state, "binding");
+    CHECK(sizeof(rc_radio_bind_info_t) == m_node.esb.tx.length, "bind info sent");
+
+    // The receiver's ACK.
+    m_packet_receive(BINDING_ACK_PAYLOAD, sizeof(BINDING_ACK_PAYLOAD));
+    CHECK(RC_RADIO_STATE_STARTED == m_tx_ctx.state, "started");
+}
+
+
+static void m_transmit_check(void)
+{
+    rc_radio_data_t data[3];
+    const void *    p_sent;
+    uint32_t        i;
+
+    memset(data, 0, sizeof(data));
+
+    for (i = 0; i < 3; i++)
+    {
+        data[i].throttle = (uint8_t)(40 * (i + 1));
+        data[i].switches = (uint8_t)i;
+    }
+
+    m_transmitter_bind(&data[0]);
+
+    m_timer_handler(NRF_TIMER_EVENT_COMPARE0, &m_tx_ctx);
+
+    CHECK(&m_tx_ctx.tx_data_pl[m_tx_ctx.tx_sent_index] == m_node.esb.p_written,
+          "the staged buffer is sent");
+    CHECK((sizeof(rc_radio_data_t) == m_node.esb.tx.length) &&
+          m_node.esb.tx.noack,
+          "length and noack set at init");
+    CHECK(0 == memcmp(m_node.esb.tx.data, &data[0], sizeof(data[0])),
+          "data 0 sent");
+    CHECK(!m_tx_ctx.tx_pending, "nothing pending");
+
+    // Staging twice before the next interval doesn't touch the buffer that
+    // was sent last, which the change detection compares against.
+    p_sent = m_node.esb.p_written;
+
+    CHECK(NRF_SUCCESS == rc_radio_ctx_data_set(&m_tx_ctx, &data[1]), "data_set 1");
+    CHECK(NRF_SUCCESS == rc_radio_ctx_data_set(&m_tx_ctx, &data[2]), "data_set 2");
+    CHECK(0 == memcmp(((const nrf_esb_payload_t*)p_sent)->data, &data[0],
+                      sizeof(data[0])), "last sent kept");
+
+    m_timer_handler(NRF_TIMER_EVENT_COMPARE0, &m_tx_ctx);
+    CHECK(0 == memcmp(m_node.esb.tx.data, &data[2], sizeof(data[2])),
+          "latest sent");
+    CHECK(p_sent != m_node.esb.p_written, "another buffer sent");
+}
+
+
+// The timer handler's CC0 branch as it was before the payloads were staged,
+// less the probes.
+static void m_ref_timer_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    rc_radio_ctx_t * p_ctx = (rc_radio_ctx_t*)p_context;
+
+    if ((NRF_TIMER_EVENT_COMPARE0 != event_type) ||
+            (NRF_ESB_MODE_PTX != p_ctx->mode) ||
+            (RC_RADIO_STATE_BINDING == p_ctx->state))
+    {
+        return;
+    }
+
+    if (m_tx_interval_idle(p_ctx))
+    {
+        m_channel_increment(p_ctx);
+        nrf_esb_set_rf_channel(m_channel_lookup(p_ctx));
+    }
+    else if ((RC_RADIO_AUX_BUFF_COUNT > p_ctx->aux_data_index) &&
+                 (0 == --p_ctx->aux_countdown))
+    {
+        // The auxiliary payloads aren't set in the bench.
+    }
+    else
+    {
+        p_ctx->tx_pending          = false;
+        p_ctx->keepalive_countdown = p_ctx->bind_info.keepalive_interval;
+        memcpy((uint8_t*)&m_ref_sent_data,
+                   (uint8_t*)&m_ref_tx_data[m_ref_tx_data_index],
+                   sizeof(rc_radio_data_t));
+
+        m_ref_tx_payload.length = sizeof(rc_radio_data_t);
+        m_ref_tx_payload.noack  = true;
+        memcpy(&m_ref_tx_payload.data[0],
+                   (uint8_t*)&m_ref_sent_data,
+                   sizeof(rc_radio_data_t));
+        APP_ERROR_CHECK(nrf_esb_write_payload(&m_ref_tx_payload));
+    }
+}
+
+
+// Both handlers are called through a pointer as the timer driver does.
+static void m_bench(void)
+{
+    nrf_timer_event_handler_t volatile handler;
+    rc_radio_data_t                    data;
+    uint64_t                           start;
+    uint64_t                           staged_ns;
+    uint64_t                           ref_ns;
+    uint32_t                           i;
+
+    memset(&data, 0, sizeof(data));
+    m_transmitter_bind(&data);
+
+    handler = m_timer_handler;
+    start   = host_check_ns();
+
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        m_tx_ctx.tx_pending    = true;
+        m_tx_ctx.tx_data_index = (uint8_t)(i % RC_RADIO_DATA_BUFF_COUNT);
+        handler(NRF_TIMER_EVENT_COMPARE0, &m_tx_ctx);
+    }
+
+    staged_ns = (host_check_ns() - start);
+
+    handler = m_ref_timer_handler;
+    start   = host_check_ns();
+
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        m_tx_ctx.tx_pending = true;
+        m_ref_tx_data_index = (uint8_t)(i % RC_RADIO_DATA_BUFF_COUNT);
+        handler(NRF_TIMER_EVENT_COMPARE0, &m_tx_ctx);
+    }
+
+    ref_ns = (host_check_ns() - start);
+
+    printf("%s: CC0 branch with a %u B payload\n",
+           CHECK_NAME, (unsigned)sizeof(rc_radio_data_t));
+    printf("  %-28s %6.1f ns\n", "staged buffer",
+           ((double)staged_ns / BENCH_ITERATIONS));
+    printf("  %-28s %6.1f ns\n", "copied (replaced)",
+           ((double)ref_ns / BENCH_ITERATIONS));
+}
+
+
+static double m_rx_bench_run(bool type_only)
+{
+    nrf_esb_evt_t       event = {.evt_id = NRF_ESB_EVENT_RX_RECEIVED};
+    rc_radio_aux_data_t aux;
+    uint64_t            start;
+    uint32_t            i;
+
+    m_receiver_bind();
+    m_aux_fill(&aux, 3);
+    m_rx_log.type_only = type_only;
+
+    // The same packet is read out of the FIFO every time.
+    m_node.esb.rx.length = sizeof(aux);
+    memcpy(m_node.esb.rx.data, &aux, sizeof(aux));
+
+    start = host_check_ns();
+
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        m_node.esb.rx_on    = true;
+        m_node.esb.rx_valid = true;
+        m_node.esb.handler(&event);
+        m_irq_run();
+        HOST_CHECK_KEEP(m_rx_log.sum);
+    }
+
+    CHECK(BENCH_ITERATIONS == m_rx_log.events[RC_RADIO_EVENT_AUX_RECEIVED],
+          "every aux delivered");
+
+    return ((double)(host_check_ns() - start) / BENCH_ITERATIONS);
+}
+
+
+// One line per build for the Makefile's bench target. The callback either
+// reads the whole payload or only its type, as one that passes the payload
+// on would.
+static void m_rx_bench(void)
+{
+    double read_ns = m_rx_bench_run(false);
+    double type_ns = m_rx_bench_run(true);
+
+    printf("  %3u B  %-10s %6.1f ns %6.1f ns\n",
+           (unsigned)sizeof(rc_radio_aux_data_t),
+           (RC_RADIO_ZERO_COPY_RX ? "zero copy" : "copy"),
+           read_ns,
+           type_ns);
+}
+
+
+typedef enum
+{
+    SIM_TIMER,       // A compare of the node's timer matches
+    SIM_RADIO_END,   // The node's packet has been sent
+    SIM_DATA_UPDATE  // The link's transmitter application stages new data
+} sim_kind_t;
+
+typedef struct
+{
+    uint64_t   t_ns;
+    uint64_t   seq;      // Keeps events at the same time in order
+    node_t *   p_node;
+    uint32_t   version;  // Of the node's timer for SIM_TIMER
+    sim_kind_t kind;
+} sim_event_t;
+
+typedef struct link_s
+{
+    node_t   tx;
+    node_t   rx;
+    uint32_t index;
+    uint16_t seq;          // Of the last data staged
+    uint16_t rx_seq;       // Of the last data received
+    bool     tx_bound;
+    bool     rx_bound;
+    uint32_t sent;         // Data packets sent once both ends were bound
+    uint32_t delivered;    // Of those, received by the medium
+    uint32_t lost;         // Dropped by the medium
+    uint32_t missed;       // Sent while the receiver wasn't listening for it
+    uint32_t received;     // DATA_RECEIVED events
+    uint32_t dropped;      // PACKET_DROPPED events after binding
+    uint32_t wrong;        // Data that wasn't this link's or came out of order
+} link_t;
+
+typedef struct
+{
+    uint32_t links;
+    uint64_t packets;
+    uint64_t events;
+} sim_stats_t;
+
+
+static sim_event_t * m_events;
+static uint32_t      m_event_count;
+static uint32_t      m_event_size;
+static uint64_t      m_event_seq;
+static uint32_t      m_sim_rand_state;
+static uint32_t      m_sim_loss_per_mille;
+
+
+static uint32_t m_sim_rand(void)
+{
+    // xorshift32
+    m_sim_rand_state ^= (m_sim_rand_state << 13);
+    m_sim_rand_state ^= (m_sim_rand_state >> 17);
+    m_sim_rand_state ^= (m_sim_rand_state << 5);
+
+    return m_sim_rand_state;
+}
+
+
+static bool m_sim_before(const sim_event_t * p_a, const sim_event_t * p_b)
+{
+    return ((p_a->t_ns < p_b->t_ns) ||
+            ((p_a->t_ns == p_b->t_ns) && (p_a->seq < p_b->seq)));
+}
+
+
+// The events are kept in a binary heap. Rescheduling a timer leaves the old
+// event in the heap and it is skipped by its version.
+static void m_sim_push(uint64_t t_ns, node_t * p_node, sim_kind_t kind)
+{
+    sim_event_t event;
+    uint32_t    i;
+
+    if (m_event_count == m_event_size)
+    {
+        m_event_size = ((0 == m_event_size) ? 1024 : (2 * m_event_size));
+        m_events     = realloc(m_events, (m_event_size * sizeof(sim_event_t)));
+
+        if (NULL == m_events)
+        {
+            abort();
+        }
+    }
+
+    event.t_ns    = t_ns;
+    event.seq     = m_event_seq++;
+    event.p_node  = p_node;
+    event.version = p_node->timer.version;
+    event.kind    = kind;
+
+    for (i = m_event_count++; 0 < i; i = ((i - 1) / 2))
+    {
+        if (!m_sim_before(&event, &m_events[(i - 1) / 2]))
+        {
+            break;
+        }
+
+        m_events[i] = m_events[(i - 1) / 2];
+    }
+
+    m_events[i] = event;
+}
+
+
+static sim_event_t m_sim_pop(void)
+{
+    sim_event_t first = m_events[0];
+    sim_event_t last  = m_events[--m_event_count];
+    uint32_t    i     = 0;
+    uint32_t    child;
+
+    while ((child = ((2 * i) + 1)) < m_event_count)
+    {
+        if (((child + 1) < m_event_count) &&
+                m_sim_before(&m_events[child + 1], &m_events[child]))
+        {
+            child++;
+        }
+
+        if (!m_sim_before(&m_events[child], &last))
+        {
+            break;
+        }
+
+        m_events[i] = m_events[child];
+        i           = child;
+    }
+
+    m_events[i] = last;
+
+    return first;
+}
+
+
+// Schedules the next match of the node's timer. The channels that have an
+// interrupt or a short match when the counter reaches them.
+static void m_timer_schedule(node_t * p_node)
+{
+    timer_model_t * p_timer = &p_node->timer;
+    uint32_t        count;
+    uint32_t        next    = UINT32_MAX;
+    uint32_t        mask    = 0;
+    uint32_t        ch;
+
+    p_timer->version++;
+
+    if (!p_node->simulated || !p_timer->enabled)
+    {
+        return;
+    }
+
+    count = m_timer_count(p_node);
+
+    for (ch = 0; ch < 4; ch++)
+    {
+        if ((0 == ((p_timer->int_mask | p_timer->short_mask) & (1UL << ch))) ||
+                (p_timer->cc[ch] <= count))
+        {
+            continue;
+        }
+
+        if (p_timer->cc[ch] < next)
+        {
+            next = p_timer->cc[ch];
+            mask = 0;
+        }
+
+        if (p_timer->cc[ch] == next)
+        {
+            mask |= (1UL << ch);
+        }
+    }
+
+    if (0 != mask)
+    {
+        p_timer->due_mask = mask;
+        m_sim_push((p_timer->base_ns + (uint64_t)ceil((next * 1000.0) / p_node->rate)),
+                   p_node,
+                   SIM_TIMER);
+    }
+}
+
+
+static void m_radio_schedule(node_t * p_node)
+{
+    if (p_node->simulated)
+    {
+        m_sim_push(p_node->esb.tx_end_ns, p_node, SIM_RADIO_END);
+    }
+}
+
+
+// Makes the node the one that the stand-ins and rc_radio.c act on.
+static void m_node_enter(node_t * p_node)
+{
+    m_p_node      = p_node;
+    m_p_radio_ctx = &p_node->ctx;
+}
+
+
+static void m_esb_event(node_t * p_node, nrf_esb_evt_id_t evt_id)
+{
+    nrf_esb_evt_t event = {.evt_id = evt_id};
+
+    m_node_enter(p_node);
+    p_node->esb.handler(&event);
+    m_irq_run();
+}
+
+
+static void m_timer_fire(node_t * p_node)
+{
+    timer_model_t * p_timer = &p_node->timer;
+    uint32_t        mask    = p_timer->due_mask;
+    uint32_t        ch;
+
+    m_node_enter(p_node);
+
+    if (0 != (mask & p_timer->short_mask))
+    {
+        p_timer->base_ns = m_now_ns;
+    }
+
+    // The handler can change the compares, so the next match is scheduled
+    // in any case.
+    m_timer_schedule(p_node);
+
+    for (ch = 0; ch < 4; ch++)
+    {
+        if (0 != (mask & p_timer->int_mask & (1UL << ch)))
+        {
+            p_timer->handler((nrf_timer_event_t)ch, p_timer->p_context);
+            m_irq_run();
+        }
+    }
+}
+
+
+// The transmitter's packet has been sent. The receiver gets it if it has
+// been listening on that channel and address since the packet started, and
+// the medium didn't drop it.
+static void m_radio_end(node_t * p_tx)
+{
+    link_t *          p_link = p_tx->p_link;
+    node_t *          p_rx   = &p_link->rx;
+    nrf_esb_payload_t ack    = p_rx->esb.ack;
+    bool              ack_valid;
+    bool              heard;
+    bool              delivered;
+    bool              data;
+
+    ack_valid = p_rx->esb.ack_valid;
+    heard     = (p_rx->esb.rx_on &&
+                 (p_rx->esb.rx_on_ns <= p_tx->esb.tx_start_ns) &&
+                 (p_rx->esb.channel == p_tx->esb.tx_channel) &&
+                 (0 == memcmp(p_rx->esb.addr, p_tx->esb.tx_addr, ADDR_LEN)));
+    delivered = (heard && (m_sim_loss_per_mille <= (m_sim_rand() % 1000)));
+    data      = (p_link->tx_bound && p_link->rx_bound && p_tx->esb.tx.noack);
+
+    if (data)
+    {
+        p_link->sent++;
+        p_link->delivered += delivered;
+        p_link->lost      += (heard && !delivered);
+        p_link->missed    += !heard;
+    }
+
+    if (delivered)
+    {
+        p_rx->esb.rx       = p_tx->esb.tx;
+        p_rx->esb.rx_valid = true;
+        m_esb_event(p_rx, NRF_ESB_EVENT_RX_RECEIVED);
+    }
+
+    if (p_tx->esb.tx.noack)
+    {
+        m_esb_event(p_tx, NRF_ESB_EVENT_TX_SUCCESS);
+    }
+    else if (delivered)
+    {
+        m_esb_event(p_tx, NRF_ESB_EVENT_TX_SUCCESS);
+
+        if (ack_valid)
+        {
+            p_rx->esb.ack_valid = false;
+            p_tx->esb.rx        = ack;
+            p_tx->esb.rx_valid  = true;
+            m_esb_event(p_tx, NRF_ESB_EVENT_RX_RECEIVED);
+        }
+    }
+    else
+    {
+        m_esb_event(p_tx, NRF_ESB_EVENT_TX_FAILED);
+    }
+}
+
+
+// Sets the link's next data: the link's index in the throttle and the
+// sequence number in the pitch and roll.
+static void m_data_update(link_t * p_link)
+{
+    rc_radio_data_t data;
+
+    memset(&data, 0, sizeof(data));
+
+    p_link->seq++;
+
+    data.throttle = (uint8_t)p_link->index;
+    data.pitch    = (int8_t)(p_link->seq & 0xFF);
+    data.roll     = (int8_t)(p_link->seq >> 8);
+
+    m_node_enter(&p_link->tx);
+    CHECK(NRF_SUCCESS == rc_radio_ctx_data_set(&p_link->tx.ctx, &data),
+          "link %u data_set", p_link->index);
+    m_irq_run();
+
+    // The application updates the data every 1 to 10 ms.
+    m_sim_push((m_now_ns + (1000000ULL + ((m_sim_rand() % 9000) * 1000ULL))),
+               &p_link->tx,
+               SIM_DATA_UPDATE);
+}
+
+
+static void m_node_callback(rc_radio_event_t event, const void * p_context)
+{
+    link_t *                p_link = m_p_node->p_link;
+    const rc_radio_data_t * p_data = p_context;
+    uint16_t                seq;
+
+    switch (event)
+    {
+    case RC_RADIO_EVENT_BOUND:
+        if (m_p_node == &p_link->tx)
+        {
+            p_link->tx_bound = true;
+        }
+        else
+        {
+            p_link->rx_bound = true;
+        }
+        break;
+    case RC_RADIO_EVENT_DATA_RECEIVED:
+        p_link->received++;
+
+        seq = (uint16_t)((uint8_t)p_data->pitch | ((uint8_t)p_data->roll << 8));
+
+        // The same data can be sent again but never older data, and it can't
+        // be newer than the transmitter's.
+        if (((uint8_t)p_link->index != p_data->throttle) ||
+                (0x8000 <= (uint16_t)(seq - p_link->rx_seq)) ||
+                (0x8000 <= (uint16_t)(p_link->seq - seq)))
+        {
+            p_link->wrong++;
+        }
+
+        p_link->rx_seq = seq;
+        break;
+    case RC_RADIO_EVENT_PACKET_DROPPED:
+        p_link->dropped += p_link->rx_bound;
+        break;
+    default:
+        break;
+    }
+}
+
+
+static void m_node_init(node_t * p_node, link_t * p_link)
+{
+    // The crystals are within +-20 ppm (CLOCK_DRIFT_PPM between the ends).
+    p_node->rate      = (1.0 + (((int32_t)(m_sim_rand() % 41) - 20) / 1000000.0));
+    p_node->simulated = true;
+    p_node->p_link    = p_link;
+}
+
+
+// Runs link_count links with random rates, transmitter channels and start
+// times for duration_ms. The receivers are enabled first, each transmitter
+// starts with its first data.
+static sim_stats_t m_links_run(link_t * p_links,
+                                   uint32_t link_count,
+                                   uint32_t duration_ms)
+{
+    static const uint16_t rates_hz[] = {50, 100, 250, 500};
+    sim_stats_t           stats;
+    sim_event_t           event;
+    uint64_t              end_ns = (duration_ms * 1000000ULL);
+    uint32_t              i;
+
+    memset(&stats, 0, sizeof(stats));
+    memset(p_links, 0, (link_count * sizeof(link_t)));
+
+    m_now_ns = 0;
+
+    for (i = 0; i < link_count; i++)
+    {
+        link_t * p_link = &p_links[i];
+
+        p_link->index = i;
+        m_node_init(&p_link->tx, p_link);
+        m_node_init(&p_link->rx, p_link);
+
+        m_node_enter(&p_link->rx);
+        m_p_radio_ctx = NULL;
+        CHECK(NRF_SUCCESS == rc_radio_ctx_receiver_init(&p_link->rx.ctx,
+                                                            (uint8_t)(i % 5),
+                                                            m_node_callback),
+              "link %u receiver_init", i);
+        CHECK(NRF_SUCCESS == rc_radio_ctx_enable(&p_link->rx.ctx),
+              "link %u receiver enable", i);
+        m_irq_run();
+
+        m_node_enter(&p_link->tx);
+        m_p_radio_ctx = NULL;
+        CHECK(NRF_SUCCESS == rc_radio_ctx_transmitter_init(
+                                 &p_link->tx.ctx,
+                                 (uint8_t)(i % 5),
+                                 rates_hz[m_sim_rand() % 4],
+                                 (rc_radio_transmitter_channel_t)(m_sim_rand() %
+                                     RC_RADIO_TRANSMITTER_CHANNEL_COUNT),
+                                 m_node_callback),
+              "link %u transmitter_init", i);
+        CHECK(NRF_SUCCESS == rc_radio_ctx_enable(&p_link->tx.ctx),
+              "link %u transmitter enable", i);
+
+        m_sim_push(((m_sim_rand() % 20000) * 1000ULL), &p_link->tx, SIM_DATA_UPDATE);
+    }
+
+    while ((0 != m_event_count) && (m_events[0].t_ns <= end_ns))
+    {
+        event    = m_sim_pop();
+        m_now_ns = event.t_ns;
+
+        switch (event.kind)
+        {
+        case SIM_TIMER:
+            if (event.version == event.p_node->timer.version)
+            {
+                stats.events++;
+                m_timer_fire(event.p_node);
+            }
+            break;
+        case SIM_RADIO_END:
+            stats.events++;
+            stats.packets++;
+            m_radio_end(event.p_node);
+            break;
+        case SIM_DATA_UPDATE:
+            stats.events++;
+            m_data_update(event.p_node->p_link);
+            break;
+        }
+    }
+
+    m_event_count = 0;
+    stats.links   = link_count;
+
+    // The other checks use the default node.
+    m_node_enter(&m_node);
+    m_p_radio_ctx = NULL;
+
+    return stats;
+}
+
+
+// Checks that every link bound and stayed in sync: each packet was received
+// unless the medium dropped it, each drop was reported and every payload
+// was the link's own and in order.
+static void m_links_check(const link_t * p_links, uint32_t link_count)
+{
+    uint32_t i;
+
+    for (i = 0; i < link_count; i++)
+    {
+        const link_t * p_link = &p_links[i];
+
+        CHECK(p_link->tx_bound && p_link->rx_bound, "link %u bound", i);
+        CHECK(0 < p_link->sent, "link %u sent", i);
+        CHECK(0 == p_link->missed, "link %u: %u of %u sent out of the window",
+              i, p_link->missed, p_link->sent);
+        CHECK(p_link->delivered == p_link->received,
+              "link %u: %u delivered, %u received",
+              i, p_link->delivered, p_link->received);
+        CHECK((p_link->dropped <= p_link->lost) &&
+              ((p_link->lost - p_link->dropped) <= 1),
+              "link %u: %u lost, %u reported", i, p_link->lost, p_link->dropped);
+        CHECK(0 == p_link->wrong, "link %u: %u wrong payloads", i, p_link->wrong);
+    }
+}
+
+
+static void m_links_sim_check(void)
+{
+    link_t *    p_links = calloc(SIM_LINKS, sizeof(link_t));
+
+    m_sim_rand_state     = 0x2468ACEUL;
+    m_sim_loss_per_mille = SIM_LOSS_PER_MILLE;
+
+    (void)m_links_run(p_links, SIM_LINKS, SIM_DURATION_MS);
+    m_links_check(p_links, SIM_LINKS);
+
+    free(p_links);
+}
+
+
+// How the simulation's cost grows with the number of links.
+static void m_links_bench(void)
+{
+    static const uint32_t link_counts[] = {1, 10, 100, 1000};
+    link_t *              p_links;
+    sim_stats_t           stats;
+    uint64_t              start;
+    uint64_t              ns;
+    uint32_t              i;
+
+    printf("%s: simulated links for %u ms\n", CHECK_NAME, SIM_BENCH_MS);
+    printf("  %6s %10s %10s %14s %12s\n",
+           "links", "packets", "events", "ns per event", "host ms");
+
+    for (i = 0; i < (sizeof(link_counts) / sizeof(link_counts[0])); i++)
+    {
+        p_links              = calloc(link_counts[i], sizeof(link_t));
+        m_sim_rand_state     = 0x13579BDUL;
+        m_sim_loss_per_mille = SIM_LOSS_PER_MILLE;
+
+        start = host_check_ns();
+        stats = m_links_run(p_links, link_counts[i], SIM_BENCH_MS);
+        ns    = (host_check_ns() - start);
+
+        m_links_check(p_links, link_counts[i]);
+
+        printf("  %6u %10llu %10llu %14.1f %12.1f\n",
+               stats.links,
+               (unsigned long long)stats.packets,
+               (unsigned long long)stats.events,
+               ((double)ns / stats.events),
+               (ns / 1000000.0));
+
+        free(p_links);
+    }
+}
+
+
+int main(int argc, char * argv[])
+{
+    m_receive_check();
+
+#if RC_RADIO_ZERO_COPY_RX
+    m_pool_check();
+#endif
+
+    m_transmit_check();
+    m_links_sim_check();
+
+    if ((1 < argc) && (0 == strcmp(argv[1], "--bench")))
+    {
+        m_bench();
+        m_links_bench();
+    }
+
+    if ((1 < argc) && (0 == strcmp(argv[1], "--rx-bench")))
+    {
+        m_rx_bench();
+
+        // Only the timing is printed unless something failed.
+        if (0 == host_check_failures)
+        {
+            return EXIT_SUCCESS;
+        }
+    }
+
+    return HOST_CHECK_DONE(CHECK_NAME);
+}
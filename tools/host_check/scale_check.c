@@ -0,0 +1,183 @@
+/**
+ * Checks on the host that the scale_t functions in
+ * src/examples/common/utility.h give the same results as map and pam.
+ *
+ * scale_pam is compared with pam for every value of every range in
+ * [2, SCALE_MAX_RANGE], from a few different minimums. scale_map is compared
+ * with map for every input in [0, 100].
+ *
+ * With --bench it also times scale_pam and scale_map against pam and map
+ * over the ranges that the drivers use.
+ */
+#include "stdbool.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+#include "nrf_error.h"
+#include "utility.h"
+#include "host_check.h"
+
+
+#define BENCH_ITERATIONS (10000000UL)
+#define BENCH_INPUTS     (1024UL)    // A power of two
+
+
+static const uint32_t MINIMUMS[] = {0, 1, 48, 1000, 0xFFFFFFFFUL - SCALE_MAX_RANGE};
+
+// The servo, ESC PWM, OneShot125 and Multishot pulse ranges in ticks and the
+// joystick's ADC range.
+static const uint32_t BENCH_RANGES[][2] = {
+    {600, 2500}, {1000, 2000}, {2000, 4000}, {80, 400}, {0, 4095}
+};
+#define BENCH_RANGE_COUNT (sizeof(BENCH_RANGES) / sizeof(BENCH_RANGES[0]))
+
+
+static void m_bench(void)
+{
+    static uint32_t ranges[BENCH_INPUTS];
+    static uint32_t values[BENCH_INPUTS];
+    static uint8_t  percents[BENCH_INPUTS];
+    scale_t         scales[BENCH_RANGE_COUNT];
+    uint64_t        start;
+    uint32_t        sum = 0;
+    double          pam_ns;
+    double          scale_pam_ns;
+    double          map_ns;
+    double          scale_map_ns;
+    uint32_t        i;
+
+    for (i = 0; i < BENCH_RANGE_COUNT; i++)
+    {
+        (void)scale_init(&scales[i], BENCH_RANGES[i][0], BENCH_RANGES[i][1]);
+    }
+
+    // The inputs are generated up front so that the loops only add an index.
+    srand(1);
+    for (i = 0; i < BENCH_INPUTS; i++)
+    {
+        ranges[i]   = (i % BENCH_RANGE_COUNT);
+        values[i]   = (BENCH_RANGES[ranges[i]][0] +
+                           ((uint32_t)rand() % (scales[ranges[i]].range + 1)));
+        percents[i] = (uint8_t)(rand() % 101);
+    }
+
+    start = host_check_ns();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        uint32_t j = (i % BENCH_INPUTS);
+
+        sum += pam(values[j], BENCH_RANGES[ranges[j]][0], BENCH_RANGES[ranges[j]][1]);
+    }
+    pam_ns = ((double)(host_check_ns() - start) / BENCH_ITERATIONS);
+    HOST_CHECK_KEEP(sum);
+
+    start = host_check_ns();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        uint32_t j = (i % BENCH_INPUTS);
+
+        sum += scale_pam(&scales[ranges[j]], values[j]);
+    }
+    scale_pam_ns = ((double)(host_check_ns() - start) / BENCH_ITERATIONS);
+    HOST_CHECK_KEEP(sum);
+
+    start = host_check_ns();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        uint32_t j = (i % BENCH_INPUTS);
+
+        sum += map(percents[j], BENCH_RANGES[ranges[j]][0], BENCH_RANGES[ranges[j]][1]);
+    }
+    map_ns = ((double)(host_check_ns() - start) / BENCH_ITERATIONS);
+    HOST_CHECK_KEEP(sum);
+
+    start = host_check_ns();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        uint32_t j = (i % BENCH_INPUTS);
+
+        sum += scale_map(&scales[ranges[j]], percents[j]);
+    }
+    scale_map_ns = ((double)(host_check_ns() - start) / BENCH_ITERATIONS);
+    HOST_CHECK_KEEP(sum);
+
+    printf("scale_check: host ns per call\n");
+    printf("  %-10s %6.2f    %-10s %6.2f\n", "pam", pam_ns, "scale_pam", scale_pam_ns);
+    printf("  %-10s %6.2f    %-10s %6.2f\n", "map", map_ns, "scale_map", scale_map_ns);
+}
+
+
+int main(int argc, char * argv[])
+{
+    uint64_t checks   = 0;
+    uint64_t failures = 0;
+    uint32_t m;
+    uint32_t range;
+    uint32_t value;
+    scale_t  scale;
+
+    // The limits of scale_init.
+    if ((NRF_ERROR_INVALID_PARAM != scale_init(&scale, 0, 1)) ||
+            (NRF_ERROR_INVALID_PARAM != scale_init(&scale, 0, SCALE_MAX_RANGE + 1)) ||
+            (NRF_SUCCESS != scale_init(&scale, 0, 2)) ||
+            (NRF_SUCCESS != scale_init(&scale, 0, SCALE_MAX_RANGE)))
+    {
+        printf("FAIL: scale_init accepts the wrong ranges\n");
+        failures++;
+    }
+    checks++;
+
+    for (m = 0; m < (sizeof(MINIMUMS) / sizeof(MINIMUMS[0])); m++)
+    {
+        uint32_t min = MINIMUMS[m];
+
+        for (range = 2; range <= SCALE_MAX_RANGE; range++)
+        {
+            uint32_t max = (min + range);
+
+            (void)scale_init(&scale, min, max);
+
+            for (value = 0; value <= range; value++)
+            {
+                uint8_t expected = pam(min + value, min, max);
+                uint8_t actual   = scale_pam(&scale, min + value);
+
+                checks++;
+                if (expected != actual)
+                {
+                    // One line per range is enough to find the problem.
+                    printf("FAIL: pam(%u, %u, %u) is %u, scale_pam gives %u\n",
+                           min + value, min, max, expected, actual);
+                    failures++;
+                    break;
+                }
+            }
+
+            // The map values are only exercised for the ranges that the
+            // drivers use but every range is cheap enough to check.
+            for (value = 0; value <= 100; value++)
+            {
+                checks++;
+                if (map(value, min, max) != scale_map(&scale, value))
+                {
+                    printf("FAIL: map(%u, %u, %u) is %u, scale_map gives %u\n",
+                           value, min, max, map(value, min, max),
+                           scale_map(&scale, value));
+                    failures++;
+                    break;
+                }
+            }
+        }
+    }
+
+    if ((1 < argc) && (0 == strcmp(argv[1], "--bench")))
+    {
+        m_bench();
+    }
+
+    printf("scale_check: %llu of %llu checks failed\n",
+           (unsigned long long)failures, (unsigned long long)checks);
+
+    return ((0 == failures) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,17 @@
+/* Host stand-in for the SEGGER header. Only what the checked files use. The
+ * checks implement the functions. */
+#ifndef SEGGER_RTT_H
+#define SEGGER_RTT_H
+
+#define SEGGER_RTT_MODE_NO_BLOCK_SKIP (0)
+
+int      SEGGER_RTT_ConfigUpBuffer(unsigned buffer_index,
+                                   const char * p_name,
+                                   void * p_buffer,
+                                   unsigned buffer_size,
+                                   unsigned flags);
+unsigned SEGGER_RTT_Write(unsigned buffer_index,
+                          const void * p_buffer,
+                          unsigned num_bytes);
+
+#endif
@@ -0,0 +1,22 @@
+/* Host stand-in for the SDK header. The checks implement
+ * app_error_handler_bare. */
+#ifndef APP_ERROR_H
+#define APP_ERROR_H
+
+#include "stdint.h"
+
+#include "nrf_error.h"
+
+void app_error_handler_bare(uint32_t error_code);
+
+#define APP_ERROR_CHECK(ERR_CODE)                          \
+    do                                                     \
+    {                                                      \
+        const uint32_t LOCAL_ERR_CODE = (ERR_CODE);        \
+        if (NRF_SUCCESS != LOCAL_ERR_CODE)                 \
+        {                                                  \
+            app_error_handler_bare(LOCAL_ERR_CODE);        \
+        }                                                  \
+    } while (0)
+
+#endif
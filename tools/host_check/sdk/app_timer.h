@@ -0,0 +1,45 @@
+/* Host stand-in for the SDK header. Only what the checked files use. The
+ * checks implement the functions that they use. */
+#ifndef APP_TIMER_H
+#define APP_TIMER_H
+
+#include "stdint.h"
+
+#define APP_TIMER_CLOCK_FREQ            (32768UL)
+
+#ifndef APP_TIMER_CONFIG_RTC_FREQUENCY
+#define APP_TIMER_CONFIG_RTC_FREQUENCY  (0)
+#endif
+
+#define APP_TIMER_TICKS(ms)                                                 \
+    ((uint32_t)((((ms) * (uint64_t)APP_TIMER_CLOCK_FREQ) +                  \
+                 (500UL * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1))) /          \
+                (1000UL * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1))))
+
+typedef enum
+{
+    APP_TIMER_MODE_SINGLE_SHOT,
+    APP_TIMER_MODE_REPEATED
+} app_timer_mode_t;
+
+typedef void (*app_timer_timeout_handler_t)(void * p_context);
+typedef void * app_timer_id_t;
+
+#define APP_TIMER_DEF(timer_id) static app_timer_id_t timer_id
+
+uint32_t app_timer_cnt_get(void);
+uint32_t app_timer_create(app_timer_id_t const * p_timer_id,
+                          app_timer_mode_t mode,
+                          app_timer_timeout_handler_t timeout_handler);
+uint32_t app_timer_start(app_timer_id_t timer_id,
+                         uint32_t timeout_ticks,
+                         void * p_context);
+
+// The RTC counter is 24 bits wide.
+static inline uint32_t app_timer_cnt_diff_compute(uint32_t ticks_to,
+                                                  uint32_t ticks_from)
+{
+    return ((ticks_to - ticks_from) & 0x00FFFFFFUL);
+}
+
+#endif
@@ -0,0 +1,7 @@
+/* Host stand-in for the SDK header. Only what the checked files use. */
+#ifndef APP_UTIL_H
+#define APP_UTIL_H
+
+#define STATIC_ASSERT(expr) _Static_assert((expr), #expr)
+
+#endif
@@ -0,0 +1,13 @@
+/* Host stand-in for the SDK header. Only what the checked files use. */
+#ifndef APP_UTIL_PLATFORM_H
+#define APP_UTIL_PLATFORM_H
+
+#include "stddef.h"
+
+#define APP_IRQ_PRIORITY_HIGH   (2)
+#define APP_IRQ_PRIORITY_LOWEST (7)
+
+#define CRITICAL_REGION_ENTER()
+#define CRITICAL_REGION_EXIT()
+
+#endif
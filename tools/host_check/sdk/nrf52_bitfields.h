@@ -0,0 +1,17 @@
+/* Host stand-in for the SDK header. Only what rc_radio.h and joystick.h use. */
+#ifndef NRF52_BITFIELDS_H
+#define NRF52_BITFIELDS_H
+
+#define RADIO_TXPOWER_TXPOWER_Pos4dBm   (0x04UL)
+#define RADIO_TXPOWER_TXPOWER_Neg12dBm  (0xF4UL)
+
+#define SAADC_CH_PSELP_PSELP_AnalogInput0 (1UL)
+#define SAADC_CH_PSELP_PSELP_AnalogInput1 (2UL)
+#define SAADC_CH_PSELP_PSELP_AnalogInput2 (3UL)
+#define SAADC_CH_PSELP_PSELP_AnalogInput3 (4UL)
+#define SAADC_CH_PSELP_PSELP_AnalogInput4 (5UL)
+#define SAADC_CH_PSELP_PSELP_AnalogInput5 (6UL)
+#define SAADC_CH_PSELP_PSELP_AnalogInput6 (7UL)
+#define SAADC_CH_PSELP_PSELP_AnalogInput7 (8UL)
+
+#endif
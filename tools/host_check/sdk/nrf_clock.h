@@ -0,0 +1,30 @@
+/* Host stand-in for the SDK header. Only what rc_radio.c uses. The HFCLK is
+ * always reported as running so rc_radio.c never waits for it. */
+#ifndef NRF_CLOCK_H
+#define NRF_CLOCK_H
+
+#include "stdint.h"
+
+typedef enum
+{
+    NRF_CLOCK_HFCLK_LOW_ACCURACY,
+    NRF_CLOCK_HFCLK_HIGH_ACCURACY
+} nrf_clock_hfclk_t;
+
+typedef struct
+{
+    volatile uint32_t TASKS_HFCLKSTART;
+    volatile uint32_t TASKS_HFCLKSTOP;
+    volatile uint32_t EVENTS_HFCLKSTARTED;
+} NRF_CLOCK_Type;
+
+extern NRF_CLOCK_Type host_clock;
+
+#define NRF_CLOCK (&host_clock)
+
+static inline nrf_clock_hfclk_t nrf_clock_hf_src_get(void)
+{
+    return NRF_CLOCK_HFCLK_HIGH_ACCURACY;
+}
+
+#endif
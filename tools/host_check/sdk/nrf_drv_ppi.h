@@ -0,0 +1,83 @@
+/* Host stand-in for the SDK header. Only what the checked files use. The
+ * channels are kept in host_ppi so that the checks can see how they were
+ * connected. */
+#ifndef NRF_DRV_PPI_H
+#define NRF_DRV_PPI_H
+
+#include "stdbool.h"
+#include "stdint.h"
+
+#include "nrf_error.h"
+
+#define HOST_PPI_CHANNEL_COUNT (20)
+
+typedef uint32_t nrf_ppi_channel_t;
+
+typedef struct
+{
+    uint32_t eep;
+    uint32_t tep;
+    uint32_t fork_tep;
+    bool     allocated;
+    bool     enabled;
+} host_ppi_channel_t;
+
+static host_ppi_channel_t host_ppi[HOST_PPI_CHANNEL_COUNT];
+
+static inline uint32_t nrf_drv_ppi_init(void)
+{
+    return NRF_SUCCESS;
+}
+
+static inline uint32_t nrf_drv_ppi_channel_alloc(nrf_ppi_channel_t * p_channel)
+{
+    nrf_ppi_channel_t i;
+
+    for (i = 0; i < HOST_PPI_CHANNEL_COUNT; i++)
+    {
+        if (!host_ppi[i].allocated)
+        {
+            host_ppi[i].allocated = true;
+            *p_channel = i;
+            return NRF_SUCCESS;
+        }
+    }
+
+    return NRF_ERROR_INVALID_STATE;
+}
+
+static inline uint32_t nrf_drv_ppi_channel_free(nrf_ppi_channel_t channel)
+{
+    host_ppi[channel] = (host_ppi_channel_t){0};
+    return NRF_SUCCESS;
+}
+
+static inline uint32_t nrf_drv_ppi_channel_assign(nrf_ppi_channel_t channel,
+                                                  uint32_t eep,
+                                                  uint32_t tep)
+{
+    host_ppi[channel].eep = eep;
+    host_ppi[channel].tep = tep;
+    return NRF_SUCCESS;
+}
+
+static inline uint32_t nrf_drv_ppi_channel_fork_assign(nrf_ppi_channel_t channel,
+                                                       uint32_t fork_tep)
+{
+    host_ppi[channel].fork_tep = fork_tep;
+    return NRF_SUCCESS;
+}
+
+static inline uint32_t nrf_drv_ppi_channel_enable(nrf_ppi_channel_t channel)
+{
+    host_ppi[channel].enabled = true;
+    return NRF_SUCCESS;
+}
+
+static inline uint32_t nrf_drv_ppi_channel_disable(nrf_ppi_channel_t channel)
+{
+    host_ppi[channel].enabled = false;
+    return NRF_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,64 @@
+/* Host stand-in for the SDK header. Only what the checked files use. The
+ * checks implement the two functions to capture what would be played. */
+#ifndef NRF_DRV_PWM_H
+#define NRF_DRV_PWM_H
+
+#include "stdint.h"
+
+#include "nrf_error.h"
+#include "nrf_pwm.h"
+
+#define NRF_DRV_PWM_PIN_NOT_USED         (0xFF)
+
+#define NRF_DRV_PWM_FLAG_LOOP            (0x01)
+#define NRF_DRV_PWM_FLAG_SIGNAL_END_SEQ0 (0x02)
+#define NRF_DRV_PWM_FLAG_SIGNAL_END_SEQ1 (0x04)
+#define NRF_DRV_PWM_FLAG_START_VIA_TASK  (0x80)
+
+#define PWM0_INSTANCE_INDEX (0)
+#define PWM1_INSTANCE_INDEX (1)
+#define PWM2_INSTANCE_INDEX (2)
+
+typedef enum
+{
+    NRF_DRV_PWM_EVT_FINISHED,
+    NRF_DRV_PWM_EVT_END_SEQ0,
+    NRF_DRV_PWM_EVT_END_SEQ1,
+    NRF_DRV_PWM_EVT_STOPPED
+} nrf_drv_pwm_evt_type_t;
+
+typedef void (*nrf_drv_pwm_handler_t)(nrf_drv_pwm_evt_type_t event_type);
+
+typedef struct
+{
+    NRF_PWM_Type * p_registers;
+    uint8_t        drv_inst_idx;
+} nrf_drv_pwm_t;
+
+typedef struct
+{
+    uint8_t            output_pins[4];
+    uint8_t            irq_priority;
+    nrf_pwm_clk_t      base_clock;
+    nrf_pwm_mode_t     count_mode;
+    uint16_t           top_value;
+    nrf_pwm_dec_load_t load_mode;
+    nrf_pwm_dec_step_t step_mode;
+} nrf_drv_pwm_config_t;
+
+uint32_t nrf_drv_pwm_init(nrf_drv_pwm_t const * const p_instance,
+                          nrf_drv_pwm_config_t const * p_config,
+                          nrf_drv_pwm_handler_t handler);
+
+uint32_t nrf_drv_pwm_complex_playback(nrf_drv_pwm_t const * const p_instance,
+                                      nrf_pwm_sequence_t const * p_sequence_0,
+                                      nrf_pwm_sequence_t const * p_sequence_1,
+                                      uint16_t playback_count,
+                                      uint32_t flags);
+
+uint32_t nrf_drv_pwm_simple_playback(nrf_drv_pwm_t const * const p_instance,
+                                     nrf_pwm_sequence_t const * p_sequence,
+                                     uint16_t playback_count,
+                                     uint32_t flags);
+
+#endif
@@ -0,0 +1,59 @@
+/* Host stand-in for the SDK header. Only what sainsmart_joystick.c uses. The
+ * checks implement the functions. */
+#ifndef NRF_DRV_SAADC_H
+#define NRF_DRV_SAADC_H
+
+#include "stdbool.h"
+#include "stdint.h"
+
+#include "sdk_errors.h"
+#include "app_error.h"
+#include "nrf_saadc.h"
+
+typedef struct
+{
+    nrf_saadc_resolution_t resolution;
+    nrf_saadc_oversample_t oversample;
+    uint8_t                interrupt_priority;
+    bool                   low_power_mode;
+} nrf_drv_saadc_config_t;
+
+typedef enum
+{
+    NRF_DRV_SAADC_EVT_DONE,
+    NRF_DRV_SAADC_EVT_LIMIT,
+    NRF_DRV_SAADC_EVT_CALIBRATEDONE
+} nrf_drv_saadc_evt_type_t;
+
+typedef struct
+{
+    nrf_saadc_value_t * p_buffer;
+    uint16_t            size;
+} nrf_drv_saadc_done_evt_t;
+
+typedef struct
+{
+    nrf_drv_saadc_evt_type_t type;
+    union
+    {
+        nrf_drv_saadc_done_evt_t done;
+    } data;
+} nrf_drv_saadc_evt_t;
+
+typedef void (*nrf_drv_saadc_event_handler_t)(nrf_drv_saadc_evt_t const * p_event);
+
+#define NRF_DRV_SAADC_DEFAULT_CHANNEL_CONFIG_SE(PIN_P) \
+{                                                      \
+    .pin_p = (uint32_t)(PIN_P),                        \
+    .pin_n = 0,                                        \
+    .burst = NRF_SAADC_BURST_DISABLED                  \
+}
+
+ret_code_t nrf_drv_saadc_init(nrf_drv_saadc_config_t const * p_config,
+                              nrf_drv_saadc_event_handler_t event_handler);
+ret_code_t nrf_drv_saadc_channel_init(uint8_t channel,
+                                      nrf_saadc_channel_config_t const * const p_config);
+ret_code_t nrf_drv_saadc_buffer_convert(nrf_saadc_value_t * buffer, uint16_t size);
+uint32_t nrf_drv_saadc_sample_task_get(void);
+
+#endif
@@ -0,0 +1,125 @@
+/* Host stand-in for the SDK header. Only what rc_radio.c and
+ * sainsmart_joystick.c use. Every instance shares one set of registers since
+ * the checks model the timers themselves and implement the functions that
+ * they call. */
+#ifndef NRF_DRV_TIMER_H
+#define NRF_DRV_TIMER_H
+
+#include "stddef.h"
+#include "stdint.h"
+#include "stdbool.h"
+
+#define TIMER_MODE_MODE_Timer         (0UL)
+
+#define NRF_TIMER_CC_CHANNEL_COUNT(id) (((id) < 3) ? 4 : 6)
+
+#define TIMER0_INSTANCE_INDEX         (0)
+#define TIMER1_INSTANCE_INDEX         (1)
+#define TIMER2_INSTANCE_INDEX         (2)
+#define TIMER3_INSTANCE_INDEX         (3)
+#define TIMER4_INSTANCE_INDEX         (4)
+
+typedef struct
+{
+    volatile uint32_t CC[6];
+} NRF_TIMER_Type;
+
+extern NRF_TIMER_Type host_timer;
+
+#define NRF_TIMER0 (&host_timer)
+#define NRF_TIMER1 (&host_timer)
+#define NRF_TIMER2 (&host_timer)
+#define NRF_TIMER3 (&host_timer)
+#define NRF_TIMER4 (&host_timer)
+
+typedef enum
+{
+    NRF_TIMER_FREQ_16MHz = 0,
+    NRF_TIMER_FREQ_1MHz  = 4
+} nrf_timer_frequency_t;
+
+typedef enum
+{
+    NRF_TIMER_BIT_WIDTH_16 = 0,
+    NRF_TIMER_BIT_WIDTH_32 = 3
+} nrf_timer_bit_width_t;
+
+typedef enum
+{
+    NRF_TIMER_CC_CHANNEL0,
+    NRF_TIMER_CC_CHANNEL1,
+    NRF_TIMER_CC_CHANNEL2,
+    NRF_TIMER_CC_CHANNEL3
+} nrf_timer_cc_channel_t;
+
+typedef enum
+{
+    NRF_TIMER_EVENT_COMPARE0,
+    NRF_TIMER_EVENT_COMPARE1,
+    NRF_TIMER_EVENT_COMPARE2,
+    NRF_TIMER_EVENT_COMPARE3
+} nrf_timer_event_t;
+
+typedef enum
+{
+    NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK = (1UL << 0),
+    NRF_TIMER_SHORT_COMPARE1_CLEAR_MASK = (1UL << 1),
+    NRF_TIMER_SHORT_COMPARE2_CLEAR_MASK = (1UL << 2),
+    NRF_TIMER_SHORT_COMPARE3_CLEAR_MASK = (1UL << 3)
+} nrf_timer_short_mask_t;
+
+typedef struct
+{
+    NRF_TIMER_Type * p_reg;
+    uint8_t          instance_id;
+    uint8_t          cc_channel_count;
+} nrf_drv_timer_t;
+
+typedef struct
+{
+    nrf_timer_frequency_t frequency;
+    uint32_t              mode;
+    nrf_timer_bit_width_t bit_width;
+    uint8_t               interrupt_priority;
+    void *                p_context;
+} nrf_drv_timer_config_t;
+
+#define NRF_DRV_TIMER_DEFAULT_CONFIG                \
+{                                                   \
+    .frequency          = NRF_TIMER_FREQ_1MHz,      \
+    .mode               = TIMER_MODE_MODE_Timer,    \
+    .bit_width          = NRF_TIMER_BIT_WIDTH_16,   \
+    .interrupt_priority = 7,                        \
+    .p_context          = NULL                      \
+}
+
+typedef void (*nrf_timer_event_handler_t)(nrf_timer_event_t event_type,
+                                              void * p_context);
+
+uint32_t nrf_drv_timer_init(nrf_drv_timer_t const * const p_instance,
+                                nrf_drv_timer_config_t const * p_config,
+                                nrf_timer_event_handler_t timer_event_handler);
+void nrf_drv_timer_enable(nrf_drv_timer_t const * const p_instance);
+void nrf_drv_timer_disable(nrf_drv_timer_t const * const p_instance);
+void nrf_drv_timer_clear(nrf_drv_timer_t const * const p_instance);
+void nrf_drv_timer_compare(nrf_drv_timer_t const * const p_instance,
+                               nrf_timer_cc_channel_t cc_channel,
+                               uint32_t cc_value,
+                               bool enable_int);
+void nrf_drv_timer_extended_compare(nrf_drv_timer_t const * const p_instance,
+                                        nrf_timer_cc_channel_t cc_channel,
+                                        uint32_t cc_value,
+                                        nrf_timer_short_mask_t timer_short_mask,
+                                        bool enable_int);
+uint32_t nrf_drv_timer_capture_get(nrf_drv_timer_t const * const p_instance,
+                                       nrf_timer_cc_channel_t cc_channel);
+uint32_t nrf_drv_timer_ms_to_ticks(nrf_drv_timer_t const * const p_instance,
+                                       uint32_t time_ms);
+uint32_t nrf_drv_timer_compare_event_address_get(nrf_drv_timer_t const * const p_instance,
+                                                     uint32_t channel);
+void nrf_timer_cc_write(NRF_TIMER_Type * p_reg,
+                            nrf_timer_cc_channel_t cc_channel,
+                            uint32_t cc_value);
+void nrf_timer_event_clear(NRF_TIMER_Type * p_reg, nrf_timer_event_t event);
+
+#endif
@@ -0,0 +1,63 @@
+/* Host stand-in for the SDK header. Only what the checked files use.
+ * Triggering the task passes the event on to the enabled PPI channels and
+ * calls host_task_trigger (implemented by the check) for their tasks. */
+#ifndef NRF_EGU_H
+#define NRF_EGU_H
+
+#include "stdbool.h"
+#include "stdint.h"
+
+#include "nrf_drv_ppi.h"
+
+typedef struct
+{
+    uint32_t events_triggered;
+} NRF_EGU_Type;
+
+typedef enum { NRF_EGU_TASK_TRIGGER0 } nrf_egu_task_t;
+typedef enum { NRF_EGU_EVENT_TRIGGERED0 } nrf_egu_event_t;
+
+extern NRF_EGU_Type host_egu;
+
+#define NRF_EGU4 (&host_egu)
+
+void host_task_trigger(uint32_t task);
+
+// The address is truncated to 32 bits like the ones on the target.
+static inline uint32_t nrf_egu_event_address_get(NRF_EGU_Type * p_reg,
+                                                 nrf_egu_event_t event)
+{
+    return (uint32_t)(uintptr_t)&p_reg->events_triggered;
+}
+
+static inline void nrf_egu_event_clear(NRF_EGU_Type * p_reg, nrf_egu_event_t event)
+{
+    p_reg->events_triggered = 0;
+}
+
+static inline bool nrf_egu_event_check(NRF_EGU_Type * p_reg, nrf_egu_event_t event)
+{
+    return (0 != p_reg->events_triggered);
+}
+
+static inline void nrf_egu_task_trigger(NRF_EGU_Type * p_reg, nrf_egu_task_t task)
+{
+    uint32_t event = nrf_egu_event_address_get(p_reg, NRF_EGU_EVENT_TRIGGERED0);
+    uint32_t i;
+
+    p_reg->events_triggered = 1;
+
+    for (i = 0; i < HOST_PPI_CHANNEL_COUNT; i++)
+    {
+        if (host_ppi[i].enabled && (event == host_ppi[i].eep))
+        {
+            host_task_trigger(host_ppi[i].tep);
+            if (0 != host_ppi[i].fork_tep)
+            {
+                host_task_trigger(host_ppi[i].fork_tep);
+            }
+        }
+    }
+}
+
+#endif
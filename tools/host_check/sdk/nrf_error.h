@@ -0,0 +1,16 @@
+/* Host stand-in for the SDK header. Only what the checked files use. */
+#ifndef NRF_ERROR_H
+#define NRF_ERROR_H
+
+#define NRF_SUCCESS             (0)
+#define NRF_ERROR_INTERNAL      (3)
+#define NRF_ERROR_NO_MEM        (4)
+#define NRF_ERROR_NOT_SUPPORTED (6)
+#define NRF_ERROR_INVALID_STATE (8)
+#define NRF_ERROR_INVALID_PARAM (7)
+#define NRF_ERROR_INVALID_DATA  (11)
+#define NRF_ERROR_BUSY          (17)
+
+#define NRF_ERROR_MODULE_ALREADY_INITIALIZED (0x8005)
+
+#endif
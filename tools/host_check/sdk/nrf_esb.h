@@ -0,0 +1,89 @@
+/* Host stand-in for the SDK header. Only what rc_radio.h and rc_radio.c use.
+ * The checks implement the functions that they call. */
+#ifndef NRF_ESB_H
+#define NRF_ESB_H
+
+#include "stdint.h"
+#include "stdbool.h"
+
+#include "nrf.h"
+
+#ifndef NRF_ESB_MAX_PAYLOAD_LENGTH
+#define NRF_ESB_MAX_PAYLOAD_LENGTH (32)
+#endif
+
+typedef enum
+{
+    NRF_ESB_MODE_PTX,
+    NRF_ESB_MODE_PRX
+} nrf_esb_mode_t;
+
+typedef enum
+{
+    NRF_ESB_BITRATE_2MBPS,
+    NRF_ESB_BITRATE_1MBPS
+} nrf_esb_bitrate_t;
+
+typedef enum
+{
+    NRF_ESB_EVENT_TX_SUCCESS,
+    NRF_ESB_EVENT_TX_FAILED,
+    NRF_ESB_EVENT_RX_RECEIVED
+} nrf_esb_evt_id_t;
+
+typedef struct
+{
+    uint8_t length;
+    uint8_t pipe;
+    int8_t  rssi;
+    uint8_t noack;
+    uint8_t pid;
+    uint8_t data[NRF_ESB_MAX_PAYLOAD_LENGTH];
+} nrf_esb_payload_t;
+
+typedef struct
+{
+    nrf_esb_evt_id_t evt_id;
+    uint32_t         tx_attempts;
+} nrf_esb_evt_t;
+
+typedef void (*nrf_esb_event_handler_t)(nrf_esb_evt_t const * p_event);
+
+typedef struct
+{
+    nrf_esb_mode_t          mode;
+    nrf_esb_event_handler_t event_handler;
+    nrf_esb_bitrate_t       bitrate;
+    uint8_t                 tx_output_power;
+    uint16_t                retransmit_delay;
+    uint16_t                retransmit_count;
+    uint8_t                 radio_irq_priority;
+    uint8_t                 event_irq_priority;
+    uint8_t                 payload_length;
+    bool                    selective_auto_ack;
+} nrf_esb_config_t;
+
+#define NRF_ESB_DEFAULT_CONFIG {.mode               = NRF_ESB_MODE_PTX,     \
+                                .event_handler      = 0,                    \
+                                .bitrate            = NRF_ESB_BITRATE_2MBPS,\
+                                .tx_output_power    = 0,                    \
+                                .retransmit_delay   = 250,                  \
+                                .retransmit_count   = 3,                    \
+                                .radio_irq_priority = 1,                    \
+                                .event_irq_priority = 2,                    \
+                                .payload_length     = 32,                   \
+                                .selective_auto_ack = false}
+
+uint32_t nrf_esb_init(nrf_esb_config_t const * p_config);
+uint32_t nrf_esb_disable(void);
+uint32_t nrf_esb_write_payload(nrf_esb_payload_t const * p_payload);
+uint32_t nrf_esb_read_rx_payload(nrf_esb_payload_t * p_payload);
+uint32_t nrf_esb_start_rx(void);
+uint32_t nrf_esb_stop_rx(void);
+uint32_t nrf_esb_flush_tx(void);
+uint32_t nrf_esb_set_rf_channel(uint32_t channel);
+uint32_t nrf_esb_set_base_address_0(uint8_t const * p_addr);
+uint32_t nrf_esb_set_prefixes(uint8_t const * p_prefixes, uint8_t num_pipes);
+uint32_t nrf_esb_set_tx_power(uint8_t tx_output_power);
+
+#endif
@@ -0,0 +1,11 @@
+/* Host stand-in for the SDK header. Only what sainsmart_joystick.c uses. The
+ * checks implement the functions on a page of RAM. */
+#ifndef NRF_NVMC_H
+#define NRF_NVMC_H
+
+#include "stdint.h"
+
+void nrf_nvmc_page_erase(uint32_t address);
+void nrf_nvmc_write_words(uint32_t address, const uint32_t * src, uint32_t num_words);
+
+#endif
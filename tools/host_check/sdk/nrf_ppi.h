@@ -0,0 +1,8 @@
+/* Host stand-in for the SDK header. nrf_ppi_channel_t is declared in
+ * nrf_drv_ppi.h. */
+#ifndef NRF_PPI_H
+#define NRF_PPI_H
+
+#include "nrf_drv_ppi.h"
+
+#endif
@@ -0,0 +1,46 @@
+/* Host stand-in for the SDK header. Only what the checked files use. */
+#ifndef NRF_PWM_H
+#define NRF_PWM_H
+
+#include "stdint.h"
+
+typedef enum
+{
+    NRF_PWM_CLK_16MHz,
+    NRF_PWM_CLK_1MHz
+} nrf_pwm_clk_t;
+
+typedef enum { NRF_PWM_MODE_UP } nrf_pwm_mode_t;
+typedef enum { NRF_PWM_LOAD_INDIVIDUAL } nrf_pwm_dec_load_t;
+typedef enum { NRF_PWM_STEP_AUTO } nrf_pwm_dec_step_t;
+
+typedef struct
+{
+    uint16_t channel_0;
+    uint16_t channel_1;
+    uint16_t channel_2;
+    uint16_t channel_3;
+} nrf_pwm_values_individual_t;
+
+typedef union
+{
+    nrf_pwm_values_individual_t const * p_individual;
+} nrf_pwm_values_t;
+
+typedef struct
+{
+    nrf_pwm_values_t values;
+    uint16_t         length;
+    uint32_t         repeats;
+    uint32_t         end_delay;
+} nrf_pwm_sequence_t;
+
+typedef struct { uint32_t unused; } NRF_PWM_Type;
+
+extern NRF_PWM_Type host_pwm[4];
+
+#define NRF_PWM0 (&host_pwm[0])
+#define NRF_PWM1 (&host_pwm[1])
+#define NRF_PWM2 (&host_pwm[2])
+
+#endif
@@ -0,0 +1,39 @@
+/* Host stand-in for the SDK header. Only what sainsmart_joystick.c uses. */
+#ifndef NRF_SAADC_H
+#define NRF_SAADC_H
+
+#include "stdint.h"
+
+typedef int16_t nrf_saadc_value_t;
+
+typedef enum
+{
+    NRF_SAADC_RESOLUTION_8BIT  = 0,
+    NRF_SAADC_RESOLUTION_10BIT = 1,
+    NRF_SAADC_RESOLUTION_12BIT = 2,
+    NRF_SAADC_RESOLUTION_14BIT = 3
+} nrf_saadc_resolution_t;
+
+typedef enum
+{
+    NRF_SAADC_OVERSAMPLE_DISABLED = 0,
+    NRF_SAADC_OVERSAMPLE_2X       = 1,
+    NRF_SAADC_OVERSAMPLE_4X       = 2,
+    NRF_SAADC_OVERSAMPLE_8X       = 3,
+    NRF_SAADC_OVERSAMPLE_16X      = 4
+} nrf_saadc_oversample_t;
+
+typedef enum
+{
+    NRF_SAADC_BURST_DISABLED = 0,
+    NRF_SAADC_BURST_ENABLED  = 1
+} nrf_saadc_burst_t;
+
+typedef struct
+{
+    uint32_t          pin_p;
+    uint32_t          pin_n;
+    nrf_saadc_burst_t burst;
+} nrf_saadc_channel_config_t;
+
+#endif
@@ -0,0 +1,11 @@
+/* Host stand-in for the SDK header. Only what the checked files use. */
+#ifndef SDK_ERRORS_H
+#define SDK_ERRORS_H
+
+#include "stdint.h"
+
+#include "nrf_error.h"
+
+typedef uint32_t ret_code_t;
+
+#endif
@@ -0,0 +1,328 @@
+/**
+ * Checks src/examples/common/trace.c on the host.
+ *
+ * - Records come out of RTT in order and with the wire layout that
+ *   tools/trace_decode.py reads.
+ * - A full ring drops records and reports the count with a DROPPED record.
+ * - A full RTT buffer (no debugger attached) drops records as well and
+ *   trace_process still returns false so the main loop can sleep.
+ *
+ * It also times the joystick handler's TRACE call against the five
+ * NRF_LOG_INFO calls that it replaced. NRF_LOG is modelled the way the
+ * examples configure it (NRF_LOG_DEFERRED with the RTT backend): each call
+ * copies its arguments into a buffer from the interrupt and NRF_LOG_PROCESS
+ * formats the string and writes it to RTT from the main loop.
+ */
+#include "string.h"
+
+#include "host_check.h"
+#include "trace.c"
+
+
+#define RTT_CAPACITY       (4096UL)
+#define BENCH_ITERATIONS   (10000000UL)
+#define LOG_BUFF_WORDS     (256UL)   // NRF_LOG_BUFSIZE / 4 in sdk_config.h
+#define LOG_STR_LEN        (64UL)
+
+
+HOST_CHECK_DEFINE();
+
+static uint32_t m_now;
+static uint8_t  m_rtt[RTT_CAPACITY];
+static uint32_t m_rtt_len;
+static uint32_t m_rtt_space;
+
+
+uint32_t app_timer_cnt_get(void)
+{
+    return m_now++;
+}
+
+
+int SEGGER_RTT_ConfigUpBuffer(unsigned buffer_index,
+                              const char * p_name,
+                              void * p_buffer,
+                              unsigned buffer_size,
+                              unsigned flags)
+{
+    return 0;
+}
+
+
+// Behaves like NO_BLOCK_SKIP: all or nothing.
+unsigned SEGGER_RTT_Write(unsigned buffer_index,
+                          const void * p_buffer,
+                          unsigned num_bytes)
+{
+    if ((m_rtt_space - m_rtt_len) < num_bytes)
+    {
+        return 0;
+    }
+
+    memcpy(&m_rtt[m_rtt_len], p_buffer, num_bytes);
+    m_rtt_len += num_bytes;
+
+    return num_bytes;
+}
+
+
+static void m_rtt_reset(uint32_t space)
+{
+    m_rtt_len   = 0;
+    m_rtt_space = space;
+}
+
+
+// The wire record is the timestamp, the id and the arguments.
+static void m_record_get(uint32_t index, uint16_t * p_id, int16_t * p_args)
+{
+    const uint8_t * p_wire = &m_rtt[index * RECORD_WIRE_LEN];
+
+    memcpy(p_id, (p_wire + 4), sizeof(*p_id));
+    memcpy(p_args, (p_wire + 6), (TRACE_ARG_COUNT * sizeof(*p_args)));
+}
+
+
+static void m_order_check(void)
+{
+    uint16_t id;
+    int16_t  args[TRACE_ARG_COUNT];
+    uint32_t i;
+
+    (void)trace_init();
+    m_rtt_reset(RTT_CAPACITY);
+
+    for (i = 0; i < 10; i++)
+    {
+        TRACE(TX_JOYSTICK_RAW, i, -i, 4095, 0);
+    }
+
+    CHECK(!trace_process(), "trace_process reported pending records");
+    CHECK((10 * RECORD_WIRE_LEN) == m_rtt_len, "%u bytes sent", m_rtt_len);
+
+    for (i = 0; i < 10; i++)
+    {
+        m_record_get(i, &id, args);
+        CHECK((TRACE_ID_TX_JOYSTICK_RAW == id) &&
+                  ((int16_t)i == args[0]) && ((int16_t)-i == args[1]) &&
+                  (4095 == args[2]) && (0 == args[3]) && (0 == args[4]),
+              "record %u: id %u args %d %d %d %d %d",
+              i, id, args[0], args[1], args[2], args[3], args[4]);
+    }
+}
+
+
+static void m_ring_full_check(void)
+{
+    uint16_t id;
+    int16_t  args[TRACE_ARG_COUNT];
+    uint32_t i;
+
+    (void)trace_init();
+    m_rtt_reset(RTT_CAPACITY);
+
+    for (i = 0; i < (TRACE_RING_SIZE + 6); i++)
+    {
+        TRACE(TX_DATA_SENT);
+    }
+
+    CHECK(!trace_process(), "trace_process reported pending records");
+    CHECK(((TRACE_RING_SIZE + 1) * RECORD_WIRE_LEN) == m_rtt_len,
+          "%u bytes sent", m_rtt_len);
+
+    m_record_get(TRACE_RING_SIZE, &id, args);
+    CHECK((TRACE_ID_DROPPED == id) && (6 == args[0]),
+          "last record: id %u count %d", id, args[0]);
+}
+
+
+static void m_rtt_full_check(void)
+{
+    uint16_t id;
+    int16_t  args[TRACE_ARG_COUNT];
+    uint32_t i;
+
+    (void)trace_init();
+
+    // Room for two records, like a buffer that no debugger is reading.
+    m_rtt_reset(2 * RECORD_WIRE_LEN);
+
+    for (i = 0; i < 10; i++)
+    {
+        TRACE(TX_DATA_SENT);
+    }
+
+    CHECK(!trace_process(), "trace_process stays busy while RTT is full");
+    CHECK(m_tail == m_head, "%u records left in the ring", (m_head - m_tail));
+    CHECK((2 * RECORD_WIRE_LEN) == m_rtt_len, "%u bytes sent", m_rtt_len);
+
+    // The ring takes new records and the count is kept until it fits.
+    for (i = 0; i < (2 * TRACE_RING_SIZE); i++)
+    {
+        TRACE(TX_DATA_SENT);
+        CHECK(!trace_process(), "trace_process stays busy while RTT is full");
+    }
+    CHECK(((2 * TRACE_RING_SIZE) + 8) == m_dropped, "%u dropped", m_dropped);
+
+    m_rtt_reset(RTT_CAPACITY);
+    CHECK(!trace_process(), "trace_process reported pending records");
+    m_record_get(0, &id, args);
+    CHECK((RECORD_WIRE_LEN == m_rtt_len) &&
+              (TRACE_ID_DROPPED == id) && (((2 * TRACE_RING_SIZE) + 8) == args[0]),
+          "%u bytes sent, id %u count %d", m_rtt_len, id, args[0]);
+}
+
+
+static void m_pending_check(void)
+{
+    (void)trace_init();
+    m_rtt_reset(RTT_CAPACITY);
+
+    // A slot that an interrupt has reserved but not filled yet.
+    m_head++;
+    CHECK(trace_process(), "trace_process ignored a slot being written");
+    CHECK(0 == m_rtt_len, "%u bytes sent", m_rtt_len);
+}
+
+
+// NRF_LOG_INFO with NRF_LOG_DEFERRED: the string pointer and the arguments
+// are pushed into a word buffer under a critical region.
+static uint32_t        m_log_buff[LOG_BUFF_WORDS];
+static uint32_t        m_log_wr;
+static uint32_t        m_log_rd;
+
+static void m_log_push(const char * p_str, uint32_t nargs, const int32_t * p_args)
+{
+    uint32_t i;
+
+    m_log_buff[m_log_wr++ % LOG_BUFF_WORDS] = nargs;
+    m_log_buff[m_log_wr++ % LOG_BUFF_WORDS] = app_timer_cnt_get();
+    memcpy(&m_log_buff[m_log_wr++ % LOG_BUFF_WORDS], &p_str, sizeof(uint32_t));
+    for (i = 0; i < nargs; i++)
+    {
+        m_log_buff[m_log_wr++ % LOG_BUFF_WORDS] = (uint32_t)p_args[i];
+    }
+}
+
+
+// NRF_LOG_PROCESS: formats one entry and writes it to RTT.
+static void m_log_process(const char * const * pp_strs)
+{
+    char     str[LOG_STR_LEN];
+    uint32_t nargs;
+    int32_t  arg;
+    int      len;
+
+    nargs = m_log_buff[m_log_rd++ % LOG_BUFF_WORDS];
+    m_log_rd += 2;
+
+    if (0 == nargs)
+    {
+        len = snprintf(str, sizeof(str), "%s", *pp_strs);
+    }
+    else
+    {
+        arg = (int32_t)m_log_buff[m_log_rd++ % LOG_BUFF_WORDS];
+        len = snprintf(str, sizeof(str), *pp_strs, arg);
+    }
+
+    m_rtt_len = 0;
+    (void)SEGGER_RTT_Write(0, str, (unsigned)len);
+}
+
+
+static void m_bench(void)
+{
+    static const char * const strs[] = {
+        "-----Raw joystick data-----\r\n",
+        "Left X:\t%d\r\n",
+        "Left Y:\t%d\r\n",
+        "Right X:\t%d\r\n",
+        "Right Y:\t%d\r\n",
+    };
+    uint64_t start;
+    double   trace_isr_ns;
+    double   trace_main_ns;
+    double   log_isr_ns;
+    double   log_main_ns;
+    uint32_t i;
+    uint32_t j;
+
+    (void)trace_init();
+    m_rtt_reset(RTT_CAPACITY);
+
+    start = host_check_ns();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        // Emptied without sending anything so that no record is dropped.
+        if (0 == (i % TRACE_RING_SIZE))
+        {
+            m_tail = m_head;
+        }
+        TRACE(TX_JOYSTICK_RAW, i, i + 1, i + 2, i + 3);
+    }
+    trace_isr_ns = ((double)(host_check_ns() - start) / BENCH_ITERATIONS);
+
+    start = host_check_ns();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        TRACE(TX_JOYSTICK_RAW, i, i + 1, i + 2, i + 3);
+        m_rtt_len = 0;
+        (void)trace_process();
+    }
+    trace_main_ns = (((double)(host_check_ns() - start) / BENCH_ITERATIONS) -
+                         trace_isr_ns);
+
+    start = host_check_ns();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        int32_t args[4] = {i, i + 1, i + 2, i + 3};
+
+        m_log_push(strs[0], 0, NULL);
+        for (j = 0; j < 4; j++)
+        {
+            m_log_push(strs[j + 1], 1, &args[j]);
+        }
+        m_log_rd = m_log_wr;
+    }
+    log_isr_ns = ((double)(host_check_ns() - start) / BENCH_ITERATIONS);
+
+    start = host_check_ns();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        int32_t args[4] = {i, i + 1, i + 2, i + 3};
+
+        m_log_push(strs[0], 0, NULL);
+        for (j = 0; j < 4; j++)
+        {
+            m_log_push(strs[j + 1], 1, &args[j]);
+        }
+        for (j = 0; j < 5; j++)
+        {
+            m_log_process(&strs[j]);
+        }
+    }
+    log_main_ns = (((double)(host_check_ns() - start) / BENCH_ITERATIONS) -
+                       log_isr_ns);
+
+    printf("trace_check: joystick sample, host ns per event\n");
+    printf("  %-22s %8s %8s\n", "", "handler", "main");
+    printf("  %-22s %8.1f %8.1f\n", "TRACE", trace_isr_ns, trace_main_ns);
+    printf("  %-22s %8.1f %8.1f\n", "5 x NRF_LOG_INFO", log_isr_ns, log_main_ns);
+}
+
+
+int main(int argc, char * argv[])
+{
+    m_order_check();
+    m_ring_full_check();
+    m_rtt_full_check();
+    m_pending_check();
+
+    if ((1 < argc) && (0 == strcmp(argv[1], "--bench")))
+    {
+        m_bench();
+    }
+
+    return HOST_CHECK_DONE("trace_check");
+}
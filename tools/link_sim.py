@@ -0,0 +1,801 @@
+#!/usr/bin/env python3
+"""
+Monte Carlo model of an rc_radio link for sweeping its timing parameters.
+
+Each run simulates one bound transmitter/receiver pair for a number of
+seconds. The transmitter sends a payload at the start of every interval and
+hops to the next channel. The receiver follows the timer logic in
+src/rc_radio.c: it opens its window at CC0, gives up at CC1 (which clears the
+timer), re-centres the window after the first miss and goes back to binding
+after RC_RADIO_MISSED_PACKET_TOLERANCE misses in a row. The transmitter never
+finds out about that, so a lost link stays lost for the rest of the run.
+Both crystals get a random error within +/- --drift-ppm.
+
+With --keepalive N (RC_RADIO_KEEPALIVE_INTERVAL) the transmitter only sends
+in the intervals in which the data changed, which happens with probability
+--activity, and otherwise every N intervals. The receiver still opens its
+window every interval and its timer isn't corrected in between, so the
+crystals drift apart for up to N intervals. The latency is then only
+recorded for the samples that changed the data, and a lost change waits for
+the next packet that is sent.
+
+With --relay a third node is added between them: the relay receives from the
+transmitter like a receiver and sends each packet on to the receiver (on the
+next channel map) in its slot, RELAY_TX_DELAY_US after its timer was cleared.
+Nothing is sent downstream for an interval that the relay missed. Both hops
+use the same channel model with independent losses. The summary then also
+reports the latency added by the relay, the smallest gap between the end of
+the relay's slot and its next upstream window, and the relay's radio current.
+
+The timing constants, the channel maps and the tolerance are read from
+rc_radio.c and rc_radio.h so the model follows the code. Sweeps are the cross
+product of the comma separated values, e.g.:
+
+    ./link_sim.py --rate 50,100,500 --model iid:0.05 gilbert:0.02,0.3,0.8 \\
+        --drift-ppm 40,200 --runs 1000 --csv sweep.csv --json sweep.json
+
+Channel models:
+
+  iid:P              - Every packet is lost with probability P.
+  gilbert:PGB,PBG,PL - Two-state burst model; PGB and PBG are the per interval
+                       probabilities of going bad and recovering and PL is
+                       the loss probability while bad.
+  wifi:CH,PL         - Packets on the RF channels overlapping Wi-Fi channel CH
+                       (22 MHz wide) are lost with probability PL.
+
+With --probes DIR the first run of every configuration is also written as
+the rc_radio probes (src/rc_radio_probe.h) that each node would hit, one
+"time_us,probe,arg" CSV per node (DIR/<config>_tx.csv, _rx.csv and
+_relay.csv), which probe_timeline.py turns into a timeline:
+
+    ./link_sim.py --model gilbert:0.02,0.3,0.8 --probes probes
+    ./probe_timeline.py --format csv probes/0_tx.csv probes/0_rx.csv > t.json
+
+The nodes share the simulation's clock so their timelines line up. The ISRs
+only last as long as the model knows about (--isr-us after a packet).
+
+The runs are independent and spread over --jobs processes (Python threads
+wouldn't run in parallel), each seeded from --seed, the configuration and the
+run number so the results are reproducible.
+"""
+import argparse
+import collections
+import concurrent.futures
+import copy
+import csv
+import itertools
+import json
+import bisect
+import math
+import os
+import random
+import re
+import sys
+
+import probe_timeline
+
+
+SRC_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'src')
+
+# Not in the sources: nRF52 radio ramp up (fast ramp up is not used) and the
+# current of the radio at 1 Mbps with the DC/DC converter (TX at +4 dBm).
+RAMP_US = 140.0
+RX_MA = 5.4
+TX_MA = 7.5
+
+LATENCY_BIN_MS = 0.1
+
+
+def defines_load(*paths):
+    """Returns the integer #defines in the given files."""
+    defines = {}
+    for path in paths:
+        with open(path) as f:
+            for match in re.finditer(
+                    r'^#define\s+(\w+)\s+\(?\s*(\d+)UL\s*\)?', f.read(),
+                    re.MULTILINE):
+                defines[match.group(1)] = int(match.group(2))
+    return defines
+
+
+def channel_map_load(path):
+    with open(path) as f:
+        body = re.search(r'CHANNEL_MAP\[[^\]]*\]\[[^\]]*\]\s*=\s*\{(.*?)\};',
+                         f.read(), re.DOTALL).group(1)
+    return [[int(ch) for ch in row.split(',')]
+            for row in re.findall(r'\{([^}]*)\}', body)]
+
+
+class Probes(object):
+    """The probes that a node hits, with the probe's name and its argument
+    as src/rc_radio.c gives them. The callbacks' argument is the
+    rc_radio_event_t."""
+
+    def __init__(self, events):
+        self.events = events
+        self.records = []
+
+    def hit(self, time_us, probe, arg=0):
+        self.records.append((time_us, probe, arg))
+
+    def callback(self, time_us, event):
+        arg = self.events.index(event)
+        self.hit(time_us, 'CALLBACK_ENTER', arg)
+        self.hit(time_us, 'CALLBACK_EXIT', arg)
+
+    def write(self, path):
+        # The sort is stable so an ISR's probes stay in order.
+        with open(path, 'w', newline='') as f:
+            writer = csv.writer(f)
+            writer.writerow(('time_us', 'probe', 'arg'))
+            for time_us, probe, arg in sorted(self.records,
+                                              key=lambda record: record[0]):
+                writer.writerow(('%.3f' % time_us, probe, arg))
+
+
+class Timing(object):
+    """The constants from the sources plus the swept window parameters."""
+
+    def __init__(self, defines, channel_map, args):
+        self.bitrate = defines['BITRATE']
+        self.overhead_us = defines['OVERHEAD_US']
+        self.widening_us = defines['RX_WIDENING_US']
+        self.safety_us = defines['RX_SAFETY_US']
+        self.tolerance = defines['RC_RADIO_MISSED_PACKET_TOLERANCE']
+        self.channel_map = channel_map
+        self.isr_us = args.isr_us
+        self.switch_us = args.switch_us
+        self.relay_delay_us = defines['RELAY_TX_DELAY_US']
+        self.relay_slot_us = defines['RELAY_SLOT_US']
+        self.bind_channel = defines['BIND_CHANNEL']
+        bits = (defines['PREAMBLE_BITS'] + defines['PCF_BITS'] +
+                defines['CRC_BITS'] + (defines['ADDR_LEN'] * 8) +
+                (args.payload_bytes * 8))
+        self.pkt_len_us = math.ceil((bits * 1e6) / self.bitrate)
+
+
+class Channel(object):
+    """Decides which transmitter packets are lost. Packets are numbered by
+    their interval so every listener sees the same outcome."""
+
+    def __init__(self, model, rng):
+        name, _, params = model.partition(':')
+        self.name = name
+        self.params = [float(p) for p in params.split(',')] if params else []
+        self.rng = rng
+        self.bad = False
+        self.last_k = -1
+        self.outcomes = {}
+
+        if 'wifi' == name:
+            centre = 2412 + (5 * (int(self.params[0]) - 1)) - 2400
+            self.blocked = set(range(centre - 11, centre + 12))
+        elif name not in ('iid', 'gilbert'):
+            raise ValueError('unknown channel model: ' + model)
+
+    def lost(self, k, rf_channel):
+        if k in self.outcomes:
+            return self.outcomes[k]
+
+        if 'iid' == self.name:
+            lost = (self.rng.random() < self.params[0])
+        elif 'gilbert' == self.name:
+            p_gb, p_bg, p_loss = self.params
+            for _ in range(k - self.last_k):
+                if self.bad:
+                    self.bad = (self.rng.random() >= p_bg)
+                else:
+                    self.bad = (self.rng.random() < p_gb)
+            lost = (self.bad and (self.rng.random() < p_loss))
+        else:
+            lost = ((rf_channel in self.blocked) and
+                    (self.rng.random() < self.params[1]))
+
+        self.last_k = max(self.last_k, k)
+        self.outcomes[k] = lost
+        return lost
+
+
+class Transmitter(object):
+    """Sends packet k at first_us + k intervals (on its own clock) plus the
+    ramp up, on the k'th channel of its map."""
+
+    def __init__(self, timing, interval_us, ppm, first_us, map_index=0,
+                 keepalive=0, activity=1.0, rng=None):
+        self.timing = timing
+        self.period_us = interval_us / (1.0 + (ppm * 1e-6))
+        self.first_us = first_us
+        self.channels = timing.channel_map[map_index]
+        self.keepalive = keepalive
+        self.activity = activity
+        self.rng = rng
+        self.changes = []
+        self.sends = []
+        self.last_sent = 0
+
+    def _extend(self, k):
+        """Decides which intervals change the data and which are sent, like
+        m_tx_interval_idle: a change is sent at the next interval and the
+        countdown restarts at every packet."""
+        while len(self.changes) <= k:
+            i = len(self.changes)
+            changed = ((0 == self.keepalive) or (0 == i) or
+                       (self.rng.random() < self.activity))
+            sent = (changed or ((i - self.last_sent) >= self.keepalive))
+            if sent:
+                self.last_sent = i
+            self.changes.append(changed)
+            self.sends.append(sent)
+
+    def changed(self, k):
+        self._extend(k)
+        return self.changes[k]
+
+    def sent(self, k):
+        self._extend(k)
+        return self.sends[k]
+
+    def sent_count(self, n):
+        self._extend(n)
+        return sum(self.sends[:n])
+
+    def cc0(self, k):
+        return self.first_us + (k * self.period_us)
+
+    def packet(self, k):
+        start = self.cc0(k) + RAMP_US
+        return (start, start + self.timing.pkt_len_us,
+                self.channels[k % len(self.channels)])
+
+    def first_in(self, lo_us, hi_us):
+        """Returns (k, start, end, rf_channel) of the first packet that fits
+        in [lo_us, hi_us] or None."""
+        k = max(0, math.ceil((lo_us - RAMP_US - self.first_us) /
+                             self.period_us))
+        start, end, rf_channel = self.packet(k)
+        if (start >= lo_us) and (end <= hi_us) and self.sent(k):
+            return (k, start, end, rf_channel)
+        return None
+
+    def on_us(self):
+        return RAMP_US + self.timing.pkt_len_us
+
+    def probes_record(self, probes, n):
+        """The bind packet at 0 and the first n intervals: CC0 sends the
+        packet (or only hops when there is nothing to send) and the
+        TX_SUCCESS event hops."""
+        end_us = (RAMP_US + self.timing.pkt_len_us)
+        probes.hit(0.0, 'TIMER_ISR_ENTER')
+        probes.hit(0.0, 'TX_START', self.timing.bind_channel)
+        probes.hit(0.0, 'TIMER_ISR_EXIT')
+        probes.hit(end_us, 'ESB_ISR_ENTER')
+        probes.callback(end_us, 'BOUND')
+        probes.hit(end_us, 'ESB_ISR_EXIT')
+
+        for k in range(n):
+            cc0_us = self.cc0(k)
+            next_channel = self.channels[(k + 1) % len(self.channels)]
+            probes.hit(cc0_us, 'TIMER_ISR_ENTER')
+            if self.sent(k):
+                start, end, rf_channel = self.packet(k)
+                probes.hit(cc0_us, 'TX_START', rf_channel)
+                probes.hit(cc0_us, 'TIMER_ISR_EXIT')
+                probes.hit(end, 'ESB_ISR_ENTER')
+                probes.hit(end, 'HOP', next_channel)
+                probes.callback(end, 'DATA_SENT')
+                probes.hit(end, 'ESB_ISR_EXIT')
+            else:
+                probes.hit(cc0_us, 'HOP', next_channel)
+                probes.hit(cc0_us, 'TIMER_ISR_EXIT')
+
+
+class RelayTransmitter(object):
+    """The downstream side of a relay. Its slots follow the relay's timer, so
+    the packets follow the upstream transmitter's clock. The first packet
+    that the relay receives is forwarded as the bind packet. The channel hops
+    at every slot after that whether or not something is sent."""
+
+    def __init__(self, timing, map_index=1):
+        self.timing = timing
+        self.channels = timing.channel_map[map_index]
+        self.bound_us = None
+        self.slots = 0
+        self.starts = []
+        self.packets = []  # (slot, start, end, rf_channel)
+        self.forwarded = {}  # slot: (upstream k, relay delivery time)
+        self.probes = None
+
+    def slot(self, slot_us, received):
+        """Runs the slot that starts at slot_us after a relay window that
+        returned received."""
+        if self.bound_us is None:
+            if received is not None:
+                self.bound_us = (slot_us + self.timing.switch_us + RAMP_US +
+                                 self.timing.pkt_len_us + self.timing.isr_us)
+            return
+
+        if received is not None:
+            start = (slot_us + self.timing.switch_us + RAMP_US)
+            if self.probes:
+                self.probes.hit(start - RAMP_US, 'TX_START',
+                                self.channels[self.slots % len(self.channels)])
+            self.starts.append(start)
+            self.packets.append((self.slots, start,
+                                 start + self.timing.pkt_len_us,
+                                 self.channels[self.slots %
+                                               len(self.channels)]))
+            self.forwarded[self.slots] = received
+        self.slots += 1
+
+    def changed(self, k):
+        return True
+
+    def first_in(self, lo_us, hi_us):
+        i = bisect.bisect_left(self.starts, lo_us)
+        if (i < len(self.packets)) and (self.packets[i][2] <= hi_us):
+            return self.packets[i]
+        return None
+
+    def on_us(self):
+        return (len(self.packets) + 1) * (RAMP_US + self.timing.pkt_len_us)
+
+
+class Receiver(object):
+    """The receiver's timer handling from rc_radio.c. The timer is cleared
+    when a packet is delivered (in software, after the interrupt latency) or
+    by the CC1 short when the window closes empty."""
+
+    def __init__(self, timing, interval_us, ppm, bound_us, map_index=0,
+                 keepalive=0, probes=None):
+        self.timing = timing
+        self.scale = 1.0 / (1.0 + (ppm * 1e-6))
+        self.cc0 = (interval_us - timing.overhead_us - timing.pkt_len_us -
+                    timing.widening_us)
+        self.cc1 = (interval_us + timing.safety_us)
+        self.clear_us = bound_us
+        self.channels = timing.channel_map[map_index]
+        self.channel_index = 0
+        self.missed = 0
+        self.bound = True
+        self.on_us = 0.0
+        self.keepalive = keepalive
+        self.probes = probes
+
+        if probes:
+            probes.hit(bound_us - timing.isr_us, 'ESB_ISR_ENTER')
+            probes.callback(bound_us, 'BOUND')
+            probes.hit(bound_us, 'ESB_ISR_EXIT')
+
+    def window(self):
+        return (self.clear_us + (self.cc0 * self.scale),
+                self.clear_us + (self.cc1 * self.scale))
+
+    def step(self, tx, channel):
+        """Runs one window. Returns (k, delivery time) or None."""
+        open_us, close_us = self.window()
+        rf_channel = self.channels[self.channel_index]
+        self.channel_index = ((self.channel_index + 1) % len(self.channels))
+
+        next_channel = self.channels[self.channel_index]
+        probes = self.probes
+
+        if probes:
+            probes.hit(open_us, 'TIMER_ISR_ENTER')
+            probes.hit(open_us, 'RX_WINDOW_OPEN')
+            probes.hit(open_us, 'TIMER_ISR_EXIT')
+
+        packet = tx.first_in(open_us + RAMP_US, close_us)
+        if ((packet is not None) and (rf_channel == packet[3]) and
+                (not channel.lost(packet[0], rf_channel))):
+            k, _, end, _ = packet
+            self.on_us += (end - open_us)
+            self.clear_us = (end + self.timing.isr_us)
+            if self.missed:
+                self.cc0 += self.timing.safety_us
+                self.cc1 += self.timing.safety_us
+                self.missed = 0
+            if probes:
+                probes.hit(end, 'ESB_ISR_ENTER')
+                probes.hit(self.clear_us, 'RX_WINDOW_CLOSE', 1)
+                probes.hit(self.clear_us, 'HOP', next_channel)
+                probes.callback(self.clear_us, 'DATA_RECEIVED')
+                probes.hit(self.clear_us, 'ESB_ISR_EXIT')
+            return (k, self.clear_us)
+
+        self.on_us += (close_us - open_us)
+        self.clear_us = close_us
+        self.missed += 1
+        if 1 == self.missed:
+            self.cc0 -= self.timing.safety_us
+            self.cc1 -= self.timing.safety_us
+        if self.timing.tolerance <= self.missed:
+            self.bound = False
+        if probes:
+            probes.hit(close_us, 'TIMER_ISR_ENTER')
+            probes.hit(close_us, 'RX_WINDOW_CLOSE', 0)
+            if not self.bound:
+                probes.callback(close_us, 'PACKET_DROPPED')
+                probes.callback(close_us, 'BINDING')
+            else:
+                probes.hit(close_us, 'HOP', next_channel)
+                if ((0 == self.keepalive) or
+                        (0 == (self.missed % self.keepalive))):
+                    probes.callback(close_us, 'PACKET_DROPPED')
+            probes.hit(close_us, 'TIMER_ISR_EXIT')
+        return None
+
+
+class Stats(object):
+    """Per run results. Runs are merged by adding them up."""
+
+    FIELDS = ('runs', 'sent', 'received', 'links_lost', 'lost_at_s',
+              'rx_on_us', 'tx_on_us', 'relay_on_ma_us', 'duration_us')
+
+    def __init__(self):
+        for field in self.FIELDS:
+            setattr(self, field, 0)
+        self.loss = []
+        self.gaps = collections.Counter()
+        self.latency = collections.Counter()
+        self.added_latency = collections.Counter()
+        self.slot_margin_us = None
+
+    def add(self, other):
+        for field in self.FIELDS:
+            setattr(self, field, getattr(self, field) + getattr(other, field))
+        self.loss.extend(other.loss)
+        self.gaps.update(other.gaps)
+        self.latency.update(other.latency)
+        self.added_latency.update(other.added_latency)
+        if other.slot_margin_us is not None:
+            self.slot_margin_us = min(other.slot_margin_us,
+                                      self.slot_margin_us
+                                      if self.slot_margin_us is not None
+                                      else other.slot_margin_us)
+
+    def latency_record(self, rng, tx, first_k, k, delivered_us):
+        """The application samples its data at a random time in each interval
+        and it's carried by that interval's packet (or by a later one). With
+        a keepalive only the samples that changed the data count."""
+        for i in range(first_k, k + 1):
+            if not tx.changed(i):
+                continue
+            sample_us = tx.cc0(i) - (rng.random() * tx.period_us)
+            self.latency[int((delivered_us - sample_us) /
+                             (LATENCY_BIN_MS * 1000))] += 1
+
+
+def config_timing(timing, config):
+    timing = copy.copy(timing)
+    timing.widening_us = config['widening_us']
+    timing.safety_us = config['safety_us']
+    timing.tolerance = config['tolerance']
+    return timing
+
+
+def link_run(timing, config, seed, probes=None):
+    """probes, if given, is a dict of Probes for 'tx' and 'rx'."""
+    rng = random.Random(seed)
+    interval_us = (1e6 / config['rate_hz'])
+    duration_us = (config['duration_s'] * 1e6)
+    drift = config['drift_ppm']
+    timing = config_timing(timing, config)
+
+    # The receiver's timer starts when it gets the bind packet. The
+    # transmitter's first data packet is one interval after the bind packet.
+    bind_us = (RAMP_US + timing.pkt_len_us)
+    tx = Transmitter(timing, interval_us, rng.uniform(-drift, drift),
+                     interval_us, keepalive=config['keepalive'],
+                     activity=config['activity'],
+                     rng=random.Random(seed + '-tx'))
+    rx = Receiver(timing, interval_us, rng.uniform(-drift, drift),
+                  bind_us + timing.isr_us, keepalive=config['keepalive'],
+                  probes=(probes or {}).get('rx'))
+    channel = Channel(config['model'], rng)
+
+    stats = Stats()
+    stats.runs = 1
+    stats.duration_us = duration_us
+    next_k = 0
+    gap = 0
+
+    while rx.bound and (rx.window()[1] < duration_us):
+        result = rx.step(tx, channel)
+        gap += 1
+        if result is not None:
+            k, delivered_us = result
+            stats.received += 1
+            stats.gaps[gap] += 1
+            stats.latency_record(rng, tx, next_k, k, delivered_us)
+            next_k = (k + 1)
+            gap = 0
+
+    if not rx.bound:
+        stats.links_lost = 1
+        stats.lost_at_s = (rx.clear_us / 1e6)
+
+    stats.sent = tx.sent_count(int(duration_us / tx.period_us))
+    if probes:
+        tx.probes_record(probes['tx'], int(duration_us / tx.period_us))
+    stats.rx_on_us = rx.on_us
+    stats.tx_on_us = (stats.sent * tx.on_us())
+    stats.loss = [1.0 - (stats.received / stats.sent)]
+    return stats
+
+
+def relay_run(timing, config, seed, probes=None):
+    """Transmitter -> relay -> receiver. The relay's windows are run first
+    since the downstream packets only depend on them. probes, if given, is a
+    dict of Probes for 'tx', 'relay' and 'rx'."""
+    rng = random.Random(seed)
+    interval_us = (1e6 / config['rate_hz'])
+    duration_us = (config['duration_s'] * 1e6)
+    drift = config['drift_ppm']
+    timing = config_timing(timing, config)
+
+    bind_us = (RAMP_US + timing.pkt_len_us)
+    tx = Transmitter(timing, interval_us, rng.uniform(-drift, drift),
+                     interval_us, keepalive=config['keepalive'],
+                     activity=config['activity'],
+                     rng=random.Random(seed + '-tx'))
+    relay = Receiver(timing, interval_us, rng.uniform(-drift, drift),
+                     bind_us + timing.isr_us, keepalive=config['keepalive'],
+                     probes=(probes or {}).get('relay'))
+    relay_tx = RelayTransmitter(timing)
+    relay_tx.probes = (probes or {}).get('relay')
+    upstream = Channel(config['model'], rng)
+    downstream = Channel(config['model'], rng)
+
+    stats = Stats()
+    stats.runs = 1
+    stats.duration_us = duration_us
+
+    while relay.bound and (relay.window()[1] < duration_us):
+        result = relay.step(tx, upstream)
+
+        # The slot moves back with the window after a miss.
+        slot_us = relay.clear_us + ((timing.relay_delay_us -
+                                     (timing.safety_us if relay.missed
+                                      else 0)) * relay.scale)
+        relay_tx.slot(slot_us, result)
+
+        margin = (relay.window()[0] - slot_us -
+                  (timing.relay_slot_us * relay.scale))
+        if (stats.slot_margin_us is None) or (margin < stats.slot_margin_us):
+            stats.slot_margin_us = margin
+
+    lost_at_us = (None if relay.bound else relay.clear_us)
+
+    if relay_tx.bound_us is not None:
+        rx = Receiver(timing, interval_us, rng.uniform(-drift, drift),
+                      relay_tx.bound_us, map_index=1,
+                      probes=(probes or {}).get('rx'))
+        next_k = 0
+        gap = 0
+
+        while rx.bound and (rx.window()[1] < duration_us):
+            result = rx.step(relay_tx, downstream)
+            gap += 1
+            if result is not None:
+                slot, delivered_us = result
+                k, relayed_us = relay_tx.forwarded[slot]
+                stats.received += 1
+                stats.gaps[gap] += 1
+                stats.latency_record(rng, tx, next_k, k, delivered_us)
+                stats.added_latency[int((delivered_us - relayed_us) /
+                                        (LATENCY_BIN_MS * 1000))] += 1
+                next_k = (k + 1)
+                gap = 0
+
+        if not rx.bound:
+            lost_at_us = min(rx.clear_us, lost_at_us or rx.clear_us)
+        stats.rx_on_us = rx.on_us
+
+    if lost_at_us is not None:
+        stats.links_lost = 1
+        stats.lost_at_s = (lost_at_us / 1e6)
+
+    stats.sent = tx.sent_count(int(duration_us / tx.period_us))
+    if probes:
+        tx.probes_record(probes['tx'], int(duration_us / tx.period_us))
+    stats.tx_on_us = (stats.sent * tx.on_us())
+    stats.relay_on_ma_us = ((RX_MA * relay.on_us) +
+                            (TX_MA * relay_tx.on_us()))
+    stats.loss = [1.0 - (stats.received / stats.sent)]
+    return stats
+
+
+def percentile(counter, fraction):
+    total = sum(counter.values())
+    seen = 0
+    for key in sorted(counter):
+        seen += counter[key]
+        if seen >= (fraction * total):
+            return key
+    return 0
+
+
+def summary(config, stats):
+    loss = sorted(stats.loss)
+    row = dict(config)
+    row.update({
+        'runs': stats.runs,
+        'loss_mean': (sum(loss) / len(loss)),
+        'loss_p95': loss[min(len(loss) - 1, int(0.95 * len(loss)))],
+        'link_lost_frac': (stats.links_lost / stats.runs),
+        'lost_after_s_mean': ((stats.lost_at_s / stats.links_lost)
+                              if stats.links_lost else ''),
+        'latency_p50_ms': (percentile(stats.latency, 0.5) * LATENCY_BIN_MS),
+        'latency_p99_ms': (percentile(stats.latency, 0.99) * LATENCY_BIN_MS),
+        'latency_max_ms': (max(stats.latency or [0]) * LATENCY_BIN_MS),
+        'max_gap_intervals': max(stats.gaps or [0]),
+        'rx_radio_ma': (RX_MA * stats.rx_on_us / stats.duration_us),
+        'tx_radio_ma': (TX_MA * stats.tx_on_us / stats.duration_us),
+    })
+    if config.get('relay'):
+        row.update({
+            'relay_added_p50_ms': (percentile(stats.added_latency, 0.5) *
+                                   LATENCY_BIN_MS),
+            'relay_added_max_ms': (max(stats.added_latency or [0]) *
+                                   LATENCY_BIN_MS),
+            'relay_slot_margin_min_us': stats.slot_margin_us,
+            'relay_radio_ma': (stats.relay_on_ma_us / stats.duration_us),
+        })
+    return row
+
+
+def run_batch(timing, batch):
+    """Runs a list of (config index, config, seed) in a worker process and
+    returns the merged Stats per config index."""
+    merged = {}
+    for index, config, seed in batch:
+        run = (relay_run if config.get('relay') else link_run)
+        merged.setdefault(index, Stats()).add(run(timing, config, seed))
+    return merged
+
+
+def ints(text):
+    return [int(value) for value in text.split(',')]
+
+
+def floats(text):
+    return [float(value) for value in text.split(',')]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('--rate', type=ints, default=[100],
+                        help='transmit rates in Hz (default: 100)')
+    parser.add_argument('--tolerance', type=ints,
+                        help='missed packet tolerances (default: from '
+                             'rc_radio.h)')
+    parser.add_argument('--widening-us', type=ints,
+                        help='RX_WIDENING_US values (default: from rc_radio.c)')
+    parser.add_argument('--safety-us', type=ints,
+                        help='RX_SAFETY_US values (default: from rc_radio.c)')
+    parser.add_argument('--drift-ppm', type=ints, default=[40],
+                        help='crystal tolerances (default: 40)')
+    parser.add_argument('--model', nargs='+', default=['iid:0.01'],
+                        help='channel models (default: iid:0.01)')
+    parser.add_argument('--keepalive', type=ints, default=[0],
+                        help='RC_RADIO_KEEPALIVE_INTERVAL values, 0 for a '
+                             'fixed rate (default: 0)')
+    parser.add_argument('--activity', type=floats, default=[0.1],
+                        help='probability that the data changes in an '
+                             'interval when a keepalive is used '
+                             '(default: 0.1)')
+    parser.add_argument('--payload-bytes', type=int, default=5,
+                        help='sizeof(rc_radio_data_t) (default: 5)')
+    parser.add_argument('--isr-us', type=float, default=20.0,
+                        help='time from the end of a packet to the timer '
+                             'being cleared (default: 20)')
+    parser.add_argument('--relay', action='store_true',
+                        help='put a relay between the transmitter and the '
+                             'receiver')
+    parser.add_argument('--switch-us', type=float, default=50.0,
+                        help='time for the relay to re-initialize nrf_esb '
+                             'before it sends (default: 50)')
+    parser.add_argument('--duration', type=float, default=10.0,
+                        help='seconds per run (default: 10)')
+    parser.add_argument('--runs', type=int, default=100,
+                        help='runs per configuration (default: 100)')
+    parser.add_argument('--seed', type=int, default=1)
+    parser.add_argument('--jobs', type=int, default=os.cpu_count(),
+                        help='worker processes (default: all cores)')
+    parser.add_argument('--csv', help='write the summary as CSV (default: '
+                                      'stdout)')
+    parser.add_argument('--json', help='write the summary and histograms as '
+                                       'JSON')
+    parser.add_argument('--probes', metavar='DIR',
+                        help='write the probes of the first run of each '
+                             'configuration for probe_timeline.py')
+    args = parser.parse_args()
+
+    defines = defines_load(os.path.join(SRC_DIR, 'rc_radio.c'),
+                           os.path.join(SRC_DIR, 'rc_radio.h'))
+    timing = Timing(defines, channel_map_load(os.path.join(SRC_DIR,
+                                                           'rc_radio.c')),
+                    args)
+
+    configs = [dict(zip(('rate_hz', 'tolerance', 'widening_us', 'safety_us',
+                         'drift_ppm', 'model', 'keepalive', 'activity'),
+                        values),
+                    duration_s=args.duration)
+               for values in itertools.product(
+                   args.rate,
+                   args.tolerance or [timing.tolerance],
+                   args.widening_us or [timing.widening_us],
+                   args.safety_us or [timing.safety_us],
+                   args.drift_ppm,
+                   args.model,
+                   args.keepalive,
+                   args.activity)]
+
+    for config in configs:
+        Channel(config['model'], None)  # Fail early on a bad model
+        if args.relay:
+            config['relay'] = True
+
+    tasks = [(index, config, '%d-%d-%d' % (args.seed, index, run))
+             for index, config in enumerate(configs)
+             for run in range(args.runs)]
+
+    # A few batches per worker keeps them busy without much pickling.
+    batch_len = max(1, len(tasks) // (args.jobs * 8))
+    batches = [tasks[i:i + batch_len] for i in range(0, len(tasks), batch_len)]
+    results = [Stats() for _ in configs]
+
+    with concurrent.futures.ProcessPoolExecutor(args.jobs) as pool:
+        for merged in pool.map(run_batch, itertools.repeat(timing), batches):
+            for index, stats in merged.items():
+                results[index].add(stats)
+
+    rows = [summary(config, stats) for config, stats in zip(configs, results)]
+
+    if args.probes:
+        # The first run is repeated with the same seed to record its probes.
+        os.makedirs(args.probes, exist_ok=True)
+        events = probe_timeline.enum_load(os.path.join(SRC_DIR, 'rc_radio.h'),
+                                          'rc_radio_event_t',
+                                          'RC_RADIO_EVENT_')
+        for index, config in enumerate(configs):
+            nodes = (('tx', 'relay', 'rx') if args.relay else ('tx', 'rx'))
+            probes = {node: Probes(events) for node in nodes}
+            run = (relay_run if args.relay else link_run)
+            run(timing, config, '%d-%d-%d' % (args.seed, index, 0), probes)
+            for node, node_probes in probes.items():
+                node_probes.write(os.path.join(args.probes,
+                                               '%d_%s.csv' % (index, node)))
+
+    output = open(args.csv, 'w', newline='') if args.csv else sys.stdout
+    writer = csv.DictWriter(output, fieldnames=list(rows[0].keys()))
+    writer.writeheader()
+    for row in rows:
+        writer.writerow({key: (('%.6g' % value) if isinstance(value, float)
+                               else value) for key, value in row.items()})
+
+    if args.json:
+        for row, stats in zip(rows, results):
+            row['gap_histogram'] = {str(gap): count for gap, count
+                                    in sorted(stats.gaps.items())}
+            row['latency_histogram_ms'] = {
+                ('%.1f' % (key * LATENCY_BIN_MS)): count
+                for key, count in sorted(stats.latency.items())}
+            if args.relay:
+                row['relay_added_histogram_ms'] = {
+                    ('%.1f' % (key * LATENCY_BIN_MS)): count
+                    for key, count in sorted(stats.added_latency.items())}
+        with open(args.json, 'w') as f:
+            json.dump({'timing': {'pkt_len_us': timing.pkt_len_us,
+                                  'overhead_us': timing.overhead_us,
+                                  'ramp_us': RAMP_US,
+                                  'isr_us': timing.isr_us,
+                                  'switch_us': timing.switch_us,
+                                  'relay_delay_us': timing.relay_delay_us,
+                                  'relay_slot_us': timing.relay_slot_us},
+                       'configs': rows}, f, indent=1)
+            f.write('\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+"""
+Converts rc_radio probe records (see src/rc_radio_probe.h) into a Chrome
+trace JSON file that can be opened with ui.perfetto.dev or chrome://tracing.
+
+Three input formats are supported:
+
+  dwt   - A dump of rc_radio_probe_log (RC_RADIO_PROBE_DWT), e.g. from gdb:
+              dump binary value probe.bin rc_radio_probe_log
+  trace - A binary trace captured from RTT (RC_RADIO_PROBE_TRACE). Only the
+          RADIO_PROBE events are used.
+  csv   - Lines of "time_us,probe,arg" (e.g. recorded by a host harness
+          through rc_radio_probe_hook). The probe can be a name or a number.
+
+Each input becomes a process in the timeline with tracks for the ISRs, the
+application callbacks, the transmissions and the RX windows, and a counter
+for the RF channel. Several inputs (e.g. a transmitter and a receiver) can
+be given at once; their clocks are not aligned.
+
+    ./probe_timeline.py --format dwt --cpu-hz 64e6 rx_probe.bin > rx.json
+"""
+import argparse
+import csv
+import json
+import os
+import re
+import struct
+import sys
+
+import trace_decode
+
+
+SRC_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'src')
+
+DWT_INDEX = struct.Struct('<I')
+DWT_RECORD = struct.Struct('<IHH')
+
+TRACKS = {
+    'timer_isr': (1, 'Timer ISR'),
+    'esb_isr':   (2, 'nrf_esb ISR'),
+    'callback':  (3, 'Callbacks'),
+    'tx':        (4, 'TX'),
+    'rx':        (5, 'RX window'),
+}
+
+
+def enum_load(path, typedef, prefix):
+    """Returns the names of the enum's values in order without the prefix."""
+    with open(path) as f:
+        text = f.read()
+
+    body = re.search(r'typedef enum\s*\{([^}]*)\}\s*' + typedef + r'\s*;',
+                     text).group(1)
+
+    return [name[len(prefix):] for name in
+            re.findall(r'^\s*(' + prefix + r'\w+)', body, re.MULTILINE)]
+
+
+def dwt_read(f, cpu_hz):
+    data = f.read()
+    (index,) = DWT_INDEX.unpack_from(data, 0)
+    count = (len(data) - DWT_INDEX.size) // DWT_RECORD.size
+
+    first = max(0, index - count)
+    last = None
+    cycles = 0
+    records = []
+
+    # A probe that preempted another one can be logged before it, so the
+    # difference is signed and the records are sorted afterwards.
+    for i in range(first, index):
+        raw, probe, arg = DWT_RECORD.unpack_from(
+            data, DWT_INDEX.size + ((i % count) * DWT_RECORD.size))
+        if last is not None:
+            delta = ((raw - last) & 0xFFFFFFFF)
+            if delta & 0x80000000:
+                delta -= 0x100000000
+            cycles += delta
+        last = raw
+        records.append((cycles * 1e6 / cpu_hz, probe, arg))
+
+    records.sort(key=lambda record: record[0])
+    return records
+
+
+def trace_read(f, args):
+    events = trace_decode.events_load(args.events)
+    for seconds, name, named_args in trace_decode.records_read(
+            f, events, args.tick_hz, args.tick_bits):
+        if 'RADIO_PROBE' == name:
+            yield (seconds * 1e6, named_args[0][1], named_args[1][1])
+
+
+def csv_read(f, probes):
+    for row in csv.reader(f):
+        if not row or row[0].startswith('#'):
+            continue
+        try:
+            time_us = float(row[0])
+        except ValueError:
+            continue  # Header
+        probe = row[1].strip()
+        if probe.isdigit():
+            probe = int(probe)
+        else:
+            probe = probes.index(probe.replace('RC_RADIO_PROBE_', ''))
+        yield (time_us, probe, int(row[2]))
+
+
+def timeline_build(records, pid, label, probes, events):
+    out = [{'ph': 'M', 'pid': pid, 'name': 'process_name',
+            'args': {'name': label}}]
+    for tid, name in TRACKS.values():
+        out.append({'ph': 'M', 'pid': pid, 'tid': tid, 'name': 'thread_name',
+                    'args': {'name': name}})
+
+    rx_open = None
+
+    for time_us, probe, arg in records:
+        name = probes[probe] if probe < len(probes) else 'PROBE_%d' % probe
+
+        def slice_event(track, phase, slice_name, slice_args=None):
+            event = {'ph': phase, 'pid': pid, 'tid': TRACKS[track][0],
+                     'ts': time_us, 'name': slice_name}
+            if slice_args:
+                event['args'] = slice_args
+            out.append(event)
+
+        if name in ('TIMER_ISR_ENTER', 'TIMER_ISR_EXIT'):
+            slice_event('timer_isr', 'B' if name.endswith('ENTER') else 'E',
+                        'm_timer_handler')
+        elif name in ('ESB_ISR_ENTER', 'ESB_ISR_EXIT'):
+            slice_event('esb_isr', 'B' if name.endswith('ENTER') else 'E',
+                        'm_nrf_esb_event_handler')
+        elif name in ('CALLBACK_ENTER', 'CALLBACK_EXIT'):
+            event = events[arg] if arg < len(events) else str(arg)
+            slice_event('callback', 'B' if name.endswith('ENTER') else 'E',
+                        event)
+        elif 'TX_START' == name:
+            out.append({'ph': 'i', 's': 't', 'pid': pid,
+                        'tid': TRACKS['tx'][0], 'ts': time_us,
+                        'name': 'TX', 'args': {'channel': arg}})
+        elif 'RX_WINDOW_OPEN' == name:
+            rx_open = time_us
+        elif 'RX_WINDOW_CLOSE' == name:
+            if rx_open is not None:
+                out.append({'ph': 'X', 'pid': pid, 'tid': TRACKS['rx'][0],
+                            'ts': rx_open, 'dur': (time_us - rx_open),
+                            'name': 'RX' if arg else 'RX (missed)',
+                            'args': {'received': arg}})
+            rx_open = None
+        elif 'HOP' == name:
+            out.append({'ph': 'C', 'pid': pid, 'ts': time_us,
+                        'name': 'RF channel', 'args': {'channel': arg}})
+
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('inputs', nargs='+', help='probe records')
+    parser.add_argument('--format', choices=('dwt', 'trace', 'csv'),
+                        default='dwt')
+    parser.add_argument('--cpu-hz', type=float, default=64e6,
+                        help='DWT cycle counter frequency (default: 64e6)')
+    parser.add_argument('--events', default=trace_decode.DEFAULT_EVENTS,
+                        help='path to trace_events.h')
+    parser.add_argument('--tick-hz', type=float, default=32768.0,
+                        help='app_timer frequency (default: %(default)s)')
+    parser.add_argument('--tick-bits', type=int, default=24,
+                        help='width of the RTC counter (default: %(default)s)')
+    parser.add_argument('-o', '--output', help='defaults to stdout')
+    args = parser.parse_args()
+
+    probes = enum_load(os.path.join(SRC_DIR, 'rc_radio_probe.h'),
+                       'rc_radio_probe_t', 'RC_RADIO_PROBE_')
+    events = enum_load(os.path.join(SRC_DIR, 'rc_radio.h'),
+                       'rc_radio_event_t', 'RC_RADIO_EVENT_')
+
+    trace_events = []
+    for pid, path in enumerate(args.inputs, 1):
+        if 'csv' == args.format:
+            with open(path, newline='') as f:
+                records = list(csv_read(f, probes))
+        else:
+            with open(path, 'rb') as f:
+                if 'dwt' == args.format:
+                    records = list(dwt_read(f, args.cpu_hz))
+                else:
+                    records = list(trace_read(f, args))
+
+        trace_events.extend(timeline_build(records, pid,
+                                           os.path.basename(path),
+                                           probes, events))
+
+    output = open(args.output, 'w') if args.output else sys.stdout
+    json.dump({'traceEvents': trace_events, 'displayTimeUnit': 'ns'}, output)
+    output.write('\n')
+
+
+if __name__ == '__main__':
+    main()
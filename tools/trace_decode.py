@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""
+Decodes the binary records written by src/examples/common/trace.c into text
+or CSV.
+
+The records are read from RTT up buffer 1, e.g.:
+
+    JLinkRTTLogger -Device NRF52832_XXAA -If SWD -Speed 4000 \
+        -RTTChannel 1 trace.bin
+    ./trace_decode.py trace.bin
+
+The event names and argument names are read from trace_events.h so the
+decoder doesn't need to be updated when events are added.
+"""
+import argparse
+import csv
+import os
+import re
+import struct
+import sys
+
+
+RECORD = struct.Struct('<IH5h')
+ARG_COUNT = 5
+
+DEFAULT_EVENTS = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                              '..', 'src', 'examples', 'common',
+                              'trace_events.h')
+
+EVENT_DEF = re.compile(r'^\s*TRACE_EVENT_DEF\(\s*(\w+)\s*,\s*"([^"]*)"\s*\)')
+
+
+def events_load(path):
+    events = []
+    with open(path) as f:
+        for line in f:
+            match = EVENT_DEF.match(line)
+            if match:
+                events.append((match.group(1), match.group(2).split()))
+    return events
+
+
+def records_read(f, events, tick_hz, tick_bits):
+    """Yields (seconds, name, [(arg_name, value)]) with the timestamps
+    unwrapped into a monotonic time since the first record."""
+    mask = (1 << tick_bits) - 1
+    last = None
+    ticks = 0
+
+    while True:
+        data = f.read(RECORD.size)
+        if len(data) < RECORD.size:
+            return
+
+        timestamp, event_id, *args = RECORD.unpack(data)
+
+        if last is not None:
+            delta = ((timestamp - last) & mask)
+            if delta > (mask >> 1):
+                # Records from different interrupts can be slightly out of
+                # order.
+                delta -= (mask + 1)
+            ticks += delta
+        last = timestamp
+
+        if event_id < len(events):
+            name, arg_names = events[event_id]
+        else:
+            name, arg_names = ('UNKNOWN_%d' % event_id,
+                               ['arg%d' % i for i in range(ARG_COUNT)])
+
+        yield (ticks / tick_hz, name, list(zip(arg_names, args)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('input', help='binary trace captured from RTT')
+    parser.add_argument('--events', default=DEFAULT_EVENTS,
+                        help='path to trace_events.h')
+    parser.add_argument('--csv', action='store_true',
+                        help='write CSV instead of text')
+    parser.add_argument('--tick-hz', type=float, default=32768.0,
+                        help='app_timer frequency (default: %(default)s)')
+    parser.add_argument('--tick-bits', type=int, default=24,
+                        help='width of the RTC counter (default: %(default)s)')
+    args = parser.parse_args()
+
+    events = events_load(args.events)
+
+    with open(args.input, 'rb') as f:
+        records = records_read(f, events, args.tick_hz, args.tick_bits)
+
+        if args.csv:
+            writer = csv.writer(sys.stdout)
+            writer.writerow(['time_s', 'event'] +
+                            ['arg%d' % i for i in range(ARG_COUNT)])
+            for seconds, name, named_args in records:
+                writer.writerow(['%.6f' % seconds, name] +
+                                [value for _, value in named_args])
+        else:
+            for seconds, name, named_args in records:
+                print('%12.6f  %-18s %s' %
+                      (seconds, name,
+                       ' '.join('%s=%d' % arg for arg in named_args)))
+
+
+if __name__ == '__main__':
+    main()